@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// Layout of a schema archive, what `schema_dump_all <archive dir> -archive=<build>` writes to.
+//
+//     <archive dir>/objects/<2 hex>/<14 hex>   one `"Name": { ... },` definition, named by the fnv64 of its text
+//     <archive dir>/builds/<build>.manifest    the object of every type of a build, per scope and in dump order
+//     <archive dir>/builds.json                the builds in the order they were archived
+//
+// A definition that doesn't change between builds is stored once, so archiving a build only writes the
+// objects of the types that changed. Putting the objects of a manifest back together gives the exact
+// <scope>.json that a plain dump of that build would have written.
+//
+// A manifest is a header_t, header_t::scope_count scope_t, header_t::entry_count entry_t and the
+// null terminated scope names. Every scope owns enum_count enum entries followed by class_count class
+// entries starting at first_entry.
+namespace archive {
+    constexpr std::uint32_t kMagic = 0x4D413253; // 'S2AM'
+    constexpr std::uint32_t kVersion = 1;
+
+#pragma pack(push, 1)
+    struct header_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t scope_count;
+        std::uint32_t entry_count;
+        std::uint32_t strings_size;
+        std::uint32_t reserved;
+    };
+
+    struct scope_t {
+        std::uint32_t name; // offset in the strings
+        std::uint32_t first_entry;
+        std::uint32_t enum_count;
+        std::uint32_t class_count;
+    };
+
+    struct entry_t {
+        std::uint64_t name_hash; // fnv64 of the type name
+        std::uint64_t object; // fnv64 of the definition, names the file under objects/
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(header_t) == 24);
+    static_assert(sizeof(scope_t) == 16);
+    static_assert(sizeof(entry_t) == 16);
+
+    // @note: read only view over a manifest mapped or loaded by the caller
+    //
+    struct view_t {
+        view_t(const void* data, const std::size_t size): _data(static_cast<const std::uint8_t*>(data)), _size(size) { }
+
+        [[nodiscard]] bool valid() const {
+            if (_size < sizeof(header_t) || header().magic != kMagic || header().version != kVersion)
+                return false;
+
+            const auto tables_size = sizeof(header_t) + std::uint64_t{header().scope_count} * sizeof(scope_t) +
+                                     std::uint64_t{header().entry_count} * sizeof(entry_t);
+            if (_size < tables_size + header().strings_size)
+                return false;
+
+            for (std::uint32_t i = 0; i < header().scope_count; ++i) {
+                const auto& scope = scopes()[i];
+                if (std::uint64_t{scope.first_entry} + scope.enum_count + scope.class_count > header().entry_count || scope.name >= header().strings_size)
+                    return false;
+            }
+
+            return header().strings_size != 0 && strings()[header().strings_size - 1] == '\0';
+        }
+
+        [[nodiscard]] const header_t& header() const {
+            return *reinterpret_cast<const header_t*>(_data);
+        }
+
+        [[nodiscard]] const scope_t* scopes() const {
+            return reinterpret_cast<const scope_t*>(_data + sizeof(header_t));
+        }
+
+        [[nodiscard]] const entry_t* entries() const {
+            return reinterpret_cast<const entry_t*>(scopes() + header().scope_count);
+        }
+
+        [[nodiscard]] std::string_view scope_name(const scope_t& scope) const {
+            return strings() + scope.name;
+        }
+
+        // @note: nullptr if the scope has no such enum/class
+        //
+        [[nodiscard]] const entry_t* find(const scope_t& scope, const std::uint64_t name_hash, const bool is_class) const {
+            const auto begin = entries() + scope.first_entry + (is_class ? scope.enum_count : 0);
+            const auto end = begin + (is_class ? scope.class_count : scope.enum_count);
+            for (auto it = begin; it != end; ++it) {
+                if (it->name_hash == name_hash)
+                    return it;
+            }
+
+            return nullptr;
+        }
+    private:
+        [[nodiscard]] const char* strings() const {
+            return reinterpret_cast<const char*>(entries() + header().entry_count);
+        }
+
+        const std::uint8_t* _data;
+        std::size_t _size;
+    };
+} // namespace archive
@@ -0,0 +1,316 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "sdk/archive.h"
+#include "sdk/scope_json.h"
+#include "tools/binary_writer.h"
+#include "tools/dump_reader.h"
+#include "tools/fnv.h"
+#include "tools/parallel.h"
+
+// Writing and reading a schema archive, see sdk/archive.h for the layout and -archive for what it's for.
+//
+// Archiving only needs the rendered fragments of a build, so this runs the same outside of the game, on stand-in
+// fragments. Paths go through std::filesystem, an archive written on one system can be read on another.
+namespace sdk {
+    struct archive_stats_t {
+        std::size_t m_types = 0;
+        std::size_t m_new_objects = 0; // definitions that weren't in the archive yet
+        std::size_t m_bytes_written = 0;
+    };
+
+    enum class archive_change_kind_t : std::uint8_t {
+        kAdded = 0,
+        kChanged,
+        kRemoved,
+    };
+
+    // @note: a build in which a type of a scope differs from the build archived before it
+    //
+    struct archive_change_t {
+        std::string m_build = "";
+        std::string m_scope = "";
+        bool m_is_class = false;
+        archive_change_kind_t m_kind = archive_change_kind_t::kAdded;
+        std::uint64_t m_object = 0; // for kRemoved, the last object the type had
+    };
+
+    namespace detail {
+        // @note: build names end up in file names
+        //
+        inline void ValidateBuildName(const std::string& build) {
+            const auto is_valid = [](const char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '-' || c == '_'; };
+            if (build.empty() || build.front() == '.' || !std::all_of(build.begin(), build.end(), is_valid))
+                throw std::runtime_error(std::format("{} : Invalid build name '{}', use letters, digits, '.', '-' and '_'", __FUNCTION__, build));
+        }
+
+        inline std::string ReadFile(const std::filesystem::path& path) {
+            std::ifstream f(path, std::ios::in | std::ios::binary);
+            if (!f)
+                throw std::runtime_error(std::format("{} : Unable to open '{}'", __FUNCTION__, path.string()));
+
+            return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        }
+
+        // @note: through a temporary file, so a file that exists is always complete
+        //
+        inline void WriteFileAtomic(const std::filesystem::path& path, const void* data, const std::size_t size) {
+            auto temp_path = path;
+            temp_path += ".tmp";
+
+            std::ofstream f(temp_path, std::ios::out | std::ios::binary);
+            f.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            f.close();
+
+            if (!f)
+                throw std::runtime_error(std::format("{} : Unable to write '{}'", __FUNCTION__, temp_path.string()));
+
+            std::filesystem::rename(temp_path, path);
+        }
+
+        inline std::filesystem::path GetObjectDir(const std::filesystem::path& archiveDir, const std::uint64_t object) {
+            return archiveDir / "objects" / std::format("{:02x}", object >> 56);
+        }
+
+        inline std::filesystem::path GetObjectPath(const std::filesystem::path& archiveDir, const std::uint64_t object) {
+            return GetObjectDir(archiveDir, object) / std::format("{:014x}", object & 0x00FFFFFFFFFFFFFFull);
+        }
+
+        inline std::filesystem::path GetManifestPath(const std::filesystem::path& archiveDir, const std::string& build) {
+            return archiveDir / "builds" / (build + ".manifest");
+        }
+
+        inline std::vector<std::string> LoadBuilds(const std::filesystem::path& archiveDir) {
+            const auto path = archiveDir / "builds.json";
+            if (!std::filesystem::exists(path))
+                return {};
+
+            const auto text = ReadFile(path);
+            const auto root = dump_reader::parser_t(text).parse();
+
+            std::vector<std::string> result;
+            if (const auto builds = root.find("builds")) {
+                for (const auto& build : builds->items())
+                    result.push_back(build.as_string());
+            }
+
+            return result;
+        }
+
+        inline void SaveBuilds(const std::filesystem::path& archiveDir, const std::vector<std::string>& builds) {
+            auto builder = codegen::get();
+            builder.begin_json_object();
+            builder.json_key("builds").begin_json_array_value();
+            for (const auto& build : builds)
+                builder.json_string_element(build);
+            builder.end_json_array();
+            builder.end_json_object(false);
+
+            const auto text = builder.str();
+            WriteFileAtomic(archiveDir / "builds.json", text.data(), text.size());
+        }
+
+        struct manifest_t {
+            std::string m_data = "";
+
+            [[nodiscard]] archive::view_t view() const {
+                return archive::view_t(m_data.data(), m_data.size());
+            }
+        };
+
+        inline manifest_t LoadManifest(const std::filesystem::path& archiveDir, const std::string& build) {
+            const auto path = GetManifestPath(archiveDir, build);
+
+            manifest_t result = {ReadFile(path)};
+            if (!result.view().valid())
+                throw std::runtime_error(std::format("{} : '{}' is not a valid manifest", __FUNCTION__, path.string()));
+
+            return result;
+        }
+
+        inline std::uint64_t GetObjectHash(const type_fragment_t& fragment) {
+            return fnv64::hash_runtime_data(fragment.m_text.data(), fragment.m_text.size());
+        }
+    } // namespace detail
+
+    // @note: adds the scopes to the archive at `archiveDir` as `build`
+    //
+    inline archive_stats_t IngestArchiveBuild(const std::vector<rendered_scope_t>& scopes, const std::filesystem::path& archiveDir, const std::string& build,
+                                              const std::uint32_t threads) {
+        detail::ValidateBuildName(build);
+        std::filesystem::create_directories(archiveDir / "builds");
+
+        auto builds = detail::LoadBuilds(archiveDir);
+
+        // @note: whatever the last build references is known to be stored, only the other objects need to be looked up on disk
+        //
+        std::unordered_set<std::uint64_t> known_objects;
+        if (!builds.empty()) {
+            const auto previous = detail::LoadManifest(archiveDir, builds.back());
+            const auto view = previous.view();
+            for (std::uint32_t i = 0; i < view.header().entry_count; ++i)
+                known_objects.insert(view.entries()[i].object);
+        }
+
+        archive_stats_t stats;
+        binary::string_table_t strings;
+        std::vector<archive::scope_t> manifest_scopes;
+        std::vector<archive::entry_t> manifest_entries;
+        std::unordered_map<std::uint64_t, const type_fragment_t*> candidates;
+
+        const auto add_entries = [&](const std::vector<type_fragment_t>& fragments) {
+            for (const auto& fragment : fragments) {
+                const auto object = detail::GetObjectHash(fragment);
+                manifest_entries.push_back({fnv64::hash_runtime(fragment.m_name), object});
+
+                if (!known_objects.contains(object))
+                    candidates.emplace(object, &fragment);
+            }
+
+            stats.m_types += fragments.size();
+        };
+
+        for (const auto& scope : scopes) {
+            archive::scope_t entry = {};
+            entry.name = strings.add(scope.m_name);
+            entry.first_entry = static_cast<std::uint32_t>(manifest_entries.size());
+            entry.enum_count = static_cast<std::uint32_t>(scope.m_enums.size());
+            entry.class_count = static_cast<std::uint32_t>(scope.m_classes.size());
+            manifest_scopes.push_back(entry);
+
+            add_entries(scope.m_enums);
+            add_entries(scope.m_classes);
+        }
+
+        // @note: a candidate may still be on disk, e.g. a class that got reverted to how it was a few builds ago
+        //
+        std::vector<std::pair<std::uint64_t, const type_fragment_t*>> new_objects;
+        std::set<std::filesystem::path> object_dirs;
+        for (const auto& [object, fragment] : candidates) {
+            if (std::filesystem::exists(detail::GetObjectPath(archiveDir, object)))
+                continue;
+
+            new_objects.emplace_back(object, fragment);
+            object_dirs.insert(detail::GetObjectDir(archiveDir, object));
+        }
+
+        for (const auto& dir : object_dirs)
+            std::filesystem::create_directories(dir);
+
+        parallel::for_each(new_objects.size(), threads, [&](const std::size_t i) {
+            const auto& [object, fragment] = new_objects[i];
+            detail::WriteFileAtomic(detail::GetObjectPath(archiveDir, object), fragment->m_text.data(), fragment->m_text.size());
+        });
+
+        stats.m_new_objects = new_objects.size();
+        for (const auto& [object, fragment] : new_objects)
+            stats.m_bytes_written += fragment->m_text.size();
+
+        archive::header_t header = {};
+        header.magic = archive::kMagic;
+        header.version = archive::kVersion;
+        header.scope_count = static_cast<std::uint32_t>(manifest_scopes.size());
+        header.entry_count = static_cast<std::uint32_t>(manifest_entries.size());
+        header.strings_size = static_cast<std::uint32_t>(strings.data().size());
+
+        binary::writer_t writer;
+        writer.write(header).write_array(manifest_scopes).write_array(manifest_entries).write_bytes(strings.data().data(), strings.data().size());
+        detail::WriteFileAtomic(detail::GetManifestPath(archiveDir, build), writer.data().data(), writer.size());
+        stats.m_bytes_written += writer.size();
+
+        // @note: archiving a build again replaces its manifest but keeps its place in the history
+        //
+        if (std::find(builds.begin(), builds.end(), build) == builds.end()) {
+            builds.push_back(build);
+            detail::SaveBuilds(archiveDir, builds);
+        }
+
+        return stats;
+    }
+
+    // @note: writes the <scope>.json files of an archived build, as a plain dump of it would have
+    //
+    inline void MaterializeArchiveBuild(const std::filesystem::path& archiveDir, const std::string& build, const std::filesystem::path& outDirName,
+                                        const std::uint32_t threads) {
+        detail::ValidateBuildName(build);
+
+        const auto manifest = detail::LoadManifest(archiveDir, build);
+        const auto view = manifest.view();
+
+        if (!std::filesystem::exists(outDirName))
+            std::filesystem::create_directories(outDirName);
+
+        parallel::for_each(view.header().scope_count, threads, [&](const std::size_t i) {
+            const auto& scope = view.scopes()[i];
+
+            std::vector<type_fragment_t> fragments(scope.enum_count + scope.class_count);
+            for (std::size_t j = 0; j < fragments.size(); ++j) {
+                const auto object = view.entries()[scope.first_entry + j].object;
+                fragments[j].m_text = detail::ReadFile(detail::GetObjectPath(archiveDir, object));
+
+                if (detail::GetObjectHash(fragments[j]) != object)
+                    throw std::runtime_error(std::format("{} : Object {:016x} is corrupted", __FUNCTION__, object));
+            }
+
+            std::vector<const type_fragment_t*> enums, classes;
+            for (std::size_t j = 0; j < fragments.size(); ++j)
+                (j < scope.enum_count ? enums : classes).push_back(&fragments[j]);
+
+            const auto text = AssembleScopeJson(enums, classes);
+
+            std::ofstream f(outDirName / std::format("{}.json", view.scope_name(scope)), std::ios::out | std::ios::binary);
+            f << text;
+            f.close();
+        });
+    }
+
+    // @note: every build in which a class or enum named `type_name` was added, changed or removed, in archive order
+    //
+    inline std::vector<archive_change_t> GetArchiveHistory(const std::filesystem::path& archiveDir, const std::string& type_name) {
+        const auto name_hash = fnv64::hash_runtime(type_name.c_str());
+
+        std::vector<archive_change_t> result;
+        std::map<std::pair<std::string, bool>, std::uint64_t> previous; // (scope, is_class) -> object
+
+        for (const auto& build : detail::LoadBuilds(archiveDir)) {
+            const auto manifest = detail::LoadManifest(archiveDir, build);
+            const auto view = manifest.view();
+
+            std::map<std::pair<std::string, bool>, std::uint64_t> current;
+            for (std::uint32_t i = 0; i < view.header().scope_count; ++i) {
+                const auto& scope = view.scopes()[i];
+                for (const auto is_class : {false, true}) {
+                    if (const auto entry = view.find(scope, name_hash, is_class))
+                        current[{std::string(view.scope_name(scope)), is_class}] = entry->object;
+                }
+            }
+
+            for (const auto& [key, object] : current) {
+                const auto it = previous.find(key);
+                if (it == previous.end())
+                    result.push_back({build, key.first, key.second, archive_change_kind_t::kAdded, object});
+                else if (it->second != object)
+                    result.push_back({build, key.first, key.second, archive_change_kind_t::kChanged, object});
+            }
+
+            for (const auto& [key, object] : previous) {
+                if (!current.contains(key))
+                    result.push_back({build, key.first, key.second, archive_change_kind_t::kRemoved, object});
+            }
+
+            previous = std::move(current);
+        }
+
+        return result;
+    }
+} // namespace sdk
@@ -0,0 +1,184 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sdk/dump_index.h"
+#include "tools/binary_writer.h"
+#include "tools/lz.h"
+#include "tools/mapped_file.h"
+#include "tools/parallel.h"
+
+// Layout of <scope>.jsonlz, what -compress writes instead of <scope>.json.
+//
+// The file is a header_t, header_t::block_count block_t and then the compressed blocks. Every block is
+// an independent LZ4 block holding a consecutive range of the json, and blocks only ever start where a
+// class or enum starts, so an entry of the <scope>.idx sidecar (whose offsets are into the uncompressed
+// json) is always found whole in a single block.
+namespace compressed_dump {
+    constexpr std::uint32_t kMagic = 0x5A4C3253; // 'S2LZ'
+    constexpr std::uint32_t kVersion = 1;
+
+#pragma pack(push, 1)
+    struct header_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t block_count;
+        std::uint32_t block_size; // size the writer aimed for, a block holding a single big class can be larger
+        std::uint64_t uncompressed_size;
+    };
+
+    struct block_t {
+        std::uint64_t offset; // of the compressed data, from the start of the file
+        std::uint64_t uncompressed_offset;
+        std::uint32_t size;
+        std::uint32_t uncompressed_size;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(header_t) == 24);
+    static_assert(sizeof(block_t) == 24);
+
+    // @note: the whole <scope>.jsonlz for `text`, in blocks of about `block_size` bytes that start at an entry of `index_entries`
+    // (in file order). a block is closed at the first entry that would take it past `block_size`, so no entry is ever split
+    //
+    inline std::vector<std::uint8_t> serialize(const std::string_view text, const std::vector<dump_index::entry_t>& index_entries, const std::size_t block_size,
+                                               const std::uint32_t threads) {
+        std::vector<block_t> blocks(1);
+        for (const auto& entry : index_entries) {
+            const auto block_start = blocks.back().uncompressed_offset;
+            if (entry.offset - block_start + entry.length > block_size && entry.offset != block_start)
+                blocks.emplace_back().uncompressed_offset = entry.offset;
+        }
+
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            const auto block_end = i + 1 < blocks.size() ? blocks[i + 1].uncompressed_offset : text.size();
+            blocks[i].uncompressed_size = static_cast<std::uint32_t>(block_end - blocks[i].uncompressed_offset);
+        }
+
+        std::vector<std::vector<std::uint8_t>> compressed(blocks.size());
+        parallel::for_each(blocks.size(), threads, [&](const std::size_t i) {
+            const auto data = reinterpret_cast<const std::uint8_t*>(text.data()) + blocks[i].uncompressed_offset;
+            compressed[i].reserve(blocks[i].uncompressed_size);
+            lz::compress(data, blocks[i].uncompressed_size, compressed[i]);
+        });
+
+        std::uint64_t offset = sizeof(header_t) + blocks.size() * sizeof(block_t);
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            blocks[i].offset = offset;
+            blocks[i].size = static_cast<std::uint32_t>(compressed[i].size());
+            offset += compressed[i].size();
+        }
+
+        header_t header = {};
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.block_count = static_cast<std::uint32_t>(blocks.size());
+        header.block_size = static_cast<std::uint32_t>(block_size);
+        header.uncompressed_size = text.size();
+
+        binary::writer_t writer;
+        writer.write(header).write_array(blocks);
+        for (const auto& block : compressed)
+            writer.write_array(block);
+
+        return writer.data();
+    }
+
+    // @note: maps a <scope>.jsonlz and only decompresses the blocks that are asked for
+    //
+    struct reader_t {
+        static reader_t open(const std::filesystem::path& path) {
+            reader_t result;
+            result._file = mapped_file::file_t::open(path);
+
+            const auto data = result._file.view();
+            if (data.size() < sizeof(header_t))
+                throw std::runtime_error(std::format("{} : '{}' is too small", __FUNCTION__, path.string()));
+
+            const auto header = reinterpret_cast<const header_t*>(data.data());
+            if (header->magic != kMagic || header->version != kVersion ||
+                data.size() < sizeof(header_t) + std::uint64_t{header->block_count} * sizeof(block_t))
+                throw std::runtime_error(std::format("{} : '{}' is not a compressed dump", __FUNCTION__, path.string()));
+
+            for (std::uint32_t i = 0; i < header->block_count; ++i) {
+                const auto& block = result.blocks()[i];
+                if (block.offset + block.size > data.size() || block.uncompressed_offset + block.uncompressed_size > header->uncompressed_size)
+                    throw std::runtime_error(std::format("{} : '{}' has a broken block table", __FUNCTION__, path.string()));
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] const header_t& header() const {
+            return *reinterpret_cast<const header_t*>(_file.view().data());
+        }
+
+        [[nodiscard]] const block_t* blocks() const {
+            return reinterpret_cast<const block_t*>(&header() + 1);
+        }
+
+        // @note: size of the json once decompressed, what the sidecar's file_size refers to
+        //
+        [[nodiscard]] std::uint64_t size() const {
+            return header().uncompressed_size;
+        }
+
+        // @note: the block holding `offset` of the uncompressed json, nullptr if it's out of range
+        //
+        [[nodiscard]] const block_t* find_block(const std::uint64_t offset) const {
+            const auto begin = blocks();
+            const auto end = begin + header().block_count;
+
+            const auto it = std::upper_bound(begin, end, offset, [](const std::uint64_t value, const block_t& block) { return value < block.uncompressed_offset; });
+            if (it == begin || offset >= (it - 1)->uncompressed_offset + (it - 1)->uncompressed_size)
+                return nullptr;
+
+            return it - 1;
+        }
+
+        void decompress(const block_t& block, char* out) const {
+            const auto source = reinterpret_cast<const std::uint8_t*>(_file.view().data() + block.offset);
+            if (!lz::decompress(source, block.size, reinterpret_cast<std::uint8_t*>(out), block.uncompressed_size))
+                throw std::runtime_error(std::format("{} : Corrupted block at {}", __FUNCTION__, block.offset));
+        }
+
+        // @note: `length` bytes of the uncompressed json from `offset`, decompressing every block they span
+        //
+        [[nodiscard]] std::string read(std::uint64_t offset, const std::uint64_t length) const {
+            std::string result;
+            result.reserve(length);
+
+            std::string buffer;
+            while (result.size() < length) {
+                const auto block = find_block(offset);
+                if (block == nullptr)
+                    throw std::runtime_error(std::format("{} : Offset {} is out of range", __FUNCTION__, offset));
+
+                buffer.resize(block->uncompressed_size);
+                decompress(*block, buffer.data());
+
+                const auto begin = offset - block->uncompressed_offset;
+                const auto count = std::min<std::uint64_t>(length - result.size(), block->uncompressed_size - begin);
+                result.append(buffer, begin, count);
+                offset += count;
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] std::string read_all() const {
+            std::string result(size(), '\0');
+            for (std::uint32_t i = 0; i < header().block_count; ++i)
+                decompress(blocks()[i], result.data() + blocks()[i].uncompressed_offset);
+
+            return result;
+        }
+    private:
+        mapped_file::file_t _file;
+    };
+} // namespace compressed_dump
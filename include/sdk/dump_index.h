@@ -0,0 +1,102 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "tools/binary_writer.h"
+#include "tools/fnv.h"
+
+// Layout of <scope>.idx, the sidecar written next to <scope>.json with -idx.
+//
+// The file is a header_t followed by header_t::entry_count entry_t sorted by (hash, kind). Every entry
+// covers the `"Name": { ... }` text of one top-level class or enum, without the trailing comma, so
+// a reader can seek straight to it. header_t::file_size lets readers reject a sidecar that doesn't
+// belong to the json next to it.
+namespace dump_index {
+    constexpr std::uint32_t kMagic = 0x49443253; // 'S2DI'
+    constexpr std::uint32_t kVersion = 1;
+
+    enum class kind_t : std::uint8_t {
+        kEnum = 0,
+        kClass,
+    };
+
+#pragma pack(push, 1)
+    struct header_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t entry_count;
+        std::uint32_t reserved;
+        std::uint64_t file_size; // size of the json this index was written for
+    };
+
+    struct entry_t {
+        std::uint64_t hash; // fnv64 of the name
+        std::uint64_t offset;
+        std::uint32_t length;
+        kind_t kind;
+        std::uint8_t reserved[3];
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(header_t) == 24);
+    static_assert(sizeof(entry_t) == 24);
+
+    constexpr bool operator<(const entry_t& a, const entry_t& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.kind < b.kind;
+    }
+
+    // @note: binary search over the entries following `header`, nullptr if there is no such entry
+    //
+    inline const entry_t* find(const header_t* header, const std::uint64_t hash, const kind_t kind) {
+        const auto begin = reinterpret_cast<const entry_t*>(header + 1);
+        const auto end = begin + header->entry_count;
+
+        auto first = begin;
+        std::uint32_t count = header->entry_count;
+
+        const entry_t key = {hash, 0, 0, kind, {}};
+        while (count > 0) {
+            const auto half = count / 2;
+            if (first[half] < key) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+
+        return first != end && first->hash == hash && first->kind == kind ? first : nullptr;
+    }
+
+    // @note: entry of a rendered `"Name": { ... },` fragment that starts at `fragment_offset` in the json, from the
+    // quote to the closing brace
+    //
+    inline entry_t make_entry(const std::string_view name, const std::string_view fragment, const std::uint64_t fragment_offset, const kind_t kind) {
+        const auto begin = fragment.find('"');
+        const auto end = fragment.rfind('}');
+
+        entry_t entry = {};
+        entry.hash = fnv64::hash_runtime(name.data(), name.size());
+        entry.offset = fragment_offset + begin;
+        entry.length = static_cast<std::uint32_t>(end + 1 - begin);
+        entry.kind = kind;
+        return entry;
+    }
+
+    // @note: the sidecar of a json of `file_size` bytes
+    //
+    inline std::vector<std::uint8_t> serialize(std::vector<entry_t> entries, const std::uint64_t file_size) {
+        std::sort(entries.begin(), entries.end());
+
+        header_t header = {};
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.entry_count = static_cast<std::uint32_t>(entries.size());
+        header.file_size = file_size;
+
+        binary::writer_t writer;
+        writer.write(header).write_array(entries);
+        return writer.data();
+    }
+} // namespace dump_index
@@ -0,0 +1,225 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "tools/binary_writer.h"
+#include "tools/enum_table.h"
+
+// Layout of <scope>.enums.bin, the value to name tables of every enum of a scope (see tools/enum_table.h
+// for how an enum gets classified).
+//
+// The file is a header_t followed by header_t::enum_count enum_t (sorted by name), header_t::slot_count
+// string offsets, header_t::value_count value_t and header_t::strings_size bytes of null-terminated strings.
+// A kDense enum owns the slots for the values [base, base + slot_count), a kFlags enum owns a slot per bit
+// of its storage and a kSparse/kFlags enum owns value_count values sorted by value. Empty slots are kNoString.
+namespace enum_lookup {
+    constexpr std::uint32_t kMagic = 0x4C453253; // 'S2EL'
+    constexpr std::uint32_t kVersion = 1;
+
+    constexpr std::uint32_t kNoString = 0xFFFFFFFF;
+
+    enum class kind_t : std::uint8_t {
+        kDense = 0,
+        kSparse,
+        kFlags,
+    };
+
+#pragma pack(push, 1)
+    struct header_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t enum_count;
+        std::uint32_t slot_count;
+        std::uint32_t value_count;
+        std::uint32_t strings_size;
+    };
+
+    struct enum_t {
+        std::uint32_t name;
+        kind_t kind;
+        std::uint8_t size; // in bytes
+        std::uint16_t reserved;
+        std::uint32_t first_slot;
+        std::uint32_t slot_count;
+        std::uint32_t first_value;
+        std::uint32_t value_count;
+        std::int64_t base; // kDense: the value of the first slot
+    };
+
+    struct value_t {
+        std::int64_t value;
+        std::uint32_t name;
+        std::uint32_t reserved;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(header_t) == 24);
+    static_assert(sizeof(enum_t) == 32);
+    static_assert(sizeof(value_t) == 16);
+
+    // @note: read only view over a file mapped or loaded by the caller
+    //
+    struct view_t {
+        view_t(const void* data, const std::size_t size): _data(static_cast<const std::uint8_t*>(data)), _size(size) { }
+
+        [[nodiscard]] bool valid() const {
+            if (_size < sizeof(header_t) || header().magic != kMagic || header().version != kVersion)
+                return false;
+
+            const auto tables_size = sizeof(header_t) + std::uint64_t{header().enum_count} * sizeof(enum_t) +
+                                     std::uint64_t{header().slot_count} * sizeof(std::uint32_t) + std::uint64_t{header().value_count} * sizeof(value_t);
+            if (_size < tables_size + header().strings_size)
+                return false;
+
+            for (std::uint32_t i = 0; i < header().enum_count; ++i) {
+                const auto& entry = enums()[i];
+                if (std::uint64_t{entry.first_slot} + entry.slot_count > header().slot_count ||
+                    std::uint64_t{entry.first_value} + entry.value_count > header().value_count || entry.name >= header().strings_size)
+                    return false;
+            }
+
+            return header().strings_size != 0 && strings()[header().strings_size - 1] == '\0';
+        }
+
+        [[nodiscard]] const header_t& header() const {
+            return *reinterpret_cast<const header_t*>(_data);
+        }
+
+        [[nodiscard]] const enum_t* enums() const {
+            return reinterpret_cast<const enum_t*>(_data + sizeof(header_t));
+        }
+
+        [[nodiscard]] std::string_view enum_name(const enum_t& entry) const {
+            return strings() + entry.name;
+        }
+
+        // @note: binary search by name, nullptr if the scope has no such enum
+        //
+        [[nodiscard]] const enum_t* find_enum(const std::string_view name) const {
+            auto first = enums();
+            std::uint32_t count = header().enum_count;
+            while (count > 0) {
+                const auto half = count / 2;
+                if (enum_name(first[half]) < name) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+
+            return first != enums() + header().enum_count && enum_name(*first) == name ? first : nullptr;
+        }
+
+        // @note: name of the enumerator with exactly this value, nullptr if there is none
+        //
+        [[nodiscard]] const char* name_of(const enum_t& entry, const std::int64_t value) const {
+            if (entry.kind == kind_t::kDense) {
+                const auto slot = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(entry.base);
+                return slot < entry.slot_count ? string(slots()[entry.first_slot + slot]) : nullptr;
+            }
+
+            if (entry.kind == kind_t::kFlags && value > 0 && (value & (value - 1)) == 0) {
+                const auto bit = static_cast<std::uint32_t>(std::countr_zero(static_cast<std::uint64_t>(value)));
+                return bit < entry.slot_count ? string(slots()[entry.first_slot + bit]) : nullptr;
+            }
+
+            if (entry.value_count == 0)
+                return nullptr;
+
+            // @note: branchless, the values of an enum are a handful and the one asked for is hard to predict
+            //
+            const auto first = values() + entry.first_value;
+            std::uint32_t index = 0;
+            for (auto count = entry.value_count; count > 1; count -= count / 2)
+                index += static_cast<std::uint32_t>(first[index + count / 2 - 1].value < value) * (count / 2);
+
+            return first[index].value == value ? string(first[index].name) : nullptr;
+        }
+
+        // @note: calls `fn(const char*)` with the name of every set bit of a kFlags enum, lowest first. bits without a name are skipped
+        //
+        template <typename Fn>
+        void for_each_flag(const enum_t& entry, std::uint64_t value, Fn&& fn) const {
+            if (entry.kind != kind_t::kFlags)
+                return;
+
+            for (; value != 0; value &= value - 1) {
+                const auto bit = static_cast<std::uint32_t>(std::countr_zero(value));
+                if (bit < entry.slot_count && slots()[entry.first_slot + bit] != kNoString)
+                    fn(string(slots()[entry.first_slot + bit]));
+            }
+        }
+    private:
+        [[nodiscard]] const std::uint32_t* slots() const {
+            return reinterpret_cast<const std::uint32_t*>(enums() + header().enum_count);
+        }
+
+        [[nodiscard]] const value_t* values() const {
+            return reinterpret_cast<const value_t*>(slots() + header().slot_count);
+        }
+
+        [[nodiscard]] const char* strings() const {
+            return reinterpret_cast<const char*>(values() + header().value_count);
+        }
+
+        [[nodiscard]] const char* string(const std::uint32_t offset) const {
+            return offset != kNoString ? strings() + offset : nullptr;
+        }
+
+        const std::uint8_t* _data;
+        std::size_t _size;
+    };
+
+    // @note: an enum as it goes into the file, `table` refers to `enumerators` (declaration order) by index
+    //
+    struct source_t {
+        std::string_view m_name = "";
+        std::uint8_t m_size = 0;
+        const enum_table::table_t* m_table = nullptr;
+        std::vector<std::string_view> m_enumerators = {};
+    };
+
+    // @note: `sources` sorted by name
+    //
+    inline std::vector<std::uint8_t> serialize(const std::vector<source_t>& sources) {
+        binary::string_table_t strings;
+        std::vector<enum_t> enums;
+        std::vector<std::uint32_t> slots;
+        std::vector<value_t> values;
+
+        for (const auto& source : sources) {
+            const auto& table = *source.m_table;
+
+            auto& item = enums.emplace_back();
+            item.name = strings.add(source.m_name);
+            item.kind = static_cast<kind_t>(table.m_kind);
+            item.size = source.m_size;
+            item.first_slot = static_cast<std::uint32_t>(slots.size());
+            item.slot_count = static_cast<std::uint32_t>(table.m_slots.size());
+            item.first_value = static_cast<std::uint32_t>(values.size());
+            item.value_count = static_cast<std::uint32_t>(table.m_sorted.size());
+            item.base = table.m_base;
+
+            for (const auto index : table.m_slots)
+                slots.push_back(index != enum_table::kNone ? strings.add(source.m_enumerators[index]) : kNoString);
+
+            for (const auto& sorted : table.m_sorted)
+                values.push_back({sorted.m_value, strings.add(source.m_enumerators[sorted.m_index]), 0});
+        }
+
+        header_t header = {};
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.enum_count = static_cast<std::uint32_t>(enums.size());
+        header.slot_count = static_cast<std::uint32_t>(slots.size());
+        header.value_count = static_cast<std::uint32_t>(values.size());
+        header.strings_size = static_cast<std::uint32_t>(strings.data().size());
+
+        binary::writer_t writer;
+        writer.write(header).write_array(enums).write_array(slots).write_array(values);
+        writer.write_bytes(strings.data().data(), strings.data().size());
+        return writer.data();
+    }
+} // namespace enum_lookup
@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "tools/codegen.h"
+#include "tools/fnv.h"
+#include "tools/perfect_hash.h"
+
+// The <scope>_lookup.hpp that -lookup writes: a minimal perfect hash over the class names of a scope and one over
+// the field names of every class (hashed together with the index of their class), with constexpr find_class and
+// find_field on top.
+//
+// Rendering only needs the names and ids, so the header can be generated and compiled outside of the game.
+namespace sdk {
+    struct lookup_class_t {
+        std::string_view m_name = {};
+        std::uint32_t m_id = 0;
+        std::vector<std::string_view> m_fields = {}; // networked fields in declaration order
+        std::vector<std::uint32_t> m_field_ids = {}; // empty without ids
+    };
+
+    namespace detail {
+        constexpr std::size_t kLookupValuesPerLine = 16;
+
+        template <typename T>
+        void WriteLookupArray(codegen::generator_t::self_ref builder, const char* type, const char* name, const std::vector<T>& values) {
+            builder.push_line(std::format("inline constexpr {} {}[] = {{", type, name));
+            builder.inc_tabs_count(codegen::kTabsPerBlock);
+
+            for (std::size_t i = 0; i < values.size(); i += kLookupValuesPerLine) {
+                std::string line;
+                for (std::size_t j = i; j < std::min(values.size(), i + kLookupValuesPerLine); ++j)
+                    line += std::format("{}, ", values[j]);
+                line.pop_back();
+                builder.push_line(line);
+            }
+
+            // @note: zero sized arrays aren't allowed
+            //
+            if (values.empty())
+                builder.push_line("0");
+
+            builder.dec_tabs_count(codegen::kTabsPerBlock);
+            builder.push_line("};");
+        }
+
+        inline void WriteLookupStrings(codegen::generator_t::self_ref builder, const char* name, const std::vector<std::string_view>& values) {
+            builder.push_line(std::format("inline constexpr std::string_view {}[] = {{", name));
+            builder.inc_tabs_count(codegen::kTabsPerBlock);
+
+            for (const auto value : values)
+                builder.push_line(std::format("\"{}\",", codegen::escape_cpp_string(value)));
+
+            if (values.empty())
+                builder.push_line("\"\"");
+
+            builder.dec_tabs_count(codegen::kTabsPerBlock);
+            builder.push_line("};");
+        }
+
+        inline std::uint64_t GetLookupFieldHash(const std::uint32_t class_index, const std::string_view field_name) {
+            return fnv64::hash_runtime_data(field_name.data(), field_name.size()) + class_index;
+        }
+    } // namespace detail
+
+    // @note: the whole header, in `namespace schema_lookup::<namespace_name>`. class ids and field ids are only written
+    // with `write_ids`
+    //
+    inline std::string RenderLookupTables(const std::string_view namespace_name, const std::vector<lookup_class_t>& classes, const bool write_ids) {
+        // @note: classes are stored in slot order, so the class index returned by find_class is the slot itself
+        //
+        std::vector<std::uint64_t> class_hashes;
+        class_hashes.reserve(classes.size());
+        for (const auto& lookup_class : classes)
+            class_hashes.push_back(fnv64::hash_runtime_data(lookup_class.m_name.data(), lookup_class.m_name.size()));
+
+        const auto class_table = perfect_hash::build(class_hashes);
+
+        std::vector<std::string_view> class_names;
+        std::vector<std::uint32_t> class_ids;
+        std::vector<std::uint64_t> field_hashes;
+        std::vector<std::string_view> field_names;
+        std::vector<std::uint32_t> field_classes;
+        std::vector<std::uint32_t> field_ids;
+
+        for (std::uint32_t class_index = 0; class_index < class_table.m_keys.size(); ++class_index) {
+            const auto& lookup_class = classes[class_table.m_keys[class_index]];
+            class_names.push_back(lookup_class.m_name);
+            if (write_ids)
+                class_ids.push_back(lookup_class.m_id);
+
+            for (std::size_t i = 0; i < lookup_class.m_fields.size(); ++i) {
+                field_hashes.push_back(detail::GetLookupFieldHash(class_index, lookup_class.m_fields[i]));
+                field_names.push_back(lookup_class.m_fields[i]);
+                field_classes.push_back(class_index);
+                if (write_ids)
+                    field_ids.push_back(lookup_class.m_field_ids[i]);
+            }
+        }
+
+        const auto field_table = perfect_hash::build(field_hashes);
+
+        const auto reorder = [](const auto& values, const std::vector<std::uint32_t>& order) {
+            std::remove_cvref_t<decltype(values)> result;
+            result.reserve(order.size());
+            for (const auto index : order)
+                result.push_back(values[index]);
+            return result;
+        };
+
+        auto builder = codegen::get();
+
+        builder.comment("Generated by CS2SchemaGen, do not edit");
+        builder.push_line("#pragma once");
+        builder.push_line("#include <cstdint>");
+        builder.push_line("#include <iterator>");
+        builder.push_line("#include <string_view>");
+        builder.next_line();
+        builder.push_line(std::format("namespace schema_lookup::{} {{", namespace_name));
+        builder.inc_tabs_count(codegen::kTabsPerBlock);
+
+        builder.push_line(std::format("constexpr std::uint32_t kClassCount = {};", class_names.size()));
+        builder.push_line(std::format("constexpr std::uint32_t kFieldCount = {};", field_names.size()));
+        builder.push_line("constexpr std::uint32_t kNotFound = 0xFFFFFFFF;");
+        builder.next_line();
+
+        builder.push_line("namespace detail {");
+        builder.inc_tabs_count(codegen::kTabsPerBlock);
+        builder.push_line("constexpr std::uint64_t fnv64(const std::string_view str) {");
+        builder.push_line("  std::uint64_t result = 0xcbf29ce484222325ull;");
+        builder.push_line("  for (const auto c : str)");
+        builder.push_line("    result = (result ^ static_cast<std::uint8_t>(c)) * 1099511628211ull;");
+        builder.push_line("  return result;");
+        builder.push_line("}");
+        builder.next_line();
+        builder.push_line("constexpr std::uint32_t slot(std::uint64_t value, const std::uint32_t displacement, const std::uint32_t count) {");
+        builder.push_line("  value ^= displacement;");
+        builder.push_line("  value ^= value >> 30;");
+        builder.push_line("  value *= 0xbf58476d1ce4e5b9ull;");
+        builder.push_line("  value ^= value >> 27;");
+        builder.push_line("  value *= 0x94d049bb133111ebull;");
+        builder.push_line("  value ^= value >> 31;");
+        builder.push_line("  return static_cast<std::uint32_t>(value % count);");
+        builder.push_line("}");
+        builder.next_line();
+        detail::WriteLookupArray(builder, "std::uint32_t", "kClassDisplacements", class_table.m_displacements);
+        detail::WriteLookupStrings(builder, "kClassNames", class_names);
+        detail::WriteLookupArray(builder, "std::uint32_t", "kFieldDisplacements", field_table.m_displacements);
+        detail::WriteLookupStrings(builder, "kFieldNames", reorder(field_names, field_table.m_keys));
+        detail::WriteLookupArray(builder, "std::uint32_t", "kFieldClasses", reorder(field_classes, field_table.m_keys));
+        if (write_ids) {
+            detail::WriteLookupArray(builder, "std::uint32_t", "kClassIds", class_ids);
+            detail::WriteLookupArray(builder, "std::uint32_t", "kFieldIds", reorder(field_ids, field_table.m_keys));
+        }
+        builder.dec_tabs_count(codegen::kTabsPerBlock);
+        builder.push_line("} // namespace detail");
+        builder.next_line();
+
+        builder.comment("index in [0, kClassCount) or kNotFound");
+        builder.push_line("constexpr std::uint32_t find_class(const std::string_view name) {");
+        builder.push_line("  if constexpr (kClassCount == 0)");
+        builder.push_line("    return kNotFound;");
+        builder.push_line("  const auto hash = detail::fnv64(name);");
+        builder.push_line("  const auto displacement = detail::kClassDisplacements[hash % std::size(detail::kClassDisplacements)];");
+        builder.push_line("  const auto index = detail::slot(hash, displacement, kClassCount);");
+        builder.push_line("  return detail::kClassNames[index] == name ? index : kNotFound;");
+        builder.push_line("}");
+        builder.next_line();
+        builder.comment("index in [0, kFieldCount) or kNotFound, `class_index` comes from find_class");
+        builder.push_line("constexpr std::uint32_t find_field(const std::uint32_t class_index, const std::string_view name) {");
+        builder.push_line("  if constexpr (kFieldCount == 0)");
+        builder.push_line("    return kNotFound;");
+        builder.push_line("  const auto hash = detail::fnv64(name) + class_index;");
+        builder.push_line("  const auto displacement = detail::kFieldDisplacements[hash % std::size(detail::kFieldDisplacements)];");
+        builder.push_line("  const auto index = detail::slot(hash, displacement, kFieldCount);");
+        builder.push_line("  return detail::kFieldClasses[index] == class_index && detail::kFieldNames[index] == name ? index : kNotFound;");
+        builder.push_line("}");
+        builder.next_line();
+        builder.push_line("constexpr std::string_view class_name(const std::uint32_t class_index) {");
+        builder.push_line("  return detail::kClassNames[class_index];");
+        builder.push_line("}");
+        builder.next_line();
+        builder.push_line("constexpr std::string_view field_name(const std::uint32_t field_index) {");
+        builder.push_line("  return detail::kFieldNames[field_index];");
+        builder.push_line("}");
+
+        if (write_ids) {
+            builder.next_line();
+            builder.push_line("constexpr std::uint32_t class_id(const std::uint32_t class_index) {");
+            builder.push_line("  return detail::kClassIds[class_index];");
+            builder.push_line("}");
+            builder.next_line();
+            builder.push_line("constexpr std::uint32_t field_id(const std::uint32_t field_index) {");
+            builder.push_line("  return detail::kFieldIds[field_index];");
+            builder.push_line("}");
+        }
+
+        builder.dec_tabs_count(codegen::kTabsPerBlock);
+        builder.push_line(std::format("}} // namespace schema_lookup::{}", namespace_name));
+
+        return builder.str();
+    }
+} // namespace sdk
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+
+// Layout of <scope>.netplan.bin, the per-scope table of network field decode plans.
+//
+// The file is a header_t followed by header_t::class_count class_t entries (sorted by name),
+// header_t::field_count field_t entries, header_t::serializer_count string offsets and finally
+// header_t::strings_size bytes of null-terminated strings. Every name is an offset into that
+// string blob, so a reader can map the file and use it in place.
+namespace netplan {
+    constexpr std::uint32_t kMagic = 0x504E3253; // 'S2NP'
+    constexpr std::uint32_t kVersion = 2;
+
+    constexpr std::uint32_t kNoString = 0xFFFFFFFF;
+    constexpr std::uint32_t kNoId = 0xFFFFFFFF; // the dump was made without -ids
+    constexpr std::uint16_t kNoSerializer = 0xFFFF;
+
+    enum class decoder_t : std::uint8_t {
+        kDefault = 0, // decoded purely from the field type
+        kNoScale, // raw 32-bit float
+        kQuantizedFloat, // bit_count bits spread over [min_value, max_value]
+        kCoord,
+        kNormal,
+        kFixed64,
+        kQAngle,
+        kQAnglePitchYaw,
+        kQAnglePrecise,
+        kSimulationTime,
+        kRuneTime,
+        kOtherEncoder, // MNetworkEncoder we do not know about, see field_t::encoder
+    };
+
+    // mirrors the engine's quantized float encode flags
+    enum encode_flags_t : std::uint32_t {
+        kRoundDown = 1 << 0,
+        kRoundUp = 1 << 1,
+        kEncodeZeroExactly = 1 << 2,
+        kEncodeIntegersExactly = 1 << 3,
+    };
+
+    enum field_flags_t : std::uint8_t {
+        kHasBitCount = 1 << 0,
+        kHasRange = 1 << 1,
+        kHasChangeCallback = 1 << 2,
+    };
+
+#pragma pack(push, 1)
+    struct header_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t class_count;
+        std::uint32_t field_count;
+        std::uint32_t serializer_count;
+        std::uint32_t strings_size;
+    };
+
+    struct class_t {
+        std::uint32_t id;
+        std::uint32_t name;
+        std::uint32_t first_field;
+        std::uint32_t field_count;
+    };
+
+    struct field_t {
+        std::uint32_t id;
+        std::uint32_t name;
+        std::uint32_t type_name;
+        std::uint32_t encoder; // kNoString when there is no MNetworkEncoder
+        std::int32_t offset;
+        std::int32_t bit_count; // 0 when there is no MNetworkBitCount
+        std::uint32_t encode_flags;
+        std::int32_t priority;
+        float min_value; // [0, 1] when there is no MNetworkMinValue/MaxValue, already adjusted for
+        float max_value; // kRoundDown/kRoundUp on quantized floats
+        float decode_scale; // (max_value - min_value) / ((1 << bit_count) - 1)
+        float encode_scale; // inverse of decode_scale
+        decoder_t decoder;
+        std::uint8_t flags;
+        std::uint16_t serializer; // index into the serializer table or kNoSerializer
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(header_t) == 24);
+    static_assert(sizeof(class_t) == 16);
+    static_assert(sizeof(field_t) == 52);
+} // namespace netplan
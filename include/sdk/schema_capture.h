@@ -0,0 +1,30 @@
+#pragma once
+#include "sdk/schema_index.h"
+#include "tools/capture.h"
+
+// Capture plans for the networked state of a class, straight from the schema index:
+//
+//     const schema_index::view_t view(index->GetIndex());
+//     const auto plan = schema_capture::compile_networked(view, view.find_class(FNV64("C_CSPlayerPawn")));
+//
+//     std::vector<std::uint8_t> frame(pawns.size() * plan.m_record_size);
+//     capture::capture(plan, pawns, frame.data(), 0);
+//
+// The index already has the fields of the base classes at their final offsets, so the plan covers the whole
+// object. Fields of unknown size aren't captured. Gaps of up to `max_gap` bytes between networked fields are
+// copied along, including any non-networked members in them, pass 0 to capture the networked bytes only.
+namespace schema_capture {
+    inline capture::plan_t compile_networked(const schema_index::view_t& view, const schema_index::class_t* class_entry,
+                                             const std::uint32_t max_gap = capture::kDefaultMaxGap) {
+        std::vector<capture::field_t> fields;
+        if (class_entry != nullptr) {
+            const auto first = view.fields() + class_entry->first_field;
+            for (auto field = first; field != first + class_entry->field_count; ++field) {
+                if ((field->flags & schema_index::kNetworked) && field->offset >= 0 && field->size > 0)
+                    fields.push_back({static_cast<std::uint32_t>(field->offset), static_cast<std::uint32_t>(field->size)});
+            }
+        }
+
+        return capture::compile(std::move(fields), max_gap);
+    }
+} // namespace schema_capture
@@ -0,0 +1,147 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include "tools/fnv.h"
+
+// In-process schema index, shared with other plugins through CreateInterface:
+//
+//     auto index = static_cast<ISchemaGenIndex*>(CreateInterface(SCHEMAGEN_INDEX_INTERFACE_VERSION, nullptr));
+//     const schema_index::view_t view(index->GetIndex());
+//     const auto offset = view.find_field_offset(FNV64("C_CSPlayerPawn"), FNV64("m_iHealth"));
+//
+// The index is one immutable blob: a header_t followed by header_t::class_count class_t entries sorted by
+// name hash, header_t::field_count field_t entries and header_t::strings_size bytes of null-terminated
+// strings. Every class owns a contiguous run of fields sorted by name hash, including the fields of its
+// base classes with their offsets already adjusted, so a lookup is two binary searches over integers.
+//
+// A published blob is never modified or freed, any number of threads can read it without synchronisation.
+#define SCHEMAGEN_INDEX_INTERFACE_VERSION "SchemaGenIndex001"
+
+namespace schema_index {
+    constexpr std::uint32_t kMagic = 0x58493253; // 'S2IX'
+    constexpr std::uint32_t kVersion = 1;
+
+    constexpr std::uint32_t kNoString = 0xFFFFFFFF;
+    constexpr std::uint32_t kNoClass = 0xFFFFFFFF;
+    constexpr std::int32_t kNotFound = -1;
+
+    enum field_flags_t : std::uint16_t {
+        kNetworked = 1 << 0,
+        kHasBitCount = 1 << 1,
+        kHasChangeCallback = 1 << 2,
+        kInherited = 1 << 3, // declared by a base class
+    };
+
+#pragma pack(push, 1)
+    struct header_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t class_count;
+        std::uint32_t field_count;
+        std::uint32_t strings_size;
+        std::uint32_t reserved;
+    };
+
+    struct class_t {
+        std::uint64_t hash; // fnv64 of the name
+        std::uint32_t name;
+        std::uint32_t scope; // scope name without the .dll extension, a class can be declared by several scopes
+        std::int32_t size;
+        std::uint32_t base_class; // index of the first base class, kNoClass if there isn't one
+        std::uint32_t first_field;
+        std::uint32_t field_count;
+    };
+
+    struct field_t {
+        std::uint64_t hash; // fnv64 of the name
+        std::uint32_t name;
+        std::uint32_t type_name;
+        std::int32_t offset; // from the start of the class the field was looked up in
+        std::int32_t size;
+        std::uint32_t encoder; // MNetworkEncoder, kNoString if there isn't one
+        std::uint16_t bit_count; // MNetworkBitCount, valid if flags has kHasBitCount
+        std::uint16_t flags;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(header_t) == 24);
+    static_assert(sizeof(class_t) == 32);
+    static_assert(sizeof(field_t) == 32);
+
+    // @note: read-only accessors over a published blob, header-only so consumers don't pay for a virtual call per lookup
+    //
+    struct view_t {
+        explicit view_t(const header_t* header): _header(header) { }
+
+        [[nodiscard]] bool valid() const {
+            return _header != nullptr && _header->magic == kMagic && _header->version == kVersion;
+        }
+
+        [[nodiscard]] const header_t* header() const {
+            return _header;
+        }
+
+        [[nodiscard]] const class_t* classes() const {
+            return reinterpret_cast<const class_t*>(_header + 1);
+        }
+
+        [[nodiscard]] const field_t* fields() const {
+            return reinterpret_cast<const field_t*>(classes() + _header->class_count);
+        }
+
+        [[nodiscard]] const char* string(const std::uint32_t offset) const {
+            return offset == kNoString ? nullptr : reinterpret_cast<const char*>(fields() + _header->field_count) + offset;
+        }
+
+        // @note: `scope` disambiguates classes declared by several scopes, null picks any of them
+        //
+        [[nodiscard]] const class_t* find_class(const std::uint64_t hash, const char* scope = nullptr) const {
+            const auto begin = classes();
+            for (auto it = lower_bound(begin, _header->class_count, hash); it != begin + _header->class_count && it->hash == hash; ++it) {
+                if (scope == nullptr || std::strcmp(string(it->scope), scope) == 0)
+                    return it;
+            }
+
+            return nullptr;
+        }
+
+        [[nodiscard]] const field_t* find_field(const class_t* class_entry, const std::uint64_t hash) const {
+            if (class_entry == nullptr)
+                return nullptr;
+
+            const auto begin = fields() + class_entry->first_field;
+            const auto it = lower_bound(begin, class_entry->field_count, hash);
+            return it != begin + class_entry->field_count && it->hash == hash ? it : nullptr;
+        }
+
+        [[nodiscard]] std::int32_t find_field_offset(const std::uint64_t class_hash, const std::uint64_t field_hash) const {
+            const auto field = find_field(find_class(class_hash), field_hash);
+            return field != nullptr ? field->offset : kNotFound;
+        }
+    private:
+        template <typename T>
+        static const T* lower_bound(const T* first, std::uint32_t count, const std::uint64_t hash) {
+            while (count > 0) {
+                const auto half = count / 2;
+                if (first[half].hash < hash) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+
+            return first;
+        }
+
+        const header_t* _header = nullptr;
+    };
+} // namespace schema_index
+
+class ISchemaGenIndex {
+public:
+    // @note: never null once the interface has been handed out, the returned blob stays valid for the lifetime of
+    // the process even if a newer one gets published by schema_index_rebuild
+    //
+    virtual const schema_index::header_t* GetIndex() = 0;
+};
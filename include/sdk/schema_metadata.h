@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "schemasystem/schemasystem.h"
+
+namespace sdk {
+    struct CSchemaVarName {
+        const char* m_name;
+        const char* m_type;
+    };
+
+    struct CSchemaNetworkValue {
+        union {
+            const char* m_p_sz_value;
+            int m_n_value;
+            float m_f_value;
+            std::uintptr_t m_p_value;
+            CSchemaVarName m_var_value;
+            std::array<char, 32> m_sz_value;
+        };
+    };
+
+    // @note: returns the value of the first metadata entry called `name`, or nullptr if there is none
+    //
+    inline const CSchemaNetworkValue* FindMetadata(const SchemaMetadataEntryData_t* entries, const int count, const char* name) {
+        for (int i = 0; i < count; ++i) {
+            if (strcmp(entries[i].m_pszName, name) == 0)
+                return static_cast<const CSchemaNetworkValue*>(entries[i].m_pData);
+        }
+
+        return nullptr;
+    }
+
+    inline bool HasMetadata(const SchemaMetadataEntryData_t* entries, const int count, const char* name) {
+        for (int i = 0; i < count; ++i) {
+            if (strcmp(entries[i].m_pszName, name) == 0)
+                return true;
+        }
+
+        return false;
+    }
+} // namespace sdk
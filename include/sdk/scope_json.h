@@ -0,0 +1,71 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include "sdk/dump_index.h"
+#include "tools/codegen.h"
+
+// How a <scope>.json is put together from the rendered `"Name": { ... },` fragments of its types.
+//
+// Rendering needs the schema system, putting fragments together doesn't, so everything that only rearranges
+// fragments (shards, the archive, the ndjson records) can be driven by stand-in fragments outside of the game.
+namespace sdk {
+    // @note: a single rendered "Name": { ... }, entry of a scope file
+    //
+    struct type_fragment_t {
+        const char* m_name = nullptr;
+        std::string m_text = "";
+    };
+
+    struct rendered_scope_t {
+        std::string m_name = "";
+        std::vector<type_fragment_t> m_enums = {};
+        std::vector<type_fragment_t> m_classes = {}; // in dependency order
+    };
+
+    // @note: `write_header` can add extra keys in front of "enums", `index_entries` receives where every fragment ended up
+    //
+    inline std::string AssembleScopeJson(const std::vector<const type_fragment_t*>& enums, const std::vector<const type_fragment_t*>& classes,
+                                         const std::function<void(codegen::generator_t::self_ref)>& write_header = nullptr,
+                                         std::vector<dump_index::entry_t>* index_entries = nullptr) {
+        auto builder = codegen::get();
+
+        // @note: a fragment is `"Name": {...},` indented, the entry covers it from the quote to the closing brace
+        //
+        const auto append_fragment = [&](const type_fragment_t* fragment, const dump_index::kind_t kind) {
+            if (index_entries != nullptr)
+                index_entries->push_back(dump_index::make_entry(fragment->m_name, fragment->m_text, builder.size(), kind));
+
+            builder.append(fragment->m_text);
+        };
+
+        builder.begin_json_object();
+
+        if (write_header)
+            write_header(builder);
+
+        builder.json_key("enums").begin_json_object_value();
+        for (const auto fragment : enums)
+            append_fragment(fragment, dump_index::kind_t::kEnum);
+        builder.end_json_object();
+
+        builder.json_key("classes").begin_json_object_value();
+        for (const auto fragment : classes)
+            append_fragment(fragment, dump_index::kind_t::kClass);
+        builder.end_json_object();
+
+        builder.end_json_object(false);
+
+        return builder.str();
+    }
+
+    inline std::string AssembleScopeJson(const rendered_scope_t& rendered, std::vector<dump_index::entry_t>* index_entries = nullptr) {
+        std::vector<const type_fragment_t*> enums, classes;
+        for (const auto& fragment : rendered.m_enums)
+            enums.push_back(&fragment);
+        for (const auto& fragment : rendered.m_classes)
+            classes.push_back(&fragment);
+
+        return AssembleScopeJson(enums, classes, nullptr, index_entries);
+    }
+} // namespace sdk
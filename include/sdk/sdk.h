@@ -15,7 +15,157 @@
 
 #include <sdk/interfaceregs.h>
 #include "schemasystem/schemasystem.h"
+#include "sdk/archive_store.h"
+#include "sdk/dump_index.h"
+#include "sdk/scope_json.h"
+#include "sdk/size_report.h"
+#include "tools/background_job.h"
+#include "tools/id_registry.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace sdk {
-    void GenerateTypeScopeSdk(CSchemaSystemTypeScope* current, const char* outDirName);
+    enum class shard_mode_t : std::uint8_t {
+        kNone = 0, // one <scope>.json
+        kPrefix, // one shard per lowercase name prefix of m_shard_parameter characters
+        kSize, // consecutive types packed into shards of at most m_shard_parameter bytes
+        kDependencies, // types split along the dependency graph into waves of up to m_shard_parameter independent shards, see tools/partition.h
+    };
+
+    enum class layout_report_t : std::uint8_t {
+        kNone = 0,
+        kAll, // every class
+        kNetworked, // classes with at least one networked field, their own or inherited
+    };
+
+    // @note: optional outputs of schema_dump_all, see ParseDumpOption for the command line syntax
+    //
+    struct dump_options_t {
+        bool m_network_decode_plans = false; // -netplan: write <scope>.netplan.bin next to the json
+        std::vector<std::string> m_root_patterns = {}; // -roots=A,B*: only dump types reachable from these
+        std::string m_id_registry_path = ""; // -ids=<file>: assign persistent ids to every type and emit them
+        bool m_lookup_tables = false; // -lookup: write <scope>_lookup.hpp with perfect hash tables of class/field names
+        bool m_enum_tables = false; // -enums: write <scope>.enums.bin and <scope>_enums.hpp with value to name tables of every enum
+        layout_report_t m_layout_report = layout_report_t::kNone; // -layout[=networked]: write <scope>.layout.json with field offsets, padding and cache lines
+        bool m_size_report = false; // -sizes: write <scope>.sizes.json with the classes, enums, metadata and field types that take the most bytes
+        bool m_dump_index = false; // -idx: write <scope>.idx with the byte range of every class and enum in <scope>.json
+        bool m_deduplicate = false; // -dedup: write types shared by several scopes once, to _shared.json
+        bool m_async = false; // -async: snapshot on the calling thread, render and write on a worker thread
+        std::vector<std::string> m_scope_patterns = {}; // -scopes=client,*server: only visit these type scopes
+        std::vector<std::string> m_class_patterns = {}; // -classes=A,B*: only dump classes and enums with matching names
+        std::string m_shared_memory_name = ""; // -shm=<name>: publish the schema index in a named shared memory segment
+        shard_mode_t m_shard_mode = shard_mode_t::kNone; // -shards=prefix:<n>, size:<KiB> or deps:<n>: split every scope into <scope>/*.json
+        std::size_t m_shard_parameter = 0;
+        bool m_ndjson = false; // -ndjson: write <scope>.ndjson, one compact json record per enum and class and line, instead of <scope>.json
+        std::size_t m_compress_block_size = 0; // -compress[=<KiB>]: write <scope>.jsonlz, blocks of 64 KiB by default, instead of <scope>.json
+        std::string m_archive_build = ""; // -archive=<build>: store the json in the content addressed archive at <output path>, as <build>
+        std::uint32_t m_threads = 1; // -threads=<n>: scopes rendered and written in parallel, 0 uses every core
+    };
+
+    // @note: the types of a scope that are going to be dumped, taken up front so filters can
+    // drop types before anything gets rendered
+    //
+    struct scope_snapshot_t {
+        std::string m_name = ""; // scope name without the .dll extension
+        std::vector<CSchemaClassInfo*> m_classes = {};
+        std::vector<CSchemaEnumInfo*> m_enums = {};
+    };
+
+    // @note: shared between a background dump and the commands that report on / cancel it, counts scopes
+    //
+    using dump_progress_t = background_job::progress_t;
+
+    struct dedup_stats_t {
+        std::size_t m_shared_enums = 0;
+        std::size_t m_shared_classes = 0;
+        std::size_t m_bytes_written = 0;
+        std::size_t m_bytes_per_scope = 0; // what the same scopes take without -dedup
+    };
+
+    struct prune_stats_t {
+        std::size_t m_kept_classes = 0;
+        std::size_t m_pruned_classes = 0;
+        std::size_t m_kept_enums = 0;
+        std::size_t m_pruned_enums = 0;
+    };
+
+    // @note: parses a single `-name` or `-name=value` argument, returns false if it isn't a known option
+    //
+    bool ParseDumpOption(dump_options_t& options, std::string_view arg);
+
+    // @note: fields that are sent over the network, in declaration order
+    //
+    std::vector<const SchemaClassFieldData_t*> GetNetworkedFields(CSchemaClassInfo* class_info);
+
+    // @note: scope name without the .dll extension, e.g. `client` or `!GlobalTypes`
+    //
+    std::string GetTypeScopeName(CSchemaSystemTypeScope* current);
+
+    // @note: `name` with every run of characters that can't be in a C++ identifier replaced by '_', e.g. for `!GlobalTypes`
+    //
+    std::string GetIdentifierName(const std::string& name);
+
+    // @note: the value as the json has it, INT64_MAX stands for -1
+    //
+    std::int64_t GetEnumeratorValue(const SchemaEnumeratorInfoData_t& enumerator);
+
+    scope_snapshot_t SnapshotTypeScope(CSchemaSystemTypeScope* current);
+
+    // @note: keeps only the classes and enums whose name matches one of `patterns`
+    //
+    prune_stats_t FilterTypes(std::vector<scope_snapshot_t>& snapshots, const std::vector<std::string>& patterns);
+
+    // @note: drops every class/enum that can't be reached from a type matching `root_patterns`
+    // through base classes and the types of dumped fields
+    //
+    prune_stats_t PruneUnreachableTypes(std::vector<scope_snapshot_t>& snapshots, const std::vector<std::string>& root_patterns);
+
+    // @note: flattened, hash sorted index of every class and field, see sdk/schema_index.h for the layout
+    //
+    std::vector<std::uint8_t> BuildSchemaIndex(const std::vector<scope_snapshot_t>& snapshots);
+
+    // @note: queues every dumped class, field and enum in `registry`, returns how many new ids got assigned
+    //
+    std::size_t RegisterTypeIds(ids::registry_t& registry, const std::vector<scope_snapshot_t>& snapshots);
+
+    // @note: `sizes` receives how many bytes of the json went where, leave it null unless the report gets written
+    //
+    rendered_scope_t RenderTypeScope(const scope_snapshot_t& snapshot, const ids::registry_t* ids = nullptr, size_report_t* sizes = nullptr);
+
+    // @note: sorts `entries` and writes them as a sidecar of a `file_size` bytes json, see sdk/dump_index.h
+    //
+    void WriteDumpIndex(std::vector<dump_index::entry_t> entries, std::uint64_t file_size, const std::string& out_file_path);
+
+    // @note: compresses `text` into blocks of about `block_size` bytes that start at an entry of `index_entries` (in file order),
+    // see sdk/compressed_dump.h
+    //
+    void WriteCompressedJson(std::string_view text, const std::vector<dump_index::entry_t>& index_entries, std::size_t block_size,
+                             std::uint32_t threads, const std::string& out_file_path);
+
+    // @note: one `{"scope":..,"kind":"enum"|"class","name":..,<members of the definition>}` line per type, enums first
+    //
+    void WriteNdjsonScope(const rendered_scope_t& rendered, const std::string& out_file_path);
+
+    // @note: writes the types of a scope to <scope>/<shard>.json files and lists them in <scope>.manifest.json
+    //
+    void WriteShardedScope(const scope_snapshot_t& snapshot, const rendered_scope_t& rendered, const char* outDirName, const dump_options_t& options);
+
+    dedup_stats_t WriteDeduplicatedScopes(const std::vector<rendered_scope_t>& scopes, const char* outDirName, const dump_options_t& options);
+
+    // @note: everything but the json, i.e. the outputs enabled by -netplan/-lookup/-enums/-layout
+    //
+    void WriteScopeExtras(const scope_snapshot_t& snapshot, const char* outDirName, const dump_options_t& options, const ids::registry_t* ids = nullptr);
+
+    void GenerateTypeScopeSdk(const scope_snapshot_t& snapshot, const char* outDirName, const dump_options_t& options = {},
+                              const ids::registry_t* ids = nullptr);
+    void WriteNetworkDecodePlans(const scope_snapshot_t& snapshot, const std::string& out_file_path, const ids::registry_t* ids = nullptr);
+    void WriteLookupTables(const scope_snapshot_t& snapshot, const std::string& out_file_path, const ids::registry_t* ids = nullptr);
+    void WriteEnumTables(const scope_snapshot_t& snapshot, const std::string& out_binary_path, const std::string& out_header_path);
+    void WriteLayoutReport(const scope_snapshot_t& snapshot, const std::string& out_file_path, layout_report_t mode);
+    void WriteSizeReport(const size_report_t& report, const std::string& out_file_path);
 } // namespace sdk
@@ -0,0 +1,267 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sdk/dump_index.h"
+#include "sdk/scope_json.h"
+#include "tools/dump_reader.h"
+#include "tools/fnv.h"
+#include "tools/parallel.h"
+#include "tools/partition.h"
+
+// Splitting a rendered scope into <scope>/<shard>.json files listed in <scope>.manifest.json, see -shards.
+//
+// Every shard is a scope json of its own, AssembleScopeJson over a part of the fragments, and every fragment ends up
+// in exactly one shard. Only the dependency graph of -shards=deps needs the schema system, it's passed in as a
+// partition::graph_t over the enums followed by the classes of the scope.
+namespace sdk {
+    struct shard_t {
+        std::string m_name = "";
+        std::vector<const type_fragment_t*> m_enums = {};
+        std::vector<const type_fragment_t*> m_classes = {};
+        std::vector<std::size_t> m_dependencies = {}; // shards that hold types this one needs, -shards=deps only
+        std::size_t m_size = 0;
+        std::uint64_t m_checksum = 0;
+    };
+
+    struct partition_stats_t {
+        std::size_t m_components = 0;
+        std::size_t m_waves = 0;
+        std::size_t m_total_size = 0;
+        std::size_t m_critical_path = 0;
+        double m_balance = 0.0;
+    };
+
+    // @note: lowercase, so shards don't collide on case insensitive file systems
+    //
+    inline std::string GetPrefixShardName(const char* type_name, const std::size_t length) {
+        std::string result;
+        for (std::size_t i = 0; i < length && type_name[i] != '\0'; ++i) {
+            const auto c = static_cast<unsigned char>(type_name[i]);
+            result.push_back(std::isalnum(c) ? static_cast<char>(std::tolower(c)) : '_');
+        }
+
+        // @note: device names can't be used as file names on windows, whatever the extension
+        //
+        constexpr std::array reserved_names = {"con", "prn", "aux", "nul"};
+        const auto is_device_port = result.size() == 4 && (result.starts_with("com") || result.starts_with("lpt")) && std::isdigit(result[3]);
+        if (is_device_port || std::find(reserved_names.begin(), reserved_names.end(), result) != reserved_names.end())
+            result.push_back('_');
+
+        return result;
+    }
+
+    inline std::vector<shard_t> SplitByPrefix(const rendered_scope_t& rendered, const std::size_t length) {
+        std::map<std::string, shard_t> shards;
+        for (const auto& fragment : rendered.m_enums)
+            shards[GetPrefixShardName(fragment.m_name, length)].m_enums.push_back(&fragment);
+        for (const auto& fragment : rendered.m_classes)
+            shards[GetPrefixShardName(fragment.m_name, length)].m_classes.push_back(&fragment);
+
+        std::vector<shard_t> result;
+        for (auto& [name, shard] : shards) {
+            shard.m_name = name;
+            result.push_back(std::move(shard));
+        }
+
+        return result;
+    }
+
+    // @note: keeps the dependency order of the classes, a type bigger than the budget gets a shard of its own
+    //
+    inline std::vector<shard_t> SplitBySize(const rendered_scope_t& rendered, const std::size_t budget) {
+        std::vector<shard_t> result;
+        std::size_t current_size = 0;
+
+        const auto add = [&](const type_fragment_t& fragment, const bool is_class) {
+            if (result.empty() || (current_size != 0 && current_size + fragment.m_text.size() > budget)) {
+                result.emplace_back().m_name = std::format("{:04}", result.size());
+                current_size = 0;
+            }
+
+            (is_class ? result.back().m_classes : result.back().m_enums).push_back(&fragment);
+            current_size += fragment.m_text.size();
+        };
+
+        for (const auto& fragment : rendered.m_enums)
+            add(fragment, false);
+        for (const auto& fragment : rendered.m_classes)
+            add(fragment, true);
+
+        return result;
+    }
+
+    // @note: the nodes of `graph` are the enums followed by the classes of `rendered`, weighed by their size
+    //
+    inline std::vector<shard_t> SplitByPartitions(const rendered_scope_t& rendered, const partition::graph_t& graph, const std::size_t width,
+                                                  partition_stats_t& stats) {
+        const auto partition_width = static_cast<std::uint32_t>(std::min<std::size_t>(width, std::numeric_limits<std::uint32_t>::max()));
+        const auto partitions = partition::split(graph, partition_width);
+
+        stats.m_components = partitions.m_component_count;
+        stats.m_waves = partitions.m_wave_count;
+        stats.m_total_size = std::accumulate(partitions.m_weights.begin(), partitions.m_weights.end(), std::size_t{0});
+        stats.m_critical_path = partitions.m_critical_path;
+        stats.m_balance = partitions.balance(partition_width);
+
+        std::vector<shard_t> result(partitions.m_weights.size());
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i].m_name = std::format("{:04}", i);
+            result[i].m_dependencies.assign(partitions.m_dependencies[i].begin(), partitions.m_dependencies[i].end());
+        }
+
+        // @note: fragments are visited in rendered order, so every shard keeps the dependency order of the classes
+        //
+        for (std::size_t node = 0; node < rendered.m_enums.size() + rendered.m_classes.size(); ++node) {
+            auto& shard = result[partitions.m_partition[node]];
+            if (node < rendered.m_enums.size())
+                shard.m_enums.push_back(&rendered.m_enums[node]);
+            else
+                shard.m_classes.push_back(&rendered.m_classes[node - rendered.m_enums.size()]);
+        }
+
+        return result;
+    }
+
+    // @note: relative to the output directory, as listed in the manifest
+    //
+    inline std::string GetShardFile(const std::string_view scope_name, const shard_t& shard) {
+        return std::format("{}/{}.json", scope_name, shard.m_name);
+    }
+
+    // @note: `<scope>/<name>.json` with a plain file name, i.e. something GetShardFile could have returned for this scope
+    //
+    inline bool IsShardFile(const std::string_view scope_name, const std::string_view file) {
+        constexpr std::string_view kExtension = ".json";
+        if (file.size() <= scope_name.size() + 1 + kExtension.size() || !file.starts_with(scope_name) || file[scope_name.size()] != '/' ||
+            !file.ends_with(kExtension))
+            return false;
+
+        const auto name = file.substr(scope_name.size() + 1, file.size() - scope_name.size() - 1 - kExtension.size());
+        return name != "." && name != ".." && name.find_first_of("/\\:") == std::string_view::npos;
+    }
+
+    // @note: only removes what the previous manifest says it wrote, the directory may hold other files. a manifest is text
+    // anyone can edit, so files outside of the scope's own directory are never touched
+    //
+    inline void RemovePreviousShards(const std::filesystem::path& manifest_path, const std::filesystem::path& out_dir, const std::string_view scope_name) {
+        if (!std::filesystem::exists(manifest_path))
+            return;
+
+        std::ifstream f(manifest_path, std::ios::in | std::ios::binary);
+        const std::string text((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        f.close();
+
+        try {
+            const auto manifest = dump_reader::parser_t(text).parse();
+            const auto shards = manifest.find("shards");
+            if (shards == nullptr)
+                return;
+
+            for (const auto& shard : shards->items()) {
+                const auto file = shard.find("file");
+                if (file == nullptr || !IsShardFile(scope_name, file->as_string()))
+                    continue;
+
+                const auto path = out_dir / file->as_string();
+                std::filesystem::remove(path);
+                std::filesystem::remove(std::filesystem::path(path).replace_extension(".idx"));
+            }
+        } catch (std::runtime_error&) {
+            // @note: not a manifest we wrote, leave everything alone
+            //
+        }
+    }
+
+    // @note: writes the shards and <scope>.manifest.json to `out_dir`, `partitions` is null unless the shards come from
+    // SplitByPartitions. `dump_index` adds a <shard>.idx next to every shard
+    //
+    inline void WriteShards(const rendered_scope_t& rendered, std::vector<shard_t>& shards, const std::filesystem::path& out_dir,
+                            const partition_stats_t* partitions, const bool dump_index, const std::uint32_t threads) {
+        const auto manifest_path = out_dir / (rendered.m_name + ".manifest.json");
+        RemovePreviousShards(manifest_path, out_dir, rendered.m_name);
+
+        const auto shard_dir = out_dir / rendered.m_name;
+        if (!std::filesystem::exists(shard_dir))
+            std::filesystem::create_directories(shard_dir);
+
+        parallel::for_each(shards.size(), threads, [&](const std::size_t i) {
+            auto& shard = shards[i];
+
+            std::vector<dump_index::entry_t> index_entries;
+            const auto text = AssembleScopeJson(shard.m_enums, shard.m_classes, nullptr, dump_index ? &index_entries : nullptr);
+            shard.m_size = text.size();
+            shard.m_checksum = fnv64::hash_runtime_data(text.data(), text.size());
+
+            const auto path = out_dir / GetShardFile(rendered.m_name, shard);
+            std::ofstream f(path, std::ios::out | std::ios::binary);
+            f << text;
+            f.close();
+
+            if (dump_index) {
+                const auto data = dump_index::serialize(std::move(index_entries), text.size());
+                std::ofstream index(std::filesystem::path(path).replace_extension(".idx"), std::ios::out | std::ios::binary);
+                index.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            }
+        });
+
+        auto builder = codegen::get();
+        builder.begin_json_object();
+        builder.json_key("scope").json_string(rendered.m_name);
+
+        if (partitions != nullptr) {
+            builder.json_key("partitions").begin_json_object_value();
+            builder.json_key("count").json_literal(shards.size());
+            builder.json_key("components").json_literal(partitions->m_components);
+            builder.json_key("waves").json_literal(partitions->m_waves);
+            builder.json_key("totalSize").json_literal(partitions->m_total_size);
+            builder.json_key("criticalPath").json_literal(partitions->m_critical_path);
+            builder.json_key("balance").json_literal(std::format("{:.3f}", partitions->m_balance));
+            builder.end_json_object();
+        }
+
+        builder.json_key("shards").begin_json_array_value();
+
+        for (const auto& shard : shards) {
+            builder.begin_json_object();
+            builder.json_key("file").json_string(GetShardFile(rendered.m_name, shard));
+            builder.json_key("size").json_literal(shard.m_size);
+            builder.json_key("checksum").json_string(std::format("{:016x}", shard.m_checksum));
+
+            if (partitions != nullptr) {
+                builder.json_key("dependencies").begin_json_array_value();
+                for (const auto dependency : shard.m_dependencies)
+                    builder.json_string_element(GetShardFile(rendered.m_name, shards[dependency]));
+                builder.end_json_array();
+            }
+
+            builder.json_key("enums").begin_json_array_value();
+            for (const auto fragment : shard.m_enums)
+                builder.json_string_element(fragment->m_name);
+            builder.end_json_array();
+
+            builder.json_key("classes").begin_json_array_value();
+            for (const auto fragment : shard.m_classes)
+                builder.json_string_element(fragment->m_name);
+            builder.end_json_array();
+
+            builder.end_json_object();
+        }
+
+        builder.end_json_array();
+        builder.end_json_object(false);
+
+        std::ofstream f(manifest_path, std::ios::out | std::ios::binary);
+        f << builder.str();
+        f.close();
+    }
+} // namespace sdk
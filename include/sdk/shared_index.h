@@ -0,0 +1,284 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "sdk/schema_index.h"
+#include "tools/shared_memory.h"
+
+// Publication of the schema index (see sdk/schema_index.h) in a named shared memory segment, so local tools can
+// query it without a dump to parse. `schema_dump_all <path> -shm=<name>` creates the segment and republishes after
+// every dump.
+//
+// Lookups don't run on the shared pages in place: a reader takes one private copy of the live slot per published
+// generation and runs every lookup on that copy. A lookup in place could read a slot the writer is overwriting and
+// follow a torn offset before the seqlock check after it notices. Copying once per generation and validating the
+// copy makes every lookup safe, at the cost of one memcpy of the index whenever a new one is published.
+//
+// The segment is a segment_header_t followed by two slots of segment_header_t::slot_capacity bytes. A new index
+// is copied into the slot that isn't live, then `generation` is bumped and its low bit selects the live slot.
+// Every slot has its own seqlock counter (odd while the slot is being written). A reader copies the live slot out
+// when the generation changed, retries when the counter moved while it was copying and validates the copy before
+// running any lookup on it, so lookups never see torn or out of bounds data.
+//
+// The segment never changes its size once created, readers with it mapped would fault past the end of a shrunk
+// one. A later writer reuses the slots it finds, an index that outgrows them has to go to a segment of a new name.
+//
+//     shared_index::reader_t reader("cs2schemagen");
+//     const auto offset = reader.read([](const schema_index::view_t& view) {
+//         return view.find_field_offset(FNV64("C_CSPlayerPawn"), FNV64("m_iHealth"));
+//     });
+namespace shared_index {
+    constexpr std::uint32_t kMagic = 0x4D483253; // 'S2HM'
+    constexpr std::uint32_t kVersion = 1;
+    constexpr std::size_t kSlotCount = 2;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "seqlock counters have to be address free");
+
+    struct segment_header_t {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t slot_capacity;
+        std::atomic<std::uint64_t> generation; // 0 until the first index is published
+        std::atomic<std::uint64_t> sequence[kSlotCount];
+        std::atomic<std::uint64_t> size[kSlotCount];
+    };
+
+    constexpr std::size_t kSlotsOffset = (sizeof(segment_header_t) + 63) & ~std::size_t{63};
+
+    struct writer_t {
+        // @note: `slot_capacity` sizes a new segment, size it for future indices too. an existing segment keeps its
+        // own slot capacity
+        //
+        writer_t(const std::string_view name, const std::size_t slot_capacity):
+            _name(name), _mapping(shared_memory::mapping_t::create(name, kSlotsOffset + slot_capacity * kSlotCount)) {
+            if (_mapping.size() < kSlotsOffset)
+                throw std::runtime_error(std::format("{} : Segment '{}' of {} bytes is too small", __FUNCTION__, name, _mapping.size()));
+
+            const auto header = get_header();
+            if (header->magic == kMagic && header->version == kVersion) {
+                if (kSlotsOffset + header->slot_capacity * kSlotCount > _mapping.size())
+                    throw std::runtime_error(std::format("{} : Segment '{}' is corrupt, its slots don't fit its {} bytes", __FUNCTION__, name, _mapping.size()));
+
+                // @note: reusing a segment from a previous writer, keep its generation going. a writer that died inside
+                // publish() left its slot odd, readers would wait for it and the next publish would make it even early
+                //
+                for (auto& sequence : header->sequence) {
+                    if (const auto value = sequence.load(std::memory_order_relaxed); value & 1)
+                        sequence.store(value + 1, std::memory_order_release);
+                }
+
+                return;
+            }
+
+            if (_mapping.size() < kSlotsOffset + slot_capacity * kSlotCount)
+                throw std::runtime_error(std::format("{} : Segment '{}' already exists with {} bytes, it can't be resized", __FUNCTION__, name, _mapping.size()));
+
+            header->version = kVersion;
+            header->slot_capacity = slot_capacity;
+            header->generation.store(0, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < kSlotCount; ++i) {
+                header->sequence[i].store(0, std::memory_order_relaxed);
+                header->size[i].store(0, std::memory_order_relaxed);
+            }
+
+            // @note: readers only look past the magic once it is there
+            //
+            std::atomic_thread_fence(std::memory_order_release);
+            header->magic = kMagic;
+        }
+
+        // @note: returns the new generation
+        //
+        std::uint64_t publish(const std::vector<std::uint8_t>& index) {
+            const auto header = get_header();
+            if (index.size() > header->slot_capacity)
+                throw std::runtime_error(std::format("{} : Index of {} bytes doesn't fit the {} byte slots of '{}', publish it under another name",
+                                                     __FUNCTION__, index.size(), header->slot_capacity, _name));
+
+            const auto generation = header->generation.load(std::memory_order_relaxed) + 1;
+            const auto slot = generation % kSlotCount;
+
+            auto& sequence = header->sequence[slot];
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::memcpy(get_slot(slot), index.data(), index.size());
+            header->size[slot].store(index.size(), std::memory_order_relaxed);
+
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            header->generation.store(generation, std::memory_order_release);
+            return generation;
+        }
+
+        [[nodiscard]] std::size_t slot_capacity() const {
+            return get_header()->slot_capacity;
+        }
+    private:
+        [[nodiscard]] segment_header_t* get_header() const {
+            return static_cast<segment_header_t*>(_mapping.data());
+        }
+
+        [[nodiscard]] std::uint8_t* get_slot(const std::size_t slot) const {
+            return static_cast<std::uint8_t*>(_mapping.data()) + kSlotsOffset + slot * get_header()->slot_capacity;
+        }
+
+        std::string _name;
+        shared_memory::mapping_t _mapping;
+    };
+
+    struct reader_t {
+        explicit reader_t(const std::string_view name): _name(name) { }
+
+        // @note: the segment can be created after the reader, every call retries attaching until it succeeds
+        //
+        bool attach() {
+            if (_mapping.is_open())
+                return true;
+
+            auto mapping = shared_memory::mapping_t::open(_name);
+            if (!mapping.is_open() || mapping.size() < kSlotsOffset)
+                return false;
+
+            const auto header = static_cast<const segment_header_t*>(mapping.data());
+            if (header->magic != kMagic || header->version != kVersion)
+                return false;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (mapping.size() < kSlotsOffset + header->slot_capacity * kSlotCount)
+                return false;
+
+            _mapping = std::move(mapping);
+            return true;
+        }
+
+        // @note: 0 if nothing got published yet
+        //
+        [[nodiscard]] std::uint64_t generation() {
+            return attach() ? get_header()->generation.load(std::memory_order_acquire) : 0;
+        }
+
+        // @note: calls `fn(const schema_index::view_t&)` on a private copy of the live index and returns what it
+        // returns. the copy is only refreshed when a new generation got published, pointers into the view stay
+        // valid until then. if a writer stays in the middle of a publish the previous copy is used.
+        // returns nullopt if there is no segment, nothing was published yet or the live index is invalid.
+        // a reader_t isn't thread safe, every thread needs its own
+        //
+        template <typename Fn>
+        auto read(Fn&& fn) -> std::optional<decltype(fn(std::declval<const schema_index::view_t&>()))> {
+            if (!update())
+                return std::nullopt;
+
+            return fn(schema_index::view_t(reinterpret_cast<const schema_index::header_t*>(_index.data())));
+        }
+    private:
+        // @note: how often a read tries to copy a slot that is being written, yielding in between
+        //
+        static constexpr std::size_t kReadAttempts = 1000;
+
+        [[nodiscard]] const segment_header_t* get_header() const {
+            return static_cast<const segment_header_t*>(_mapping.data());
+        }
+
+        bool update() {
+            if (!attach())
+                return false;
+
+            const auto header = get_header();
+            for (std::size_t attempt = 0; attempt < kReadAttempts; ++attempt) {
+                if (attempt > 0)
+                    std::this_thread::yield();
+
+                const auto generation = header->generation.load(std::memory_order_acquire);
+                if (generation == 0)
+                    return false;
+
+                if (generation == _generation)
+                    return true;
+
+                const auto slot = generation % kSlotCount;
+                const auto before = header->sequence[slot].load(std::memory_order_acquire);
+                if (before & 1)
+                    continue;
+
+                const auto slot_capacity = header->slot_capacity;
+                const auto size = header->size[slot].load(std::memory_order_relaxed);
+                if (kSlotsOffset + slot_capacity * kSlotCount > _mapping.size())
+                    return false;
+
+                if (size <= slot_capacity) {
+                    _copy.resize(size);
+                    std::memcpy(_copy.data(), static_cast<const std::uint8_t*>(_mapping.data()) + kSlotsOffset + slot * slot_capacity, size);
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (header->sequence[slot].load(std::memory_order_relaxed) != before)
+                    continue;
+
+                if (size > slot_capacity || !validate(_copy))
+                    return false; // @note: consistent but not an index we understand
+
+                std::swap(_index, _copy);
+                _generation = generation;
+                return true;
+            }
+
+            return _generation != 0;
+        }
+
+        // @note: a corrupt index would send lookups outside of the copy, check every count and offset they follow
+        //
+        [[nodiscard]] static bool validate(const std::vector<std::uint8_t>& data) {
+            if (data.size() < sizeof(schema_index::header_t))
+                return false;
+
+            const schema_index::view_t view(reinterpret_cast<const schema_index::header_t*>(data.data()));
+            if (!view.valid())
+                return false;
+
+            const auto header = view.header();
+            const auto required = sizeof(schema_index::header_t) + std::uint64_t{header->class_count} * sizeof(schema_index::class_t) +
+                                  std::uint64_t{header->field_count} * sizeof(schema_index::field_t) + header->strings_size;
+            if (required > data.size())
+                return false;
+
+            // @note: a terminated string table keeps every string that starts inside of it inside of it
+            //
+            const auto strings_size = header->strings_size;
+            if (strings_size > 0 && data[required - 1] != '\0')
+                return false;
+
+            const auto is_string = [strings_size](const std::uint32_t offset, const bool optional) {
+                return offset < strings_size || (optional && offset == schema_index::kNoString);
+            };
+
+            for (std::uint32_t i = 0; i < header->class_count; ++i) {
+                const auto& class_entry = view.classes()[i];
+                if (!is_string(class_entry.name, false) || !is_string(class_entry.scope, false) ||
+                    (class_entry.base_class != schema_index::kNoClass && class_entry.base_class >= header->class_count) ||
+                    class_entry.first_field > header->field_count || class_entry.field_count > header->field_count - class_entry.first_field)
+                    return false;
+            }
+
+            for (std::uint32_t i = 0; i < header->field_count; ++i) {
+                const auto& field = view.fields()[i];
+                if (!is_string(field.name, false) || !is_string(field.type_name, false) || !is_string(field.encoder, true))
+                    return false;
+            }
+
+            return true;
+        }
+
+        std::string _name;
+        shared_memory::mapping_t _mapping;
+        std::uint64_t _generation = 0; // of _index, 0 until the first copy
+        std::vector<std::uint8_t> _index = {};
+        std::vector<std::uint8_t> _copy = {};
+    };
+} // namespace shared_index
@@ -0,0 +1,148 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sdk/scope_json.h"
+#include "tools/codegen.h"
+
+// What -sizes counts while a scope renders, and the <scope>.sizes.json it turns into.
+//
+// Counting only needs the builder and the rendered fragments, not the schema system, so the numbers can be checked
+// against the json they describe outside of the game.
+namespace sdk {
+    // @note: bytes of the json that went to one class, enum, metadata name or field type
+    //
+    struct size_entry_t {
+        const char* m_name = nullptr;
+        std::size_t m_bytes = 0;
+        std::size_t m_count = 0; // how often it got written
+    };
+
+    // @note: what the json of a scope spends its bytes on, see RenderTypeScope. metadata and field types are counted
+    // within the classes that hold them as well
+    //
+    struct size_report_t {
+        std::string m_name = "";
+        std::size_t m_total_size = 0; // every class and enum
+        std::vector<size_entry_t> m_classes = {};
+        std::vector<size_entry_t> m_enums = {};
+        std::unordered_map<std::uint64_t, size_entry_t> m_metadata = {}; // by whash64 of the name
+        std::unordered_map<std::uint64_t, size_entry_t> m_field_types = {}; // by whash64 of the name, the type with everything nested in it
+    };
+
+    // @note: -sizes measures with the position of the builder before and after an entry, that's two size() and a
+    // lookup in a table of a few hundred entries at most, cheap enough to leave on. without an entry it only writes
+    //
+    template <typename Fn>
+    void MeasureSize(codegen::generator_t::self_ref builder, size_entry_t* entry, const char* name, Fn&& write) {
+        if (entry == nullptr)
+            return write();
+
+        const auto begin = builder.size();
+        write();
+
+        entry->m_name = name;
+        entry->m_bytes += builder.size() - begin;
+        ++entry->m_count;
+    }
+
+    // @note: every fragment of `rendered` as it ends up in the <scope>.json
+    //
+    inline void AddFragmentSizes(size_report_t& report, const rendered_scope_t& rendered) {
+        report.m_name = rendered.m_name;
+        for (const auto& fragment : rendered.m_enums)
+            report.m_enums.push_back({fragment.m_name, fragment.m_text.size(), 1});
+        for (const auto& fragment : rendered.m_classes)
+            report.m_classes.push_back({fragment.m_name, fragment.m_text.size(), 1});
+
+        for (const auto& entry : report.m_enums)
+            report.m_total_size += entry.m_bytes;
+        for (const auto& entry : report.m_classes)
+            report.m_total_size += entry.m_bytes;
+    }
+
+    namespace detail {
+        constexpr std::size_t kTopSizeEntries = 20;
+
+        inline std::size_t GetTotalBytes(const std::vector<size_entry_t>& entries) {
+            std::size_t result = 0;
+            for (const auto& entry : entries)
+                result += entry.m_bytes;
+
+            return result;
+        }
+
+        // @note: most bytes first, then by name so the report doesn't change between runs
+        //
+        inline std::vector<size_entry_t> GetTopEntries(std::vector<size_entry_t> entries) {
+            const auto count = std::min(entries.size(), kTopSizeEntries);
+            std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), [](const size_entry_t& a, const size_entry_t& b) {
+                if (a.m_bytes != b.m_bytes)
+                    return a.m_bytes > b.m_bytes;
+
+                return std::strcmp(a.m_name, b.m_name) < 0;
+            });
+
+            entries.resize(count);
+            return entries;
+        }
+
+        inline std::vector<size_entry_t> GetEntries(const std::unordered_map<std::uint64_t, size_entry_t>& entries) {
+            std::vector<size_entry_t> result;
+            result.reserve(entries.size());
+            for (const auto& [hash, entry] : entries)
+                result.push_back(entry);
+
+            return result;
+        }
+
+        inline void WriteSizeCategory(codegen::generator_t::self_ref builder, const char* key, const std::vector<size_entry_t>& entries,
+                                      const std::size_t total_size, const bool write_count) {
+            const auto bytes = GetTotalBytes(entries);
+            const auto percent = [total_size](const std::size_t value) {
+                return std::format("{:.2f}", total_size != 0 ? 100.0 * static_cast<double>(value) / static_cast<double>(total_size) : 0.0);
+            };
+
+            builder.json_key(key).begin_json_object_value();
+            builder.json_key("count").json_literal(entries.size());
+            builder.json_key("bytes").json_literal(bytes);
+            builder.json_key("percent").json_literal(percent(bytes));
+
+            builder.json_key("top").begin_json_array_value();
+            for (const auto& entry : GetTopEntries(entries)) {
+                builder.begin_json_object();
+                builder.json_key("name").json_string(entry.m_name);
+                builder.json_key("bytes").json_literal(entry.m_bytes);
+                if (write_count)
+                    builder.json_key("count").json_literal(entry.m_count);
+                builder.json_key("percent").json_literal(percent(entry.m_bytes));
+                builder.end_json_object();
+            }
+            builder.end_json_array();
+
+            builder.end_json_object();
+        }
+    } // namespace detail
+
+    // @note: the <scope>.sizes.json of `report`, see WriteSizeReport
+    //
+    inline std::string RenderSizeReport(const size_report_t& report) {
+        auto builder = codegen::get();
+        builder.begin_json_object();
+
+        builder.json_key("scope").json_string(report.m_name);
+        builder.json_key("totalSize").json_literal(report.m_total_size);
+
+        detail::WriteSizeCategory(builder, "classes", report.m_classes, report.m_total_size, false);
+        detail::WriteSizeCategory(builder, "enums", report.m_enums, report.m_total_size, false);
+        detail::WriteSizeCategory(builder, "metadata", detail::GetEntries(report.m_metadata), report.m_total_size, true);
+        detail::WriteSizeCategory(builder, "fieldTypes", detail::GetEntries(report.m_field_types), report.m_total_size, true);
+
+        builder.end_json_object(false);
+        return builder.str();
+    }
+} // namespace sdk
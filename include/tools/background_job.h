@@ -0,0 +1,130 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// A single job at a time on a worker thread, with its progress, a cancellation flag and the error of the last run.
+//
+// The work and the reporting are passed in and nothing here touches the engine, so the logic can be driven by a
+// stand-in outside of the game. The work polls `m_cancel_requested` of its progress and returns early when it is set.
+namespace background_job {
+    struct progress_t {
+        std::atomic<std::size_t> m_done = 0;
+        std::atomic<std::size_t> m_total = 0;
+        std::atomic<bool> m_cancel_requested = false;
+    };
+
+    class job_t {
+    public:
+        using work_t = std::function<void(progress_t& progress)>;
+        using report_error_t = std::function<void(const std::string& error)>;
+
+        job_t() = default;
+        job_t(const job_t&) = delete;
+        job_t& operator=(const job_t&) = delete;
+
+        ~job_t() {
+            cancel();
+            wait();
+        }
+
+        // @note: returns false if the last job is still running. whatever `work` throws is caught on the worker, passed to
+        // `report_error` and kept for failure(), an exception that leaves the thread would terminate the process.
+        // throws if the thread can't be created, the job isn't running then
+        //
+        bool start(const std::size_t total, work_t work, report_error_t report_error) {
+            std::lock_guard lock(_mutex);
+            if (_running)
+                return false;
+
+            if (_thread.joinable())
+                _thread.join();
+
+            _progress.m_done = 0;
+            _progress.m_total = total;
+            _progress.m_cancel_requested = false;
+            set_failure("");
+            _start = std::chrono::steady_clock::now();
+
+            // @note: the worker clears the flag when it's done, so it has to be set before the thread exists. if creating
+            // the thread fails nothing would ever clear it and every later start would be refused
+            //
+            _running = true;
+            try {
+                _thread = std::thread([this, work = std::move(work), report_error = std::move(report_error)]() { run(work, report_error); });
+            } catch (...) {
+                _running = false;
+                throw;
+            }
+
+            return true;
+        }
+
+        // @note: returns false if there is nothing to cancel
+        //
+        bool cancel() {
+            if (!_running)
+                return false;
+
+            _progress.m_cancel_requested = true;
+            return true;
+        }
+
+        void wait() {
+            std::lock_guard lock(_mutex);
+            if (_thread.joinable())
+                _thread.join();
+        }
+
+        [[nodiscard]] bool running() const {
+            return _running;
+        }
+
+        [[nodiscard]] const progress_t& progress() const {
+            return _progress;
+        }
+
+        // @note: of the last job, empty if it didn't fail
+        //
+        [[nodiscard]] std::string failure() const {
+            std::lock_guard lock(_failure_mutex);
+            return _failure;
+        }
+
+        [[nodiscard]] long long elapsed_milliseconds() const {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _start).count();
+        }
+    private:
+        void run(const work_t& work, const report_error_t& report_error) {
+            try {
+                work(_progress);
+            } catch (std::exception& err) {
+                set_failure(err.what());
+                report_error(err.what());
+            } catch (...) {
+                set_failure("Unknown error");
+                report_error("Unknown error");
+            }
+
+            _running = false;
+        }
+
+        void set_failure(std::string error) {
+            std::lock_guard lock(_failure_mutex);
+            _failure = std::move(error);
+        }
+
+        std::mutex _mutex;
+        std::thread _thread;
+        std::atomic<bool> _running = false;
+        progress_t _progress;
+        std::chrono::steady_clock::time_point _start;
+        mutable std::mutex _failure_mutex;
+        std::string _failure;
+    };
+} // namespace background_job
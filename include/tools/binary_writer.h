@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace binary {
+    // @note: all binary outputs are little-endian, we only ever run on x64
+    //
+    struct writer_t {
+        using self_ref = std::add_lvalue_reference_t<writer_t>;
+    public:
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        self_ref write(const T& value) {
+            return write_bytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        self_ref write_array(const std::vector<T>& values) {
+            if (!values.empty())
+                write_bytes(values.data(), values.size() * sizeof(T));
+            return *this;
+        }
+
+        self_ref write_bytes(const void* data, const std::size_t size) {
+            const auto bytes = static_cast<const std::uint8_t*>(data);
+            _data.insert(_data.end(), bytes, bytes + size);
+            return *this;
+        }
+
+        // @note: overwrite an already written value, used to fix up headers once the payload is known
+        //
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        self_ref patch(const std::size_t offset, const T& value) {
+            std::memcpy(_data.data() + offset, &value, sizeof(T));
+            return *this;
+        }
+    public:
+        [[nodiscard]] std::size_t size() const {
+            return _data.size();
+        }
+
+        [[nodiscard]] const std::vector<std::uint8_t>& data() const {
+            return _data;
+        }
+    private:
+        std::vector<std::uint8_t> _data = {};
+    };
+
+    // @note: deduplicated blob of null-terminated strings, referenced by byte offset
+    //
+    struct string_table_t {
+        std::uint32_t add(const std::string_view str) {
+            if (const auto it = _offsets.find(std::string(str)); it != _offsets.end())
+                return it->second;
+
+            const auto offset = static_cast<std::uint32_t>(_data.size());
+            _data.append(str);
+            _data.push_back('\0');
+            _offsets.emplace(str, offset);
+            return offset;
+        }
+
+        [[nodiscard]] const std::string& data() const {
+            return _data;
+        }
+    private:
+        std::string _data = {};
+        std::unordered_map<std::string, std::uint32_t> _offsets = {};
+    };
+} // namespace binary
@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+#include "tools/parallel.h"
+
+// Bulk copies of the same fields out of many objects of one class, e.g. the networked state of every entity.
+//
+// compile() turns the fields into a plan of copy ranges: fields sorted by offset, overlapping or touching
+// fields merged, and gaps of up to `max_gap` bytes bridged, since copying a few more bytes is cheaper than
+// another call. A bridged gap isn't necessarily padding, it can hold members that weren't asked for (e.g. the
+// non-networked ones between networked fields), and their bytes end up in the frame too. A `max_gap` of 0
+// only copies the fields. capture() then runs the plan over a list of objects and writes a columnar frame:
+//
+//     range 0 of every object | range 1 of every object | ... | range n - 1 of every object
+//
+// so a frame of `count` objects is count * plan_t::m_record_size bytes, and the same field of consecutive
+// objects is stored next to each other, which is what deltas between frames and compression like.
+namespace capture {
+    constexpr std::uint32_t kDefaultMaxGap = 8;
+    constexpr std::size_t kObjectsPerTask = 256;
+
+    struct field_t {
+        std::uint32_t m_offset = 0;
+        std::uint32_t m_size = 0; // fields of size 0 are skipped
+    };
+
+    struct range_t {
+        std::uint32_t m_offset = 0; // in the object
+        std::uint32_t m_size = 0;
+        std::uint32_t m_record_offset = 0; // sum of the sizes of the ranges before this one
+    };
+
+    struct plan_t {
+        std::vector<range_t> m_ranges = {}; // by offset
+        std::uint32_t m_record_size = 0; // bytes captured per object
+        std::uint32_t m_field_count = 0; // fields the ranges cover
+
+        // @note: the column of range `range` in a frame of `count` objects
+        //
+        [[nodiscard]] std::size_t column_offset(const std::size_t range, const std::size_t count) const {
+            return m_ranges[range].m_record_offset * count;
+        }
+
+        // @note: where the bytes at `offset` of object `index` ended up in a frame of `count` objects, SIZE_MAX if
+        // the plan doesn't cover them
+        //
+        [[nodiscard]] std::size_t find(const std::uint32_t offset, const std::size_t index, const std::size_t count) const {
+            const auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), offset, [](const std::uint32_t value, const range_t& range) { return value < range.m_offset; });
+            if (it == m_ranges.begin() || offset >= (it - 1)->m_offset + (it - 1)->m_size)
+                return SIZE_MAX;
+
+            const auto& range = *(it - 1);
+            return range.m_record_offset * count + index * range.m_size + (offset - range.m_offset);
+        }
+    };
+
+    inline plan_t compile(std::vector<field_t> fields, const std::uint32_t max_gap = kDefaultMaxGap) {
+        std::erase_if(fields, [](const field_t& field) { return field.m_size == 0; });
+        std::sort(fields.begin(), fields.end(), [](const field_t& a, const field_t& b) { return a.m_offset < b.m_offset; });
+
+        plan_t result;
+        result.m_field_count = static_cast<std::uint32_t>(fields.size());
+
+        for (const auto& field : fields) {
+            const auto end = field.m_offset + field.m_size;
+            if (!result.m_ranges.empty()) {
+                auto& last = result.m_ranges.back();
+                if (field.m_offset <= last.m_offset + last.m_size + max_gap) {
+                    last.m_size = std::max(last.m_size, end - last.m_offset);
+                    continue;
+                }
+            }
+
+            result.m_ranges.push_back({field.m_offset, field.m_size, 0});
+        }
+
+        for (auto& range : result.m_ranges) {
+            range.m_record_offset = result.m_record_size;
+            result.m_record_size += range.m_size;
+        }
+
+        return result;
+    }
+
+    namespace detail {
+        // @note: most ranges are a single scalar or vector, a fixed size copy is a move instead of a call
+        //
+        inline void copy(std::uint8_t* destination, const std::uint8_t* source, const std::uint32_t size) {
+            switch (size) {
+            case 1:
+                std::memcpy(destination, source, 1);
+                break;
+            case 2:
+                std::memcpy(destination, source, 2);
+                break;
+            case 4:
+                std::memcpy(destination, source, 4);
+                break;
+            case 8:
+                std::memcpy(destination, source, 8);
+                break;
+            case 12:
+                std::memcpy(destination, source, 12);
+                break;
+            case 16:
+                std::memcpy(destination, source, 16);
+                break;
+            default:
+                std::memcpy(destination, source, size);
+                break;
+            }
+        }
+    } // namespace detail
+
+    // @note: `frame` must hold objects.size() * plan.m_record_size bytes. null objects capture as zeroes, so the
+    // columns of a frame stay in step with the slots of an entity list. objects are handed out in tasks of
+    // kObjectsPerTask to up to `threads` workers (0 = one per core)
+    //
+    inline void capture(const plan_t& plan, const std::span<const void* const> objects, std::uint8_t* frame, const std::uint32_t threads) {
+        const auto count = objects.size();
+        const auto task_count = (count + kObjectsPerTask - 1) / kObjectsPerTask;
+
+        parallel::for_each(task_count, task_count > 1 ? threads : 1, [&](const std::size_t task) {
+            const auto first = task * kObjectsPerTask;
+            const auto last = std::min(first + kObjectsPerTask, count);
+
+            // @note: object by object, every object is read once and the writes go to one sequential stream per range
+            //
+            for (auto i = first; i < last; ++i) {
+                const auto object = static_cast<const std::uint8_t*>(objects[i]);
+                for (const auto& range : plan.m_ranges) {
+                    const auto destination = frame + range.m_record_offset * count + i * range.m_size;
+                    if (object != nullptr)
+                        detail::copy(destination, object + range.m_offset, range.m_size);
+                    else
+                        std::memset(destination, 0, range.m_size);
+                }
+            }
+        });
+    }
+} // namespace capture
@@ -1,9 +1,13 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
+#include <format>
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
 
 #include "tools/fnv.h"
 
@@ -12,11 +16,149 @@ namespace codegen {
     constexpr std::size_t kTabsPerBlock = 2; // @note: @es3n1n: how many characters shall we place per each block
     constexpr std::initializer_list<char> kBlacklistedCharacters = {':', ';', '\\', '/'};
 
+    namespace detail {
+        constexpr bool needs_json_escape(const char c) {
+            return c == '\\' || c == '"' || c == '/' || static_cast<unsigned char>(c) <= 0x1f;
+        }
+
+        // @note: calls `write(const char*, std::size_t)` with the runs of `input` that need no escaping and their escape
+        // sequences in between, so plain names go out in a single call
+        //
+        template <typename Fn>
+        void escape_json_string(const std::string_view input, Fn&& write) {
+            std::size_t run = 0;
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                const auto c = input[i];
+                if (!needs_json_escape(c))
+                    continue;
+
+                if (i != run)
+                    write(input.data() + run, i - run);
+                run = i + 1;
+
+                switch (c) {
+                case '\\':
+                    write("\\\\", 2);
+                    break;
+                case '"':
+                    write("\\\"", 2);
+                    break;
+                case '/':
+                    write("\\/", 2);
+                    break;
+                case '\b':
+                    write("\\b", 2);
+                    break;
+                case '\f':
+                    write("\\f", 2);
+                    break;
+                case '\n':
+                    write("\\n", 2);
+                    break;
+                case '\r':
+                    write("\\r", 2);
+                    break;
+                case '\t':
+                    write("\\t", 2);
+                    break;
+                default: {
+                    const auto escaped = std::format("\\u{:04x}", static_cast<unsigned char>(c));
+                    write(escaped.data(), escaped.size());
+                }
+                }
+            }
+
+            if (run != input.size())
+                write(input.data() + run, input.size() - run);
+        }
+    } // namespace detail
+
+    // @note: `input` as the contents of a C++ string literal. control characters become 3 digit octal escapes, a hex
+    // escape would swallow the digits after it
+    //
+    inline std::string escape_cpp_string(const std::string_view input) {
+        std::string result;
+        result.reserve(input.size());
+
+        for (const auto c : input) {
+            const auto byte = static_cast<unsigned char>(c);
+            if (c == '\\' || c == '"') {
+                result.push_back('\\');
+                result.push_back(c);
+            } else if (byte < 0x20 || byte == 0x7f) {
+                result.push_back('\\');
+                result.push_back(static_cast<char>('0' + (byte >> 6)));
+                result.push_back(static_cast<char>('0' + ((byte >> 3) & 7)));
+                result.push_back(static_cast<char>('0' + (byte & 7)));
+            } else {
+                result.push_back(c);
+            }
+        }
+
+        return result;
+    }
+
+    // @note: `"key": ` tokens, quoted and escaped once and then found by the address of the key. shared by the generators
+    // rendering one scope, so it's not thread safe, and only meant for keys that outlive it unchanged: literals and schema names
+    //
+    struct key_cache_t {
+        [[nodiscard]] const std::string& get(const char* key) {
+            auto [it, inserted] = _tokens.try_emplace(key);
+            if (inserted) {
+                auto& token = it->second;
+                token.push_back('"');
+                detail::escape_json_string(key, [&token](const char* data, const std::size_t size) { token.append(data, size); });
+                token.append("\": ");
+            }
+
+            return it->second;
+        }
+    private:
+        std::unordered_map<const char*, std::string> _tokens = {};
+    };
+
+    // @note: appends `input`, json as the generator writes it, to `out` without the whitespace between tokens and without
+    // the trailing commas, so any json parser takes it
+    //
+    inline void append_compact_json(std::string& out, const std::string_view input) {
+        bool in_string = false;
+        bool escaped = false;
+        bool pending_comma = false;
+
+        for (const auto c : input) {
+            if (in_string) {
+                out.push_back(c);
+                if (escaped)
+                    escaped = false;
+                else if (c == '\\')
+                    escaped = true;
+                else if (c == '"')
+                    in_string = false;
+                continue;
+            }
+
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+                continue;
+
+            if (c == ',') {
+                pending_comma = true;
+                continue;
+            }
+
+            if (pending_comma && c != '}' && c != ']')
+                out.push_back(',');
+            pending_comma = false;
+
+            out.push_back(c);
+            in_string = c == '"';
+        }
+    }
+
     struct generator_t {
         using self_ref = std::add_lvalue_reference_t<generator_t>;
     public:
         constexpr generator_t() = default;
-        constexpr ~generator_t() = default;
+        ~generator_t() = default;
         constexpr self_ref operator=(self_ref v) {
             return v;
         }
@@ -28,7 +170,7 @@ namespace codegen {
         }
 
         self_ref begin_json_object_value() {
-            _stream << "{" << std::endl;
+            _stream << "{\n";
             inc_tabs_count(kTabsPerBlock);
             return *this;
         }
@@ -49,7 +191,7 @@ namespace codegen {
         }
 
         self_ref begin_json_array_value() {
-            _stream << "[" << std::endl;
+            _stream << "[\n";
             inc_tabs_count(kTabsPerBlock);
             return *this;
         }
@@ -64,18 +206,36 @@ namespace codegen {
             return push_line(std::format("// {}", text));
         }
 
-        self_ref json_key(const std::string& str) {
-            return push_line("\"" + escape_json_string(str) + "\": ", false);
+        // @note: keys that are literals or schema names go through the key cache if there is one
+        //
+        self_ref json_key(const char* str) {
+            if (_key_cache == nullptr)
+                return json_key(std::string_view(str));
+
+            const auto& token = _key_cache->get(str);
+            write_indent();
+            _stream.write(token.data(), static_cast<std::streamsize>(token.size()));
+            return *this;
         }
 
-        self_ref json_string(const std::string& str) {
-            _stream << "\"" + escape_json_string(str) + "\"," << std::endl;
+        self_ref json_key(const std::string_view str) {
+            write_indent();
+            _stream.put('"');
+            write_escaped(str);
+            _stream.write("\": ", 3);
+            return *this;
+        }
+
+        self_ref json_string(const std::string_view str) {
+            _stream.put('"');
+            write_escaped(str);
+            _stream.write("\",\n", 3);
             return *this;
         }
 
         template <typename T>
         self_ref json_literal(T value) {
-            _stream << std::format("{},", value) << std::endl;
+            _stream << std::format("{},\n", value);
             return *this;
         }
 
@@ -84,52 +244,56 @@ namespace codegen {
             return _stream.str();
         }
 
-        self_ref push_line(const std::string& line, bool move_cursor_to_next_line = true) {
-            for (std::size_t i = 0; i < _tabs_count; i++)
-                _stream << kTabSym;
+        // @note: number of characters written so far
+        //
+        [[nodiscard]] std::size_t size() {
+            return static_cast<std::size_t>(_stream.tellp());
+        }
+
+        // @note: append already rendered text, e.g. a fragment rendered by another generator at the current depth
+        //
+        self_ref append(const std::string& text) {
+            _stream << text;
+            return *this;
+        }
+
+        self_ref json_string_element(const std::string_view str) {
+            write_indent();
+            _stream.put('"');
+            write_escaped(str);
+            _stream.write("\",\n", 3);
+            return *this;
+        }
+
+        self_ref use_key_cache(key_cache_t* cache) {
+            _key_cache = cache;
+            return *this;
+        }
+
+        self_ref next_line() {
+            _stream << '\n';
+            return *this;
+        }
+
+        self_ref push_line(const std::string_view line, bool move_cursor_to_next_line = true) {
+            write_indent();
             _stream << line;
             if (move_cursor_to_next_line)
-                _stream << std::endl;
+                _stream << '\n';
             return *this;
         }
     private:
-        std::string escape_json_string(const std::string& input) {
-            std::ostringstream ss;
-            for (auto c : input) {
-                switch (c) {
-                case '\\':
-                    ss << "\\\\";
-                    break;
-                case '"':
-                    ss << "\\\"";
-                    break;
-                case '/':
-                    ss << "\\/";
-                    break;
-                case '\b':
-                    ss << "\\b";
-                    break;
-                case '\f':
-                    ss << "\\f";
-                    break;
-                case '\n':
-                    ss << "\\n";
-                    break;
-                case '\r':
-                    ss << "\\r";
-                    break;
-                case '\t':
-                    ss << "\\t";
-                    break;
-                default:
-                    if ('\x00' <= c && c <= '\x1f') {
-                        ss << "\\u" << std::hex << (int)c;
-                    } else {
-                        ss << c;
-                    }
-                }
+        void write_indent() {
+            static const std::string indent(64, kTabSym);
+            for (auto left = _tabs_count; left != 0;) {
+                const auto count = std::min(left, indent.size());
+                _stream.write(indent.data(), static_cast<std::streamsize>(count));
+                left -= count;
             }
-            return ss.str();
+        }
+
+        void write_escaped(const std::string_view str) {
+            detail::escape_json_string(str, [this](const char* data, const std::size_t size) { _stream.write(data, static_cast<std::streamsize>(size)); });
         }
 
         std::string escape_name(const std::string& name) {
@@ -172,6 +336,7 @@ namespace codegen {
         std::size_t _unions_count = 0;
         std::size_t _pads_count = 0;
         std::set<fnv32::hash> _forward_decls = {};
+        key_cache_t* _key_cache = nullptr;
     };
 
     __forceinline generator_t get() {
@@ -0,0 +1,533 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sdk/compressed_dump.h"
+#include "sdk/dump_index.h"
+#include "tools/mapped_file.h"
+
+// Lazy reader for <scope>.json dumps.
+//
+// Opening a dump maps the file and runs a single scan that records where every top-level class and enum
+// starts and ends, nothing else gets parsed or copied. A class or enum is only parsed when it is asked for,
+// into a small tree of value_t whose strings are views into the mapping, so the dump_t has to outlive them.
+//
+//     auto dump = dump_reader::dump_t::open("client.json");
+//     if (const auto pawn = dump.parse_class("C_CSPlayerPawn"))
+//         for (const auto& field : pawn->find("fields")->items())
+//             std::cout << field.find("name")->text() << '\n';
+//
+// When the dump was written with -idx, the <scope>.idx sidecar replaces that scan. A <scope>.jsonlz written
+// with -compress is decompressed up front, see sdk/compressed_dump.h to fetch single entries instead.
+//
+// The generator leaves a comma after the last element of every object and array, the parser accepts that.
+namespace dump_reader {
+    enum class kind_t : std::uint8_t {
+        kNull = 0,
+        kBool,
+        kNumber,
+        kString,
+        kArray,
+        kObject,
+    };
+
+    struct value_t {
+        [[nodiscard]] kind_t kind() const {
+            return _kind;
+        }
+
+        // @note: raw text of a number, a bool or a string (still escaped, without the quotes)
+        //
+        [[nodiscard]] std::string_view text() const {
+            return _text;
+        }
+
+        [[nodiscard]] std::int64_t as_int() const {
+            return std::strtoll(std::string(_text).c_str(), nullptr, 10);
+        }
+
+        [[nodiscard]] double as_double() const {
+            return std::strtod(std::string(_text).c_str(), nullptr);
+        }
+
+        [[nodiscard]] bool as_bool() const {
+            return _text == "true";
+        }
+
+        [[nodiscard]] std::string as_string() const {
+            std::string result;
+            result.reserve(_text.size());
+
+            for (std::size_t i = 0; i < _text.size(); ++i) {
+                if (_text[i] != '\\' || i + 1 == _text.size()) {
+                    result.push_back(_text[i]);
+                    continue;
+                }
+
+                switch (const auto c = _text[++i]) {
+                case 'n':
+                    result.push_back('\n');
+                    break;
+                case 'r':
+                    result.push_back('\r');
+                    break;
+                case 't':
+                    result.push_back('\t');
+                    break;
+                case 'b':
+                    result.push_back('\b');
+                    break;
+                case 'f':
+                    result.push_back('\f');
+                    break;
+                case 'u':
+                    // @note: the generator only emits \u00XX for control characters
+                    //
+                    if (i + 4 < _text.size()) {
+                        result.push_back(static_cast<char>(std::strtol(std::string(_text.substr(i + 1, 4)).c_str(), nullptr, 16)));
+                        i += 4;
+                    }
+                    break;
+                default:
+                    result.push_back(c);
+                    break;
+                }
+            }
+
+            return result;
+        }
+
+        // @note: elements of an array or values of an object, in file order
+        //
+        [[nodiscard]] const std::vector<value_t>& items() const {
+            return _items;
+        }
+
+        // @note: keys of an object, parallel to items()
+        //
+        [[nodiscard]] const std::vector<std::string_view>& keys() const {
+            return _keys;
+        }
+
+        [[nodiscard]] const value_t* find(const std::string_view key) const {
+            for (std::size_t i = 0; i < _keys.size(); ++i) {
+                if (_keys[i] == key)
+                    return &_items[i];
+            }
+
+            return nullptr;
+        }
+    private:
+        friend struct parser_t;
+
+        kind_t _kind = kind_t::kNull;
+        std::string_view _text = {};
+        std::vector<std::string_view> _keys = {};
+        std::vector<value_t> _items = {};
+    };
+
+    struct parser_t {
+        explicit parser_t(const std::string_view input): _input(input) { }
+
+        value_t parse() {
+            value_t result = parse_value();
+            skip_whitespace();
+            if (_pos != _input.size())
+                fail("Trailing data");
+
+            return result;
+        }
+
+        // @note: end of the string starting at `pos` (on the opening quote), past the closing quote
+        //
+        [[nodiscard]] static std::size_t skip_string(const std::string_view input, std::size_t pos) {
+            for (++pos; pos < input.size(); ++pos) {
+                if (input[pos] == '\\')
+                    ++pos;
+                else if (input[pos] == '"')
+                    return pos + 1;
+            }
+
+            throw std::runtime_error(std::format("{} : Unterminated string", __FUNCTION__));
+        }
+
+        // @note: end of the object/array starting at `pos`, past the closing bracket, without building anything. the
+        // brackets have to match, `closers` stays in place for the depths a dump has
+        //
+        [[nodiscard]] static std::size_t skip_container(const std::string_view input, std::size_t pos) {
+            std::string closers;
+            while (pos < input.size()) {
+                switch (input[pos]) {
+                case '"':
+                    pos = skip_string(input, pos);
+                    continue;
+                case '{':
+                    closers.push_back('}');
+                    break;
+                case '[':
+                    closers.push_back(']');
+                    break;
+                case '}':
+                case ']':
+                    if (closers.empty() || closers.back() != input[pos])
+                        throw std::runtime_error(std::format("{} : Unbalanced '{}' at offset {}", __FUNCTION__, input[pos], pos));
+
+                    closers.pop_back();
+                    if (closers.empty())
+                        return pos + 1;
+                    break;
+                default:
+                    break;
+                }
+
+                ++pos;
+            }
+
+            throw std::runtime_error(std::format("{} : Unterminated object", __FUNCTION__));
+        }
+    private:
+        [[noreturn]] void fail(const char* what) const {
+            throw std::runtime_error(std::format("dump_reader::parser_t : {} at offset {}", what, _pos));
+        }
+
+        void skip_whitespace() {
+            while (_pos < _input.size() && (_input[_pos] == ' ' || _input[_pos] == '\n' || _input[_pos] == '\r' || _input[_pos] == '\t'))
+                ++_pos;
+        }
+
+        void expect(const char c) {
+            skip_whitespace();
+            if (_pos >= _input.size() || _input[_pos] != c)
+                fail("Unexpected character");
+
+            ++_pos;
+        }
+
+        std::string_view parse_string() {
+            skip_whitespace();
+            if (_pos >= _input.size() || _input[_pos] != '"')
+                fail("Expected a string");
+
+            const auto end = skip_string(_input, _pos);
+            const auto result = _input.substr(_pos + 1, end - _pos - 2);
+            _pos = end;
+            return result;
+        }
+
+        // @note: consumes a separating comma, returns true if `close` follows (a trailing comma is fine)
+        //
+        bool next_element(const char close) {
+            skip_whitespace();
+            if (_pos < _input.size() && _input[_pos] == ',') {
+                ++_pos;
+                skip_whitespace();
+            } else if (_pos < _input.size() && _input[_pos] != close) {
+                fail("Expected ','");
+            }
+
+            if (_pos < _input.size() && _input[_pos] == close) {
+                ++_pos;
+                return true;
+            }
+
+            return false;
+        }
+
+        value_t parse_value() {
+            skip_whitespace();
+            if (_pos >= _input.size())
+                fail("Unexpected end of input");
+
+            value_t result;
+            switch (_input[_pos]) {
+            case '{':
+                result._kind = kind_t::kObject;
+                ++_pos;
+                skip_whitespace();
+                if (_pos < _input.size() && _input[_pos] == '}') {
+                    ++_pos;
+                    break;
+                }
+
+                do {
+                    result._keys.push_back(parse_string());
+                    expect(':');
+                    result._items.push_back(parse_value());
+                } while (!next_element('}'));
+                break;
+            case '[':
+                result._kind = kind_t::kArray;
+                ++_pos;
+                skip_whitespace();
+                if (_pos < _input.size() && _input[_pos] == ']') {
+                    ++_pos;
+                    break;
+                }
+
+                do
+                    result._items.push_back(parse_value());
+                while (!next_element(']'));
+                break;
+            case '"':
+                result._kind = kind_t::kString;
+                result._text = parse_string();
+                break;
+            default: {
+                const auto start = _pos;
+                while (_pos < _input.size() && std::string_view(",}] \r\n\t").find(_input[_pos]) == std::string_view::npos)
+                    ++_pos;
+
+                result._text = _input.substr(start, _pos - start);
+                if (result._text == "null")
+                    result._kind = kind_t::kNull;
+                else if (result._text == "true" || result._text == "false")
+                    result._kind = kind_t::kBool;
+                else if (!result._text.empty())
+                    result._kind = kind_t::kNumber;
+                else
+                    fail("Unexpected character");
+                break;
+            }
+            }
+
+            return result;
+        }
+
+        std::string_view _input;
+        std::size_t _pos = 0;
+    };
+
+    // @note: byte range of a top-level class or enum, `"Name": { ... }` without the trailing comma
+    //
+    struct entry_t {
+        std::string_view m_name = {};
+        std::uint64_t m_offset = 0;
+        std::uint64_t m_length = 0;
+    };
+
+    struct dump_t {
+        // @note: uses the <scope>.idx sidecar next to the json if there is a matching one, scans the json otherwise
+        //
+        static dump_t open(const std::filesystem::path& path) {
+            dump_t result;
+            result._file = mapped_file::file_t::open(path);
+
+            const auto data = result._file.view();
+            if (data.size() >= sizeof(std::uint32_t) && *reinterpret_cast<const std::uint32_t*>(data.data()) == compressed_dump::kMagic) {
+                result._decompressed = std::make_shared<const std::string>(compressed_dump::reader_t::open(path).read_all());
+                result._file.close();
+            }
+
+            auto sidecar_path = path;
+            sidecar_path.replace_extension(".idx");
+            if (!std::filesystem::exists(sidecar_path) || !result.load_index(sidecar_path))
+                result.build_index();
+
+            return result;
+        }
+
+        [[nodiscard]] bool uses_sidecar() const {
+            return _uses_sidecar;
+        }
+
+        [[nodiscard]] const std::vector<entry_t>& classes() const {
+            return _classes;
+        }
+
+        [[nodiscard]] const std::vector<entry_t>& enums() const {
+            return _enums;
+        }
+
+        [[nodiscard]] const entry_t* find_class(const std::string_view name) const {
+            return find(_classes, name);
+        }
+
+        [[nodiscard]] const entry_t* find_enum(const std::string_view name) const {
+            return find(_enums, name);
+        }
+
+        // @note: the raw `"Name": { ... }` text of an entry
+        //
+        [[nodiscard]] std::string_view text(const entry_t& entry) const {
+            return input().substr(entry.m_offset, entry.m_length);
+        }
+
+        [[nodiscard]] value_t parse(const entry_t& entry) const {
+            const auto entry_text = text(entry);
+            const auto body = entry_text.find_first_of("{[", parser_t::skip_string(entry_text, entry_text.find('"')));
+            return parser_t(entry_text.substr(body)).parse();
+        }
+
+        [[nodiscard]] std::optional<value_t> parse_class(const std::string_view name) const {
+            if (const auto entry = find_class(name))
+                return parse(*entry);
+
+            return std::nullopt;
+        }
+
+        [[nodiscard]] std::optional<value_t> parse_enum(const std::string_view name) const {
+            if (const auto entry = find_enum(name))
+                return parse(*entry);
+
+            return std::nullopt;
+        }
+    private:
+        [[nodiscard]] std::string_view input() const {
+            return _decompressed != nullptr ? std::string_view(*_decompressed) : _file.view();
+        }
+
+        static const entry_t* find(const std::vector<entry_t>& entries, const std::string_view name) {
+            const auto it = std::lower_bound(entries.begin(), entries.end(), name, [](const entry_t& entry, const std::string_view value) { return entry.m_name < value; });
+            return it != entries.end() && it->m_name == name ? &*it : nullptr;
+        }
+
+        // @note: entries only store a name hash, the names are read back from the json at every entry offset
+        //
+        bool load_index(const std::filesystem::path& sidecar_path) {
+            const auto sidecar = mapped_file::file_t::open(sidecar_path);
+            const auto data = sidecar.view();
+            if (data.size() < sizeof(dump_index::header_t))
+                return false;
+
+            const auto header = reinterpret_cast<const dump_index::header_t*>(data.data());
+            if (header->magic != dump_index::kMagic || header->version != dump_index::kVersion || header->file_size != input().size() ||
+                data.size() < sizeof(dump_index::header_t) + std::uint64_t{header->entry_count} * sizeof(dump_index::entry_t))
+                return false;
+
+            const auto input = this->input();
+            const auto entries = reinterpret_cast<const dump_index::entry_t*>(header + 1);
+
+            // @note: a sidecar that doesn't fit the json is ignored like one of another version, the entry has to be a quoted
+            // name up to a closing brace
+            //
+            std::vector<entry_t> classes, enums;
+            for (std::uint32_t i = 0; i < header->entry_count; ++i) {
+                const auto& entry = entries[i];
+                if (entry.offset >= input.size() || entry.length < 2 || entry.length > input.size() - entry.offset || input[entry.offset] != '"' ||
+                    input[entry.offset + entry.length - 1] != '}')
+                    return false;
+
+                const auto text = input.substr(entry.offset, entry.length);
+                std::size_t name_end = 0;
+                try {
+                    name_end = parser_t::skip_string(text, 0);
+                } catch (const std::runtime_error&) {
+                    return false;
+                }
+
+                auto& target = entry.kind == dump_index::kind_t::kClass ? classes : enums;
+                target.push_back({text.substr(1, name_end - 2), entry.offset, entry.length});
+            }
+
+            const auto by_name = [](const entry_t& a, const entry_t& b) { return a.m_name < b.m_name; };
+            std::sort(classes.begin(), classes.end(), by_name);
+            std::sort(enums.begin(), enums.end(), by_name);
+
+            _classes = std::move(classes);
+            _enums = std::move(enums);
+            _uses_sidecar = true;
+            return true;
+        }
+
+        // @note: walks the root object, only descending into "enums" and "classes". a dump that was cut short or doesn't
+        // nest properly is an error, rather than entries running to the end of the file
+        //
+        void build_index() {
+            const auto input = this->input();
+
+            const auto skip_whitespace = [&](std::size_t pos) {
+                while (pos < input.size() && (input[pos] == ' ' || input[pos] == '\n' || input[pos] == '\r' || input[pos] == '\t'))
+                    ++pos;
+                return pos;
+            };
+
+            // @note: the generator leaves a comma after the last member as well
+            //
+            const auto skip_separators = [&](std::size_t pos) {
+                while ((pos = skip_whitespace(pos)) < input.size() && input[pos] == ',')
+                    ++pos;
+                return pos;
+            };
+
+            const auto expect = [&](const std::size_t pos, const char c) {
+                if (pos >= input.size())
+                    throw std::runtime_error(std::format("dump_reader::dump_t : Expected '{}' at offset {}, the dump ends before", c, pos));
+                if (input[pos] != c)
+                    throw std::runtime_error(std::format("dump_reader::dump_t : Expected '{}' at offset {}, found '{}'", c, pos, input[pos]));
+            };
+
+            const auto read_key = [&](std::size_t& pos) {
+                const auto end = parser_t::skip_string(input, pos);
+                const auto key = input.substr(pos + 1, end - pos - 2);
+                pos = skip_whitespace(end);
+                expect(pos, ':');
+                pos = skip_whitespace(pos + 1);
+                if (pos >= input.size())
+                    throw std::runtime_error(std::format("dump_reader::dump_t : No value for '{}' at offset {}", key, pos));
+                return key;
+            };
+
+            // @note: past a value of the root other than "enums"/"classes"
+            //
+            const auto skip_value = [&](const std::size_t pos) {
+                if (input[pos] == '{' || input[pos] == '[')
+                    return parser_t::skip_container(input, pos);
+                if (input[pos] == '"')
+                    return parser_t::skip_string(input, pos);
+
+                const auto end = input.find_first_of(",} \r\n\t", pos);
+                if (end == std::string_view::npos)
+                    throw std::runtime_error(std::format("dump_reader::dump_t : Unterminated value at offset {}", pos));
+                return end;
+            };
+
+            auto pos = skip_whitespace(0);
+            expect(pos, '{');
+            pos = skip_separators(pos + 1);
+            while (pos < input.size() && input[pos] == '"') {
+                const auto key = read_key(pos);
+
+                auto* entries = key == "classes" ? &_classes : key == "enums" ? &_enums : nullptr;
+                if (entries == nullptr || input[pos] != '{') {
+                    pos = skip_separators(skip_value(pos));
+                    continue;
+                }
+
+                pos = skip_separators(pos + 1);
+                while (pos < input.size() && input[pos] == '"') {
+                    const auto start = pos;
+                    const auto name = read_key(pos);
+                    expect(pos, '{');
+                    const auto end = parser_t::skip_container(input, pos);
+                    entries->push_back({name, start, end - start});
+                    pos = skip_separators(end);
+                }
+
+                expect(pos, '}'); // @note: closing brace of "classes"/"enums"
+                pos = skip_separators(pos + 1);
+            }
+
+            expect(pos, '}');
+            if (const auto end = skip_whitespace(pos + 1); end != input.size())
+                throw std::runtime_error(std::format("dump_reader::dump_t : Trailing data at offset {}", end));
+
+            const auto by_name = [](const entry_t& a, const entry_t& b) { return a.m_name < b.m_name; };
+            std::sort(_classes.begin(), _classes.end(), by_name);
+            std::sort(_enums.begin(), _enums.end(), by_name);
+        }
+
+        mapped_file::file_t _file;
+        std::shared_ptr<const std::string> _decompressed = nullptr; // @note: shared, so entry names stay valid when the dump_t is moved
+        std::vector<entry_t> _classes = {};
+        std::vector<entry_t> _enums = {};
+        bool _uses_sidecar = false;
+    };
+} // namespace dump_reader
@@ -0,0 +1,139 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Value to name tables for schema enums.
+//
+// Every enum gets the cheapest table its values allow:
+//
+//     kFlags   values are single bits and masks made of them, with gaps in between, a name per bit position
+//              plus the masks sorted by value
+//     kDense   values cover at least half of [min, max], a name per value in that range, indexed by `value - min`
+//     kSparse  everything else, the values sorted for a binary search
+//
+// A gapless enum such as {0, 1, 2, 3} is made of bits too, but it's a counter far more often than a set of
+// flags and the dense table answers the same lookups.
+//
+// Tables refer to enumerators by their index in declaration order. When several enumerators share a value,
+// the first one declared wins.
+namespace enum_table {
+    constexpr std::uint32_t kNone = 0xFFFFFFFF;
+    constexpr std::uint64_t kMaxDenseSlots = 1ull << 16;
+    constexpr std::uint64_t kMinDenseFill = 2; // at most every other slot of a dense table may be empty
+
+    enum class kind_t : std::uint8_t {
+        kDense = 0,
+        kSparse,
+        kFlags,
+    };
+
+    struct item_t {
+        std::int64_t m_value = 0;
+        std::uint32_t m_index = kNone; // enumerator index
+    };
+
+    struct table_t {
+        kind_t m_kind = kind_t::kSparse;
+        std::int64_t m_base = 0; // kDense: the value of m_slots[0]
+        std::vector<std::uint32_t> m_slots = {}; // kDense: an enumerator per value, kFlags: an enumerator per bit, kNone if there is none
+        std::vector<item_t> m_sorted = {}; // kSparse: every value, kFlags: the values that aren't a single bit
+    };
+
+    namespace detail {
+        // @note: the distinct values, each with the first enumerator that has it
+        //
+        inline std::vector<item_t> sort_unique(const std::span<const std::int64_t> values) {
+            std::vector<item_t> result;
+            result.reserve(values.size());
+            for (std::uint32_t i = 0; i < values.size(); ++i)
+                result.push_back({values[i], i});
+
+            std::stable_sort(result.begin(), result.end(), [](const item_t& a, const item_t& b) { return a.m_value < b.m_value; });
+            result.erase(std::unique(result.begin(), result.end(), [](const item_t& a, const item_t& b) { return a.m_value == b.m_value; }), result.end());
+            return result;
+        }
+
+        // @note: number of values in [min, max], 0 if that's all of them
+        //
+        inline std::uint64_t get_span(const std::vector<item_t>& sorted) {
+            return static_cast<std::uint64_t>(sorted.back().m_value) - static_cast<std::uint64_t>(sorted.front().m_value) + 1;
+        }
+
+        inline bool is_contiguous(const std::vector<item_t>& sorted) {
+            return get_span(sorted) == sorted.size();
+        }
+
+        inline bool is_dense(const std::vector<item_t>& sorted) {
+            const auto span = get_span(sorted);
+            return span != 0 && span <= kMaxDenseSlots && span <= sorted.size() * kMinDenseFill;
+        }
+
+        // @note: single bits that fit the storage of the enum plus masks made of them, at least two bits so
+        // that a plain 0/1 enum doesn't count
+        //
+        inline bool is_flags(const std::vector<item_t>& sorted, const std::size_t bit_count) {
+            std::uint64_t bits = 0;
+            std::size_t single_bits = 0;
+            for (const auto& item : sorted) {
+                if (item.m_value < 0)
+                    return false;
+
+                const auto value = static_cast<std::uint64_t>(item.m_value);
+                if (std::has_single_bit(value)) {
+                    if (static_cast<std::size_t>(std::countr_zero(value)) >= bit_count)
+                        return false;
+
+                    bits |= value;
+                    ++single_bits;
+                }
+            }
+
+            if (single_bits < 2)
+                return false;
+
+            return std::all_of(sorted.begin(), sorted.end(), [bits](const item_t& item) { return (static_cast<std::uint64_t>(item.m_value) & ~bits) == 0; });
+        }
+    } // namespace detail
+
+    // @note: `values` in declaration order, `size` is the size of the enum in bytes
+    //
+    inline table_t build(const std::span<const std::int64_t> values, const std::size_t size) {
+        table_t result;
+
+        auto sorted = detail::sort_unique(values);
+        if (sorted.empty())
+            return result;
+
+        const auto bit_count = size == 1 || size == 2 || size == 4 ? size * 8 : 64;
+        if (!detail::is_contiguous(sorted) && detail::is_flags(sorted, bit_count)) {
+            result.m_kind = kind_t::kFlags;
+            result.m_slots.assign(bit_count, kNone);
+            for (const auto& item : sorted) {
+                const auto value = static_cast<std::uint64_t>(item.m_value);
+                if (std::has_single_bit(value))
+                    result.m_slots[std::countr_zero(value)] = item.m_index;
+                else
+                    result.m_sorted.push_back(item);
+            }
+
+            return result;
+        }
+
+        if (detail::is_dense(sorted)) {
+            result.m_kind = kind_t::kDense;
+            result.m_base = sorted.front().m_value;
+            result.m_slots.assign(static_cast<std::uint64_t>(sorted.back().m_value) - static_cast<std::uint64_t>(result.m_base) + 1, kNone);
+            for (const auto& item : sorted)
+                result.m_slots[static_cast<std::uint64_t>(item.m_value) - static_cast<std::uint64_t>(result.m_base)] = item.m_index;
+
+            return result;
+        }
+
+        result.m_kind = kind_t::kSparse;
+        result.m_sorted = std::move(sorted);
+        return result;
+    }
+} // namespace enum_table
@@ -1,18 +1,33 @@
+#pragma once
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "codegen.h"
+#include "tools/fnv.h"
 
 namespace field_parser {
+    constexpr std::size_t kMaxArrayDimensions = 4;
+
+    // @note: views into the names passed to parse(), which have to outlive it. schema names live as long as the schema system
+    //
     struct field_info_t {
         constexpr field_info_t() = default;
         constexpr ~field_info_t() = default;
     public:
-        std::string m_type = ""; // var type
-        std::string m_name = ""; // var name
+        std::string_view m_type = {}; // var type
+        std::string_view m_name = {}; // var name
 
         // array sizes, for example {13, 37} for multi demensional array "[13][37]"
-        std::vector<std::size_t> m_array_sizes = {};
+        std::array<std::size_t, kMaxArrayDimensions> m_array_sizes = {};
+        std::size_t m_array_dimensions = 0ull;
 
         std::size_t m_bitfield_size = 0ull; // bitfield size, set to 0 if var isn't a bitfield
     public:
@@ -21,13 +36,17 @@ namespace field_parser {
         }
 
         __forceinline bool is_array() const {
-            return !m_array_sizes.empty();
+            return m_array_dimensions != 0;
+        }
+
+        __forceinline std::span<const std::size_t> array_sizes() const {
+            return {m_array_sizes.data(), m_array_dimensions};
         }
     public:
         std::size_t total_array_size() const {
             std::size_t result = 0ull;
 
-            for (auto size : m_array_sizes) {
+            for (auto size : array_sizes()) {
                 if (!result) {
                     result = size;
                     continue;
@@ -39,38 +58,37 @@ namespace field_parser {
             return result;
         }
     public:
-        std::string formatted_array_sizes() const {
-            std::string result;
+        // @note: the append_* functions write into `out` without any temporary, the formatted_* ones are shorthands for them
+        //
+        void append_array_sizes(std::string& out) const {
+            for (std::size_t i = 0; i < m_array_dimensions; ++i)
+                out.append("[]");
+        }
 
-            for (std::size_t size : m_array_sizes)
-                result += std::format("[]");
+        void append_type(std::string& out) const {
+            const auto start = out.size();
+            out.append(m_type);
+            std::replace(out.begin() + static_cast<std::ptrdiff_t>(start), out.end(), '*', '?');
 
+            append_array_sizes(out);
+        }
+
+        std::string formatted_array_sizes() const {
+            std::string result;
+            append_array_sizes(result);
             return result;
         }
 
         std::string formatted_type() const {
-            std::string result = m_type;
-
-            replace_all(result, "*", "?");
-
-            if (is_array())
-                result = std::format("{}{}", result, formatted_array_sizes());
-
+            std::string result;
+            result.reserve(m_type.size() + m_array_dimensions * 2);
+            append_type(result);
             return result;
         }
 
-        std::string formatted_name() const {
+        std::string_view formatted_name() const {
             return m_name;
         }
-
-    private:
-        void replace_all(std::string& str, const std::string& from, const std::string& to) const {
-            size_t start_pos = 0;
-            while ((start_pos = str.find(from, start_pos)) != std::string::npos) {
-                str.replace(start_pos, from.length(), to);
-                start_pos += to.length();
-            }
-        }
     };
 
     namespace detail {
@@ -82,22 +100,44 @@ namespace field_parser {
             constexpr std::string_view kArraySizePrefix = "["sv;
             constexpr std::string_view kArraySizePostfix = "]"sv;
 
-            // clang-format off
-            constexpr std::initializer_list<std::pair<std::string_view, std::string_view>> kTypeNameToCs = {
-                {"float32"sv, "float"sv}, 
-                {"float64"sv, "double"sv},
-    
-                {"int8"sv, "sbyte"sv},   
-                {"int16"sv, "short"sv},   
-                {"int32"sv, "int"sv},   
-                {"int64"sv, "long"sv},
-    
-                {"uint8"sv, "byte"sv}, 
-                {"uint16"sv, "ushort"sv}, 
-                {"uint32"sv, "uint"sv}, 
-                {"uint64"sv, "ulong"sv}
-            };
-            // clang-format on
+            constexpr fnv32::hash hash_type_name(const std::string_view type_name) {
+                auto result = fnv32::hash_init();
+                for (const auto c : type_name)
+                    result = fnv32::hash_byte(result, static_cast<std::uint8_t>(c));
+
+                return result;
+            }
+
+            // @note: the c# name of a schema builtin, the type name itself if there is no rule for it.
+            // a switch over compile time hashes, the names are still compared in case of a collision
+            //
+            constexpr std::string_view translate_type_name(const std::string_view type_name) {
+                std::string_view from, to;
+
+                // clang-format off
+                switch (hash_type_name(type_name)) {
+                case FNV32("float32"): from = "float32"sv; to = "float"sv; break;
+                case FNV32("float64"): from = "float64"sv; to = "double"sv; break;
+
+                case FNV32("int8"): from = "int8"sv; to = "sbyte"sv; break;
+                case FNV32("int16"): from = "int16"sv; to = "short"sv; break;
+                case FNV32("int32"): from = "int32"sv; to = "int"sv; break;
+                case FNV32("int64"): from = "int64"sv; to = "long"sv; break;
+
+                case FNV32("uint8"): from = "uint8"sv; to = "byte"sv; break;
+                case FNV32("uint16"): from = "uint16"sv; to = "ushort"sv; break;
+                case FNV32("uint32"): from = "uint32"sv; to = "uint"sv; break;
+                case FNV32("uint64"): from = "uint64"sv; to = "ulong"sv; break;
+                default: return type_name;
+                }
+                // clang-format on
+
+                return type_name == from ? to : type_name;
+            }
+
+            static_assert(translate_type_name("float32"sv) == "float"sv);
+            static_assert(translate_type_name("uint64"sv) == "ulong"sv);
+            static_assert(translate_type_name("CHandle< CBaseEntity >"sv) == "CHandle< CBaseEntity >"sv);
         } // namespace
 
         // @note: @es3n1n: basically the same thing as std::atoi
@@ -116,29 +156,27 @@ namespace field_parser {
         // the bitfield/array parsing and the type would be already set if item is a bitfield
         // or array
         //
-        __forceinline void parse_type(field_info_t& result, const std::string& type_name) {
+        __forceinline void parse_type(field_info_t& result, const std::string_view type_name) {
             if (result.m_type.empty())
                 result.m_type = type_name;
 
-            // @note: @es3n1n: applying kTypeNameToCpp rules
-            for (auto& rule : kTypeNameToCs) {
-                if (result.m_type != rule.first)
-                    continue;
-
-                result.m_type = rule.second;
-                break;
-            }
+            result.m_type = translate_type_name(result.m_type);
         }
     } // namespace detail
 
-    inline field_info_t parse(const std::string& type_name, const std::string& name, const std::vector<std::size_t>& array_sizes) {
+    inline field_info_t parse(const std::string_view type_name, const std::string_view name, const std::span<const std::size_t> array_sizes) {
+        if (array_sizes.size() > kMaxArrayDimensions)
+            throw std::runtime_error(std::format("{} : '{}' has {} array dimensions, at most {} are supported", __FUNCTION__, name,
+                                                 array_sizes.size(), kMaxArrayDimensions));
+
         field_info_t result = {};
         result.m_name = name;
 
-        std::copy(array_sizes.begin(), array_sizes.end(), std::back_inserter(result.m_array_sizes));
+        std::copy(array_sizes.begin(), array_sizes.end(), result.m_array_sizes.begin());
+        result.m_array_dimensions = array_sizes.size();
 
         detail::parse_type(result, type_name);
 
         return result;
     }
-} // namespace field_parser
\ No newline at end of file
+} // namespace field_parser
@@ -1,8 +1,10 @@
 #pragma once
 #include <cstdint>
+#include <cstring>
+#include <string_view>
 #include <type_traits>
 
-// Implements FNV-1a hash algorithm
+// Implements FNV-1a hash algorithm, and whash64, a faster 64-bit hash for names that aren't persisted
 namespace detail {
     template <typename Type, Type OffsetBasis, Type Prime>
     struct SizeDependantData {
@@ -39,12 +41,16 @@ namespace detail {
             return (current ^ byte) * k_prime;
         }
 
+        // @note: iterative, so the length of compile time strings isn't bound by the constexpr recursion depth
+        //
         template <std::size_t N>
         static __forceinline constexpr auto hash_constexpr(const char (&str)[N], const std::size_t size = N - 1 /* do not hash the null */
                                                            ) -> hash {
-            const auto prev_hash = size == 1 ? hash_init() : hash_constexpr(str, size - 1);
-            const auto cur_hash = hash_byte(prev_hash, str[size - 1]);
-            return cur_hash;
+            auto result = hash_init();
+            for (std::size_t i = 0; i < size; ++i)
+                result = hash_byte(result, str[i]);
+
+            return result;
         }
 
         static auto __forceinline hash_runtime_data(const void* data, const size_t sz) -> hash {
@@ -59,18 +65,16 @@ namespace detail {
 
         static auto __forceinline hash_runtime(const char* str) -> hash {
             auto result = hash_init();
-            do
+            while (*str != '\0')
                 result = hash_byte(result, *str++);
-            while (*str != '\0');
 
             return result;
         }
 
         static auto __forceinline hash_runtime(const wchar_t* str) -> hash {
             auto result = hash_init();
-            do
+            while (*str != L'\0')
                 result = hash_byte(result, static_cast<char>(*str++));
-            while (*str != L'\0');
 
             return result;
         }
@@ -79,9 +83,8 @@ namespace detail {
             auto end = str + sz;
             auto result = hash_init();
 
-            do
+            while (str != end)
                 result = hash_byte(result, *str++);
-            while (str != end);
 
             return result;
         }
@@ -90,19 +93,120 @@ namespace detail {
             auto end = str + sz;
             auto result = hash_init();
 
-            do
+            while (str != end)
                 result = hash_byte(result, static_cast<char>(*str++));
-            while (str != end);
 
             return result;
         }
     };
+
+    // @note: 64-bit hash consuming 8 bytes per step, with the lane, tail and avalanche steps of xxh64 (so it matches xxh64
+    // for inputs shorter than 32 bytes, which is most schema names). a single constexpr implementation serves compile
+    // time and runtime, only the loads differ, so both always agree
+    //
+    class WordHash64 {
+    public:
+        using hash = std::uint64_t;
+    private:
+        constexpr static hash k_prime_1 = 0x9E3779B185EBCA87ull;
+        constexpr static hash k_prime_2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr static hash k_prime_3 = 0x165667B19E3779F9ull;
+        constexpr static hash k_prime_4 = 0x85EBCA77C2B2AE63ull;
+        constexpr static hash k_prime_5 = 0x27D4EB2F165667C5ull;
+
+        static __forceinline constexpr hash rotl(const hash value, const int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        template <typename T>
+        static __forceinline constexpr T load(const char* data) {
+            if (std::is_constant_evaluated()) {
+                T result = 0;
+                for (std::size_t i = 0; i < sizeof(T); ++i)
+                    result |= static_cast<T>(static_cast<std::uint8_t>(data[i])) << (i * 8);
+                return result;
+            }
+
+            T result;
+            std::memcpy(&result, data, sizeof(T)); // @note: little endian, like everything we run on
+            return result;
+        }
+    public:
+        static __forceinline constexpr hash hash_init(const std::size_t size) {
+            return k_prime_5 + size;
+        }
+
+        static __forceinline constexpr hash hash_word(const hash current, const std::uint64_t word) {
+            return rotl(current ^ (rotl(word * k_prime_2, 31) * k_prime_1), 27) * k_prime_1 + k_prime_4;
+        }
+
+        // @note: the last size % 8 bytes
+        //
+        static __forceinline constexpr hash hash_tail(hash current, const char* data, std::size_t size) {
+            if (size >= 4) {
+                current = rotl(current ^ (load<std::uint32_t>(data) * k_prime_1), 23) * k_prime_2 + k_prime_3;
+                data += 4;
+                size -= 4;
+            }
+
+            for (std::size_t i = 0; i < size; ++i)
+                current = rotl(current ^ (static_cast<std::uint8_t>(data[i]) * k_prime_5), 11) * k_prime_1;
+
+            return current;
+        }
+
+        static __forceinline constexpr hash hash_finish(hash current) {
+            current ^= current >> 33;
+            current *= k_prime_2;
+            current ^= current >> 29;
+            current *= k_prime_3;
+            current ^= current >> 32;
+            return current;
+        }
+
+        static __forceinline constexpr hash hash_data(const char* data, const std::size_t size) {
+            auto result = hash_init(size);
+
+            std::size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+                result = hash_word(result, load<std::uint64_t>(data + i));
+
+            return hash_finish(hash_tail(result, data + i, size - i));
+        }
+
+        static __forceinline constexpr hash hash_runtime(const std::string_view str) {
+            return hash_data(str.data(), str.size());
+        }
+
+        template <std::size_t N>
+        static __forceinline constexpr hash hash_constexpr(const char (&str)[N]) {
+            return hash_data(str, N - 1);
+        }
+
+        // @note: for unordered containers keyed by strings, transparent so they can be searched with a string_view
+        //
+        struct hasher {
+            using is_transparent = void;
+
+            std::size_t operator()(const std::string_view str) const noexcept {
+                return static_cast<std::size_t>(hash_runtime(str));
+            }
+        };
+    };
+
+    // @note: xxh64 reference values, seed 0
+    //
+    static_assert(WordHash64::hash_constexpr("") == 0xEF46DB3751D8E999ull);
+    static_assert(WordHash64::hash_constexpr("a") == 0xD24EC4F1A98C6E5Bull);
+    static_assert(WordHash64::hash_constexpr("abc") == 0x44BC2CF5AD770999ull);
 } // namespace detail
 
 using fnv32 = ::detail::FnvHash<32>;
 using fnv64 = ::detail::FnvHash<64>;
 using fnv = ::detail::FnvHash<sizeof(void*) * 8>;
+using whash64 = ::detail::WordHash64;
 
 #define FNV(str) (std::integral_constant<fnv::hash, fnv::hash_constexpr(str)>::value)
 #define FNV32(str) (std::integral_constant<fnv32::hash, fnv32::hash_constexpr(str)>::value)
 #define FNV64(str) (std::integral_constant<fnv64::hash, fnv64::hash_constexpr(str)>::value)
+#define WHASH64(str) (std::integral_constant<whash64::hash, whash64::hash_constexpr(str)>::value)
@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Dump-and-exit startup mode. Everything that touches the engine goes through `environment_t`, so the
+// trigger logic can be driven by a stand-in outside of the game.
+namespace headless {
+    constexpr int kExitSuccess = 0;
+    constexpr int kExitFailure = 1;
+    constexpr std::uint32_t kSettlePolls = 3;
+
+    // @note: the type scopes registered so far
+    //
+    struct scopes_t {
+        std::vector<std::string> m_names = {};
+        std::uint64_t m_fingerprint = 0; // changes whenever a scope comes or goes or the number of its bindings changes
+    };
+
+    struct environment_t {
+        std::function<const char*()> m_get_output_dir = nullptr; // value of the launch parameter, null if it isn't set
+        std::function<std::vector<std::string>()> m_get_expected_scopes = nullptr; // scopes to wait for, may be null or empty
+        std::function<std::optional<scopes_t>()> m_get_scopes = nullptr; // nullopt until the schema system can be queried
+        std::function<void(const std::string& out_dir)> m_dump = nullptr; // throws on failure
+        std::function<void(const std::string& message)> m_report_error = nullptr;
+        std::function<void(int exit_code)> m_exit = nullptr; // isn't expected to return
+    };
+
+    // @note: poll() is called from the startup hooks and then periodically on the main thread. modules keep registering
+    // their type scopes while the game starts, so the dump only happens once every expected scope is there and the
+    // scopes didn't change for `settle_polls` polls in a row. without the launch parameter the trigger disarms itself
+    // on the first call
+    //
+    struct trigger_t {
+        explicit trigger_t(environment_t environment, const std::uint32_t settle_polls = kSettlePolls):
+            _environment(std::move(environment)), _settle_polls(settle_polls) { }
+
+        // @note: returns true if this call performed the dump
+        //
+        bool poll() {
+            if (_done)
+                return false;
+
+            const auto out_dir = _environment.m_get_output_dir();
+            if (out_dir == nullptr || *out_dir == '\0') {
+                _done = true;
+                return false;
+            }
+
+            const auto scopes = _environment.m_get_scopes();
+            if (!scopes || !settled(*scopes))
+                return false;
+
+            _done = true;
+
+            // @note: whatever goes wrong, the process has to end with an exit code a script can check
+            //
+            auto exit_code = kExitSuccess;
+            try {
+                _environment.m_dump(out_dir);
+            } catch (std::exception& err) {
+                _environment.m_report_error(err.what());
+                exit_code = kExitFailure;
+            } catch (...) {
+                _environment.m_report_error("Unknown error");
+                exit_code = kExitFailure;
+            }
+
+            _environment.m_exit(exit_code);
+            return true;
+        }
+
+        [[nodiscard]] bool done() const {
+            return _done;
+        }
+    private:
+        bool settled(const scopes_t& scopes) {
+            if (!_seen || scopes.m_fingerprint != _fingerprint) {
+                _seen = true;
+                _fingerprint = scopes.m_fingerprint;
+                _stable_polls = 0;
+                return false;
+            }
+
+            if (_stable_polls < _settle_polls)
+                ++_stable_polls;
+            if (_stable_polls < _settle_polls)
+                return false;
+
+            if (!_environment.m_get_expected_scopes)
+                return true;
+
+            const auto expected = _environment.m_get_expected_scopes();
+            return std::all_of(expected.begin(), expected.end(), [&](const std::string& name) {
+                return std::find(scopes.m_names.begin(), scopes.m_names.end(), name) != scopes.m_names.end();
+            });
+        }
+
+        environment_t _environment = {};
+        std::uint32_t _settle_polls = kSettlePolls;
+        std::uint32_t _stable_polls = 0;
+        std::uint64_t _fingerprint = 0;
+        bool _seen = false;
+        bool _done = false;
+    };
+} // namespace headless
@@ -0,0 +1,147 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "tools/fnv.h"
+
+namespace ids {
+    enum class kind_t : std::uint8_t {
+        kClass = 0,
+        kField,
+        kEnum,
+        kCount
+    };
+
+    constexpr std::array<std::string_view, static_cast<std::size_t>(kind_t::kCount)> kKindNames = {"class", "field", "enum"};
+
+    // @note: persistent name -> id mapping. ids are dense per kind, handed out in the order names first
+    // appear and never reused, so consumers can index flat arrays with them across game builds.
+    //
+    // the file is plain text, one `<kind> <id> <key>` per line, where the key of a field is `Class::m_field`
+    //
+    struct registry_t {
+        void load(const std::filesystem::path& path) {
+            std::ifstream f(path);
+            if (!f.is_open())
+                return; // @note: first run, start from an empty registry
+
+            // @note: two keys with one id would hand the same slot to both, stable ids are worth nothing then
+            //
+            std::array<std::unordered_set<std::uint32_t>, static_cast<std::size_t>(kind_t::kCount)> loaded_ids = {};
+
+            std::string line;
+            std::size_t line_number = 0;
+            while (std::getline(f, line)) {
+                ++line_number;
+                if (line.empty() || line[0] == '#')
+                    continue;
+
+                // @note: the key is the rest of the line, names of template types have spaces in them
+                //
+                std::istringstream ss(line);
+                std::string kind_name, key;
+                std::uint32_t id = 0;
+                if (!(ss >> kind_name >> id) || ss.get() != ' ' || !std::getline(ss, key) || key.empty())
+                    throw std::runtime_error(std::format("{} : Malformed line {} in '{}'", __FUNCTION__, line_number, path.string()));
+
+                const auto kind_it = std::find(kKindNames.begin(), kKindNames.end(), kind_name);
+                if (kind_it == kKindNames.end())
+                    throw std::runtime_error(std::format("{} : Unknown kind '{}' in '{}'", __FUNCTION__, kind_name, path.string()));
+
+                const auto kind = static_cast<std::size_t>(kind_it - kKindNames.begin());
+                auto& table = _tables[kind];
+                if (!table.m_ids.emplace(key, id).second)
+                    throw std::runtime_error(std::format("{} : Duplicate key '{}' in '{}'", __FUNCTION__, key, path.string()));
+
+                if (!loaded_ids[kind].insert(id).second)
+                    throw std::runtime_error(std::format("{} : Duplicate {} id {} (line {}) in '{}'", __FUNCTION__, kind_name, id, line_number, path.string()));
+
+                table.m_next = std::max(table.m_next, id + 1);
+            }
+        }
+
+        void save(const std::filesystem::path& path) const {
+            std::ofstream f(path, std::ios::out | std::ios::binary);
+            f << "# CS2SchemaGen id registry, do not edit ids by hand\n";
+
+            for (std::size_t kind = 0; kind < _tables.size(); ++kind) {
+                std::vector<std::pair<std::uint32_t, std::string_view>> entries;
+                entries.reserve(_tables[kind].m_ids.size());
+                for (const auto& [key, id] : _tables[kind].m_ids)
+                    entries.emplace_back(id, key);
+
+                std::sort(entries.begin(), entries.end());
+                for (const auto& [id, key] : entries)
+                    f << kKindNames[kind] << ' ' << id << ' ' << key << '\n';
+            }
+        }
+
+        // @note: queue a key, it receives an id on the next commit() if it doesn't have one yet
+        //
+        void request(const kind_t kind, std::string key) {
+            auto& table = _tables[static_cast<std::size_t>(kind)];
+            if (!table.m_ids.contains(key))
+                table.m_requested.push_back(std::move(key));
+        }
+
+        // @note: new keys are assigned in lexicographic order so the result doesn't depend on the
+        // order in which the schema system hands out its bindings
+        //
+        std::size_t commit() {
+            std::size_t assigned = 0;
+
+            for (auto& table : _tables) {
+                std::sort(table.m_requested.begin(), table.m_requested.end());
+                table.m_requested.erase(std::unique(table.m_requested.begin(), table.m_requested.end()), table.m_requested.end());
+
+                for (auto& key : table.m_requested) {
+                    if (table.m_ids.emplace(std::move(key), table.m_next).second) {
+                        ++table.m_next;
+                        ++assigned;
+                    }
+                }
+
+                table.m_requested.clear();
+            }
+
+            return assigned;
+        }
+
+        [[nodiscard]] std::optional<std::uint32_t> find(const kind_t kind, const std::string_view key) const {
+            const auto& ids = _tables[static_cast<std::size_t>(kind)].m_ids;
+            if (const auto it = ids.find(key); it != ids.end())
+                return it->second;
+
+            return std::nullopt;
+        }
+
+        [[nodiscard]] std::size_t size(const kind_t kind) const {
+            return _tables[static_cast<std::size_t>(kind)].m_next;
+        }
+
+        static std::string field_key(const std::string_view class_name, const std::string_view field_name) {
+            return std::format("{}::{}", class_name, field_name);
+        }
+    private:
+        struct table_t {
+            std::unordered_map<std::string, std::uint32_t, whash64::hasher, std::equal_to<>> m_ids = {};
+            std::vector<std::string> m_requested = {};
+            std::uint32_t m_next = 0;
+        };
+
+        std::array<table_t, static_cast<std::size_t>(kind_t::kCount)> _tables = {};
+    };
+} // namespace ids
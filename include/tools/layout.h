@@ -0,0 +1,123 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Memory layout of a class as far as the schema describes it: where the fields are, which bytes no field
+// covers and which cache lines the fields fall in.
+//
+// Fields may overlap (unions, bitfields sharing a storage unit), a byte counts as used if any field covers it.
+// A field of unknown size is taken to reach the next field, so it never makes up a hole. The bytes in front
+// of the first field aren't padding, in a polymorphic class that's where the vtable pointer is.
+namespace layout {
+    constexpr std::uint32_t kCacheLineSize = 64;
+
+    struct field_t {
+        std::string_view m_name = {};
+        std::string_view m_owner = {}; // the base class that declares it, empty for the class itself
+        std::uint32_t m_offset = 0;
+        std::uint32_t m_size = 0; // 0 if unknown
+        bool m_networked = false;
+
+        [[nodiscard]] std::uint32_t first_line() const {
+            return m_offset / kCacheLineSize;
+        }
+
+        [[nodiscard]] std::uint32_t last_line() const {
+            return m_size != 0 ? (m_offset + m_size - 1) / kCacheLineSize : first_line();
+        }
+    };
+
+    struct hole_t {
+        std::uint32_t m_offset = 0;
+        std::uint32_t m_size = 0;
+    };
+
+    struct report_t {
+        std::uint32_t m_size = 0;
+        std::vector<field_t> m_fields = {}; // by offset
+        std::vector<hole_t> m_holes = {}; // by offset, the last one may be the tail padding
+        std::uint32_t m_leading = 0; // bytes in front of the first field
+        std::uint32_t m_padding = 0; // bytes in holes, including the tail padding
+        std::uint32_t m_tail_padding = 0; // bytes after the last field
+        std::uint32_t m_cache_lines = 0; // cache lines a 64 byte aligned instance spans
+        std::uint32_t m_networked_lines = 0; // cache lines with at least one networked field
+        std::uint32_t m_straddling = 0; // networked fields split over two or more cache lines
+
+        // @note: share of the class that is padding
+        //
+        [[nodiscard]] double fragmentation() const {
+            return m_size != 0 ? static_cast<double>(m_padding) / m_size : 0.0;
+        }
+    };
+
+    inline report_t analyze(const std::uint32_t size, std::vector<field_t> fields) {
+        report_t result;
+        result.m_size = size;
+        result.m_cache_lines = (size + kCacheLineSize - 1) / kCacheLineSize;
+
+        // @note: the bigger of two fields at the same offset first, e.g. a union before its members
+        //
+        std::stable_sort(fields.begin(), fields.end(), [](const field_t& a, const field_t& b) {
+            return a.m_offset != b.m_offset ? a.m_offset < b.m_offset : a.m_size > b.m_size;
+        });
+
+        if (fields.empty()) {
+            result.m_fields = std::move(fields);
+            return result;
+        }
+
+        result.m_leading = std::min(fields.front().m_offset, size);
+
+        std::uint32_t cursor = result.m_leading;
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            const auto& field = fields[i];
+            if (const auto hole_end = std::min(field.m_offset, size); hole_end > cursor) {
+                result.m_holes.push_back({cursor, hole_end - cursor});
+                result.m_padding += hole_end - cursor;
+            }
+
+            std::uint32_t end = field.m_offset + field.m_size;
+            if (field.m_size == 0) {
+                // @note: up to the next field that starts after this one
+                //
+                end = size;
+                for (auto j = i + 1; j < fields.size(); ++j) {
+                    if (fields[j].m_offset > field.m_offset) {
+                        end = fields[j].m_offset;
+                        break;
+                    }
+                }
+            }
+
+            cursor = std::max(cursor, end);
+        }
+
+        if (size > cursor) {
+            result.m_tail_padding = size - cursor;
+            result.m_holes.push_back({cursor, result.m_tail_padding});
+            result.m_padding += result.m_tail_padding;
+        }
+
+        auto line_count = result.m_cache_lines;
+        for (const auto& field : fields)
+            line_count = std::max(line_count, field.last_line() + 1);
+
+        std::vector<bool> networked_lines(line_count);
+        for (const auto& field : fields) {
+            if (!field.m_networked)
+                continue;
+
+            for (auto line = field.first_line(); line <= field.last_line(); ++line)
+                networked_lines[line] = true;
+
+            if (field.first_line() != field.last_line())
+                ++result.m_straddling;
+        }
+
+        result.m_networked_lines = static_cast<std::uint32_t>(std::count(networked_lines.begin(), networked_lines.end(), true));
+        result.m_fields = std::move(fields);
+        return result;
+    }
+} // namespace layout
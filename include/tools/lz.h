@@ -0,0 +1,159 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Dependency free compressor producing the LZ4 block format: a sequence of
+// [token][literal length bytes][literals][16-bit offset][match length bytes],
+// so every block can also be decoded by stock LZ4 (LZ4_decompress_safe).
+namespace lz {
+    constexpr std::size_t kMinMatch = 4;
+    constexpr std::size_t kLastLiterals = 5; // @note: the format requires the last 5 bytes to be literals
+    constexpr std::size_t kMatchFindLimit = 12; // @note: and the last match to start 12 bytes before the end
+    constexpr std::size_t kMaxOffset = 65535;
+    constexpr std::uint32_t kHashBits = 16;
+
+    namespace detail {
+        inline std::uint32_t read32(const std::uint8_t* data) {
+            std::uint32_t result;
+            std::memcpy(&result, data, sizeof(result));
+            return result;
+        }
+
+        inline std::uint32_t hash(const std::uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - kHashBits);
+        }
+
+        inline void write_length(std::vector<std::uint8_t>& out, std::size_t length) {
+            while (length >= 255) {
+                out.push_back(255);
+                length -= 255;
+            }
+
+            out.push_back(static_cast<std::uint8_t>(length));
+        }
+
+        inline void write_sequence(std::vector<std::uint8_t>& out, const std::uint8_t* literals, const std::size_t literal_length,
+                                   const std::size_t offset, const std::size_t match_length) {
+            const auto literal_token = literal_length < 15 ? literal_length : 15;
+            const auto match_token = match_length == 0 ? 0 : (match_length - kMinMatch < 15 ? match_length - kMinMatch : 15);
+            out.push_back(static_cast<std::uint8_t>((literal_token << 4) | match_token));
+
+            if (literal_length >= 15)
+                write_length(out, literal_length - 15);
+            out.insert(out.end(), literals, literals + literal_length);
+
+            if (match_length == 0)
+                return; // @note: the last sequence only carries literals
+
+            out.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+            out.push_back(static_cast<std::uint8_t>(offset >> 8));
+            if (match_length - kMinMatch >= 15)
+                write_length(out, match_length - kMinMatch - 15);
+        }
+    } // namespace detail
+
+    // @note: appends the compressed form of `data` to `out`, greedy single-probe hash matching like LZ4's fast mode
+    //
+    inline void compress(const std::uint8_t* data, const std::size_t size, std::vector<std::uint8_t>& out) {
+        std::size_t anchor = 0;
+
+        if (size > kMatchFindLimit) {
+            std::vector<std::uint32_t> table(1u << kHashBits, 0);
+            const auto match_limit = size - kMatchFindLimit;
+            const auto extend_limit = size - kLastLiterals;
+
+            std::size_t pos = 1;
+            std::size_t misses = 0;
+            while (pos < match_limit) {
+                const auto sequence = detail::read32(data + pos);
+                const auto slot = detail::hash(sequence);
+                const std::size_t candidate = table[slot];
+                table[slot] = static_cast<std::uint32_t>(pos);
+
+                if (candidate >= pos || pos - candidate > kMaxOffset || detail::read32(data + candidate) != sequence) {
+                    pos += 1 + (misses++ >> 6); // @note: skip faster through data that doesn't compress
+                    continue;
+                }
+
+                misses = 0;
+
+                auto match_start = pos;
+                auto reference = candidate;
+                while (match_start > anchor && reference > 0 && data[match_start - 1] == data[reference - 1]) {
+                    --match_start;
+                    --reference;
+                }
+
+                auto match_end = pos + kMinMatch;
+                while (match_end < extend_limit && data[match_end] == data[reference + (match_end - match_start)])
+                    ++match_end;
+
+                detail::write_sequence(out, data + anchor, match_start - anchor, match_start - reference, match_end - match_start);
+
+                pos = anchor = match_end;
+                if (pos >= 2 && pos - 2 < match_limit)
+                    table[detail::hash(detail::read32(data + pos - 2))] = static_cast<std::uint32_t>(pos - 2);
+            }
+        }
+
+        detail::write_sequence(out, data + anchor, size - anchor, 0, 0);
+    }
+
+    // @note: `out_size` has to be the exact decompressed size, returns false on malformed input
+    //
+    inline bool decompress(const std::uint8_t* data, const std::size_t size, std::uint8_t* out, const std::size_t out_size) {
+        std::size_t in = 0, pos = 0;
+
+        const auto read_length = [&](std::size_t length) -> std::size_t {
+            if (length != 15)
+                return length;
+
+            std::uint8_t byte;
+            do {
+                if (in >= size)
+                    return SIZE_MAX;
+                byte = data[in++];
+                length += byte;
+            } while (byte == 255);
+
+            return length;
+        };
+
+        while (in < size) {
+            const auto token = data[in++];
+
+            const auto literal_length = read_length(token >> 4);
+            if (literal_length == SIZE_MAX || literal_length > size - in || literal_length > out_size - pos)
+                return false;
+
+            std::memcpy(out + pos, data + in, literal_length);
+            in += literal_length;
+            pos += literal_length;
+
+            if (in == size)
+                break; // @note: last sequence
+
+            if (size - in < 2)
+                return false;
+
+            const std::size_t offset = data[in] | (data[in + 1] << 8);
+            in += 2;
+
+            auto match_length = read_length(token & 0xF);
+            if (match_length == SIZE_MAX)
+                return false;
+            match_length += kMinMatch;
+
+            if (offset == 0 || offset > pos || match_length > out_size - pos)
+                return false;
+
+            // @note: byte by byte, the match may overlap the bytes it produces
+            //
+            for (std::size_t i = 0; i < match_length; ++i, ++pos)
+                out[pos] = out[pos - offset];
+        }
+
+        return pos == out_size;
+    }
+} // namespace lz
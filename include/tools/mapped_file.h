@@ -0,0 +1,111 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only memory mapping of a whole file.
+namespace mapped_file {
+    struct file_t {
+        file_t() = default;
+        file_t(const file_t&) = delete;
+        file_t& operator=(const file_t&) = delete;
+
+        file_t(file_t&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        file_t& operator=(file_t&& other) noexcept {
+            if (this != &other) {
+                close();
+                std::swap(_data, other._data);
+                std::swap(_size, other._size);
+            }
+
+            return *this;
+        }
+
+        ~file_t() {
+            close();
+        }
+
+        static file_t open(const std::filesystem::path& path) {
+            file_t result;
+#ifdef _WIN32
+            const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::runtime_error(std::format("{} : Unable to open '{}': {}", __FUNCTION__, path.string(), GetLastError()));
+
+            LARGE_INTEGER size = {};
+            GetFileSizeEx(file, &size);
+            result._size = static_cast<std::size_t>(size.QuadPart);
+
+            if (result._size != 0) {
+                const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping != nullptr) {
+                    result._data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    CloseHandle(mapping); // @note: the view keeps the mapping alive
+                }
+            }
+
+            CloseHandle(file);
+#else
+            const auto fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error(std::format("{} : Unable to open '{}': {}", __FUNCTION__, path.string(), errno));
+
+            struct stat info = {};
+            if (fstat(fd, &info) == 0)
+                result._size = static_cast<std::size_t>(info.st_size);
+
+            if (result._size != 0) {
+                result._data = mmap(nullptr, result._size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (result._data == MAP_FAILED)
+                    result._data = nullptr;
+            }
+
+            ::close(fd);
+#endif
+            if (result._size != 0 && result._data == nullptr)
+                throw std::runtime_error(std::format("{} : Unable to map '{}'", __FUNCTION__, path.string()));
+
+            return result;
+        }
+
+        void close() {
+            if (_data != nullptr) {
+#ifdef _WIN32
+                UnmapViewOfFile(_data);
+#else
+                munmap(_data, _size);
+#endif
+            }
+
+            _data = nullptr;
+            _size = 0;
+        }
+
+        [[nodiscard]] std::string_view view() const {
+            return {static_cast<const char*>(_data), _size};
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return _size;
+        }
+    private:
+        void* _data = nullptr;
+        std::size_t _size = 0;
+    };
+} // namespace mapped_file
@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "tools/codegen.h"
+
+// Records of -ndjson dumps, one compact json object per line, built from the fragments rendered for <scope>.json:
+//
+//     {"scope":"client","kind":"class","name":"C_BaseEntity","fields":[...],"metadata":[...]}
+//
+// A fragment is `"Name": {...},` as the generator writes it, so a record is the scope, kind and name followed by
+// the members of the fragment's object, compacted without the trailing commas.
+namespace ndjson {
+    inline void append_escaped(std::string& out, const std::string_view str) {
+        codegen::detail::escape_json_string(str, [&out](const char* data, const std::size_t size) { out.append(data, size); });
+    }
+
+    // @note: `str` as a json string, e.g. the scope name that every record of a scope repeats
+    //
+    inline std::string make_string_token(const std::string_view str) {
+        std::string result = "\"";
+        append_escaped(result, str);
+        result.push_back('"');
+        return result;
+    }
+
+    inline void append_record(std::string& out, const std::string_view scope_token, const std::string_view kind, const std::string_view name,
+                              const std::string_view fragment) {
+        out.append("{\"scope\":").append(scope_token).append(",\"kind\":\"").append(kind).append("\",\"name\":\"");
+
+        const auto name_begin = out.size();
+        append_escaped(out, name);
+        const auto escaped_name_size = out.size() - name_begin;
+        out.push_back('"');
+
+        // @note: the key is the escaped name in quotes, the name itself can hold any character
+        //
+        const auto key_end = fragment.find('"') + escaped_name_size + 2;
+        const auto body_begin = fragment.find('{', key_end);
+        const auto body_end = fragment.rfind('}');
+
+        const auto members_begin = out.size();
+        out.push_back(',');
+        codegen::append_compact_json(out, fragment.substr(body_begin + 1, body_end - body_begin - 1));
+        if (out.size() == members_begin + 1)
+            out.pop_back();
+
+        out.append("}\n");
+    }
+} // namespace ndjson
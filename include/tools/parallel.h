@@ -0,0 +1,61 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallel {
+    // @note: 0 means one worker per core
+    //
+    inline std::uint32_t get_thread_count(const std::uint32_t threads) {
+        return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // @note: calls `fn(order[i])` for every i on up to `threads` workers, the calling thread being one of them.
+    // items are handed out in `order`, so put the expensive ones first. the first exception stops handing out
+    // new items and is rethrown once every worker is done
+    //
+    template <typename Fn>
+    void for_each(const std::vector<std::size_t>& order, const std::uint32_t threads, Fn&& fn) {
+        std::atomic<std::size_t> next = 0;
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        const auto worker = [&]() {
+            for (auto i = next++; i < order.size(); i = next++) {
+                try {
+                    fn(order[i]);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error)
+                        error = std::current_exception();
+                    next = order.size();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::uint32_t i = 1; i < std::min<std::size_t>(get_thread_count(threads), order.size()); ++i)
+            workers.emplace_back(worker);
+
+        worker();
+        for (auto& thread : workers)
+            thread.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    template <typename Fn>
+    void for_each(const std::size_t count, const std::uint32_t threads, Fn&& fn) {
+        std::vector<std::size_t> order(count);
+        for (std::size_t i = 0; i < count; ++i)
+            order[i] = i;
+
+        for_each(order, threads, std::forward<Fn>(fn));
+    }
+} // namespace parallel
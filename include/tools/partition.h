@@ -0,0 +1,279 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+// Splits a dependency graph into partitions that can be processed in parallel.
+//
+// Nodes that depend on each other in a cycle (a strongly connected component) always end up in the same
+// partition. The components are layered by the longest chain of dependencies below them, so nothing depends
+// on anything of its own level, and runs of levels make up waves. A wave is split into at most `width`
+// partitions with no dependencies between them: components connected within the wave stay together and the
+// groups are spread over the partitions by weight. Partitions only depend on partitions of earlier waves, and
+// the heaviest chain of them stays close to the total weight over `width` as long as every wave is balanced.
+namespace partition {
+    constexpr double kMaxImbalance = 1.1; // a wave takes another level as long as its heaviest partition stays within this of the mean
+
+    struct graph_t {
+        std::vector<std::uint64_t> m_weights = {}; // per node
+        std::vector<std::vector<std::uint32_t>> m_edges = {}; // per node, the nodes it depends on
+    };
+
+    struct components_t {
+        std::vector<std::uint32_t> m_component = {}; // per node
+        std::uint32_t m_count = 0; // a component only depends on components with a lower index
+    };
+
+    struct result_t {
+        std::vector<std::uint32_t> m_partition = {}; // per node
+        std::vector<std::uint64_t> m_weights = {}; // per partition
+        std::vector<std::vector<std::uint32_t>> m_dependencies = {}; // per partition, the partitions it depends on, all with a lower index
+        std::uint32_t m_component_count = 0;
+        std::uint32_t m_wave_count = 0;
+        std::uint64_t m_critical_path = 0; // weight of the heaviest chain of dependent partitions
+
+        // @note: critical path over the total weight spread evenly over `width`, 1 is a perfect split
+        //
+        [[nodiscard]] double balance(const std::uint32_t width) const {
+            const auto total = std::accumulate(m_weights.begin(), m_weights.end(), std::uint64_t{0});
+            if (total == 0)
+                return 1.0;
+
+            return static_cast<double>(m_critical_path) * std::max<std::uint32_t>(width, 1) / total;
+        }
+    };
+
+    // @note: tarjan's algorithm without recursion, class hierarchies get deep enough to matter. it emits a component
+    // after everything reachable from it, which numbers the components in dependency order
+    //
+    inline components_t find_components(const graph_t& graph) {
+        constexpr std::uint32_t kUnvisited = 0xFFFFFFFF;
+
+        const auto node_count = static_cast<std::uint32_t>(graph.m_edges.size());
+
+        components_t result;
+        result.m_component.assign(node_count, kUnvisited);
+
+        std::vector<std::uint32_t> index(node_count, kUnvisited), low_link(node_count, 0);
+        std::vector<std::uint32_t> stack;
+        std::vector<bool> on_stack(node_count, false);
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> calls; // node, next edge
+        std::uint32_t next_index = 0;
+
+        for (std::uint32_t root = 0; root < node_count; ++root) {
+            if (index[root] != kUnvisited)
+                continue;
+
+            calls.push_back({root, 0});
+            while (!calls.empty()) {
+                auto& [node, edge] = calls.back();
+                if (edge == 0 && index[node] == kUnvisited) {
+                    index[node] = low_link[node] = next_index++;
+                    stack.push_back(node);
+                    on_stack[node] = true;
+                }
+
+                if (edge < graph.m_edges[node].size()) {
+                    const auto next = graph.m_edges[node][edge++];
+                    if (index[next] == kUnvisited)
+                        calls.push_back({next, 0});
+                    else if (on_stack[next])
+                        low_link[node] = std::min(low_link[node], index[next]);
+                    continue;
+                }
+
+                if (low_link[node] == index[node]) {
+                    std::uint32_t member;
+                    do {
+                        member = stack.back();
+                        stack.pop_back();
+                        on_stack[member] = false;
+                        result.m_component[member] = result.m_count;
+                    } while (member != node);
+
+                    ++result.m_count;
+                }
+
+                const auto finished = node;
+                calls.pop_back();
+                if (!calls.empty())
+                    low_link[calls.back().first] = std::min(low_link[calls.back().first], low_link[finished]);
+            }
+        }
+
+        return result;
+    }
+
+    namespace detail {
+        struct disjoint_set_t {
+            std::vector<std::uint32_t> m_parent = {};
+
+            std::uint32_t find(std::uint32_t x) {
+                while (m_parent[x] != x)
+                    x = m_parent[x] = m_parent[m_parent[x]];
+                return x;
+            }
+
+            void join(const std::uint32_t a, const std::uint32_t b) {
+                m_parent[find(a)] = find(b);
+            }
+        };
+
+        struct wave_t {
+            std::vector<std::uint32_t> m_bins = {}; // per component of the range
+            std::vector<std::uint64_t> m_weights = {}; // per bin
+        };
+
+        // @note: components of [first, last) in `by_level` that are connected by edges within the range end up in one group,
+        // the groups go to `width` bins largest first, each to the lightest bin. returns the bin of every component in the range
+        //
+        inline wave_t pack(const std::vector<std::uint32_t>& by_level, const std::size_t first, const std::size_t last,
+                           const std::vector<std::uint32_t>& slot, const std::vector<std::vector<std::uint32_t>>& edges,
+                           const std::vector<std::uint64_t>& weights, disjoint_set_t& groups, const std::uint32_t width) {
+            for (auto i = first; i < last; ++i)
+                groups.m_parent[slot[by_level[i]]] = slot[by_level[i]];
+
+            for (auto i = first; i < last; ++i) {
+                for (const auto dependency : edges[by_level[i]]) {
+                    if (slot[dependency] >= first && slot[dependency] < last)
+                        groups.join(slot[by_level[i]], slot[dependency]);
+                }
+            }
+
+            std::vector<std::pair<std::uint64_t, std::uint32_t>> roots; // weight, root slot
+            std::vector<std::uint64_t> group_weights(last - first, 0);
+            for (auto i = first; i < last; ++i)
+                group_weights[groups.find(slot[by_level[i]]) - first] += weights[by_level[i]];
+            for (auto i = first; i < last; ++i) {
+                if (groups.find(i) == i)
+                    roots.push_back({group_weights[i - first], static_cast<std::uint32_t>(i)});
+            }
+
+            std::sort(roots.begin(), roots.end(), [](const auto& a, const auto& b) { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+
+            wave_t result;
+            result.m_weights.assign(std::min<std::size_t>(width, roots.size()), 0);
+
+            std::vector<std::uint32_t> root_bins(last - first, 0);
+            for (const auto& [weight, root] : roots) {
+                const auto bin = static_cast<std::uint32_t>(std::min_element(result.m_weights.begin(), result.m_weights.end()) - result.m_weights.begin());
+                result.m_weights[bin] += weight;
+                root_bins[root - first] = bin;
+            }
+
+            result.m_bins.resize(last - first);
+            for (auto i = first; i < last; ++i)
+                result.m_bins[i - first] = root_bins[groups.find(i) - first];
+
+            return result;
+        }
+    } // namespace detail
+
+    // @note: `width` is how many partitions at most get processed at the same time
+    //
+    inline result_t split(const graph_t& graph, std::uint32_t width) {
+        width = std::max<std::uint32_t>(width, 1);
+
+        const auto components = find_components(graph);
+
+        std::vector<std::uint64_t> component_weights(components.m_count, 0);
+        std::vector<std::vector<std::uint32_t>> component_edges(components.m_count);
+        for (std::uint32_t node = 0; node < graph.m_edges.size(); ++node) {
+            const auto component = components.m_component[node];
+            component_weights[component] += graph.m_weights[node];
+            for (const auto dependency : graph.m_edges[node]) {
+                if (components.m_component[dependency] != component)
+                    component_edges[component].push_back(components.m_component[dependency]);
+            }
+        }
+
+        // @note: a component's level is one above its highest dependency, nothing depends on anything of the same level
+        //
+        std::vector<std::uint32_t> levels(components.m_count, 0);
+        std::uint32_t level_count = 0;
+        for (std::uint32_t component = 0; component < components.m_count; ++component) {
+            for (const auto dependency : component_edges[component])
+                levels[component] = std::max(levels[component], levels[dependency] + 1);
+            level_count = std::max(level_count, levels[component] + 1);
+        }
+
+        std::vector<std::uint32_t> by_level(components.m_count);
+        std::iota(by_level.begin(), by_level.end(), 0);
+        std::stable_sort(by_level.begin(), by_level.end(), [&](const std::uint32_t a, const std::uint32_t b) { return levels[a] < levels[b]; });
+
+        std::vector<std::uint32_t> level_ends(level_count, 0);
+        std::vector<std::uint32_t> slot(components.m_count, 0);
+        for (std::uint32_t i = 0; i < by_level.size(); ++i) {
+            slot[by_level[i]] = i;
+            level_ends[levels[by_level[i]]] = i + 1;
+        }
+
+        detail::disjoint_set_t groups;
+        groups.m_parent.resize(components.m_count);
+
+        const auto is_balanced = [&](const detail::wave_t& wave) {
+            const auto total = std::accumulate(wave.m_weights.begin(), wave.m_weights.end(), std::uint64_t{0});
+            return static_cast<double>(*std::max_element(wave.m_weights.begin(), wave.m_weights.end())) <= static_cast<double>(total) / width * kMaxImbalance;
+        };
+
+        // @note: a wave is a run of levels split into up to `width` independent partitions, it takes levels for as long as
+        // the types it holds still spread evenly, a single level always does. every partition only depends on earlier waves
+        //
+        result_t result;
+        std::vector<std::uint32_t> placement(components.m_count, 0);
+        for (std::uint32_t first_level = 0; first_level < level_count;) {
+            const auto first = first_level != 0 ? level_ends[first_level - 1] : 0;
+
+            // @note: a single partition is balanced whatever it holds, it takes every level at once instead of re-packing
+            // a wave that grows by one level at a time
+            //
+            auto last_level = width == 1 ? level_count - 1 : first_level;
+            auto wave = detail::pack(by_level, first, level_ends[last_level], slot, component_edges, component_weights, groups, width);
+            while (last_level + 1 < level_count) {
+                auto wider = detail::pack(by_level, first, level_ends[last_level + 1], slot, component_edges, component_weights, groups, width);
+                if (!is_balanced(wider))
+                    break;
+
+                wave = std::move(wider);
+                ++last_level;
+            }
+
+            const auto base = static_cast<std::uint32_t>(result.m_weights.size());
+            result.m_weights.insert(result.m_weights.end(), wave.m_weights.begin(), wave.m_weights.end());
+            for (auto i = first; i < level_ends[last_level]; ++i)
+                placement[by_level[i]] = base + wave.m_bins[i - first];
+
+            ++result.m_wave_count;
+            first_level = last_level + 1;
+        }
+
+        result.m_component_count = components.m_count;
+        result.m_dependencies.resize(result.m_weights.size());
+
+        result.m_partition.resize(graph.m_edges.size());
+        for (std::uint32_t node = 0; node < graph.m_edges.size(); ++node)
+            result.m_partition[node] = placement[components.m_component[node]];
+
+        for (std::uint32_t component = 0; component < components.m_count; ++component) {
+            for (const auto dependency : component_edges[component]) {
+                if (placement[dependency] != placement[component])
+                    result.m_dependencies[placement[component]].push_back(placement[dependency]);
+            }
+        }
+
+        std::vector<std::uint64_t> finish(result.m_weights.size(), 0);
+        for (std::uint32_t i = 0; i < result.m_weights.size(); ++i) {
+            auto& dependencies = result.m_dependencies[i];
+            std::sort(dependencies.begin(), dependencies.end());
+            dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+
+            for (const auto dependency : dependencies)
+                finish[i] = std::max(finish[i], finish[dependency]);
+            finish[i] += result.m_weights[i];
+            result.m_critical_path = std::max(result.m_critical_path, finish[i]);
+        }
+
+        return result;
+    }
+} // namespace partition
@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// Minimal perfect hash over precomputed 64-bit key hashes (hash and displace).
+//
+// Keys are split into buckets by `hash % bucket_count`, every bucket gets a displacement `d` picked so that
+// `slot(hash, d)` lands all of its keys on free slots. A lookup is then one table read and a couple of
+// multiplies on top of the key hash, and the slots form a permutation of [0, key_count).
+namespace perfect_hash {
+    constexpr std::uint32_t kKeysPerBucket = 4;
+    constexpr std::uint32_t kMaxDisplacement = 1u << 24;
+
+    // @note: splitmix64 finalizer, spreads `hash ^ displacement` over all bits before the modulo
+    //
+    constexpr std::uint64_t mix(std::uint64_t value) {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ull;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebull;
+        value ^= value >> 31;
+        return value;
+    }
+
+    constexpr std::uint32_t bucket(const std::uint64_t hash, const std::uint32_t bucket_count) {
+        return static_cast<std::uint32_t>(hash % bucket_count);
+    }
+
+    constexpr std::uint32_t slot(const std::uint64_t hash, const std::uint32_t displacement, const std::uint32_t key_count) {
+        return static_cast<std::uint32_t>(mix(hash ^ displacement) % key_count);
+    }
+
+    struct table_t {
+        std::vector<std::uint32_t> m_displacements = {}; // per bucket
+        std::vector<std::uint32_t> m_keys = {}; // key index stored at each slot
+    };
+
+    inline table_t build(const std::vector<std::uint64_t>& hashes) {
+        table_t result;
+
+        const auto key_count = static_cast<std::uint32_t>(hashes.size());
+        if (key_count == 0)
+            return result;
+
+        std::vector<std::uint64_t> sorted_hashes = hashes;
+        std::sort(sorted_hashes.begin(), sorted_hashes.end());
+        if (const auto it = std::adjacent_find(sorted_hashes.begin(), sorted_hashes.end()); it != sorted_hashes.end())
+            throw std::runtime_error(std::format("{} : Duplicate key hash {:016x}", __FUNCTION__, *it));
+
+        const auto bucket_count = std::max<std::uint32_t>(1, key_count / kKeysPerBucket);
+        result.m_displacements.assign(bucket_count, 0);
+        result.m_keys.assign(key_count, 0);
+
+        std::vector<std::vector<std::uint32_t>> buckets(bucket_count);
+        for (std::uint32_t i = 0; i < key_count; ++i)
+            buckets[bucket(hashes[i], bucket_count)].push_back(i);
+
+        // @note: place the biggest buckets first while the table is still mostly empty
+        //
+        std::vector<std::uint32_t> order(bucket_count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](const std::uint32_t a, const std::uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+        std::vector<bool> taken(key_count, false);
+        std::vector<std::uint32_t> slots;
+
+        for (const auto bucket_index : order) {
+            const auto& keys = buckets[bucket_index];
+            if (keys.empty())
+                break;
+
+            bool placed = false;
+            for (std::uint32_t displacement = 0; displacement < kMaxDisplacement && !placed; ++displacement) {
+                slots.clear();
+
+                placed = true;
+                for (const auto key : keys) {
+                    const auto key_slot = slot(hashes[key], displacement, key_count);
+                    if (taken[key_slot] || std::find(slots.begin(), slots.end(), key_slot) != slots.end()) {
+                        placed = false;
+                        break;
+                    }
+
+                    slots.push_back(key_slot);
+                }
+
+                if (!placed)
+                    continue;
+
+                result.m_displacements[bucket_index] = displacement;
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    taken[slots[i]] = true;
+                    result.m_keys[slots[i]] = keys[i];
+                }
+            }
+
+            if (!placed)
+                throw std::runtime_error(std::format("{} : Unable to place bucket {} ({} keys)", __FUNCTION__, bucket_index, keys.size()));
+        }
+
+        return result;
+    }
+} // namespace perfect_hash
@@ -0,0 +1,117 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Finds the type scopes that are worth dumping again while modules keep loading.
+//
+// The caller lists every scope with its binding counts and a fingerprint of its types on each poll, nothing
+// here touches the engine, so the logic can be driven by a stand-in outside of the game. A module registers
+// its types over a while, so a new or changed scope is only reported once it looked the same for
+// `settle_polls` polls in a row, and then only if it differs from what got reported last time.
+namespace scope_watcher {
+    struct scope_state_t {
+        std::string m_name = "";
+        std::size_t m_class_count = 0;
+        std::size_t m_enum_count = 0;
+        std::uint64_t m_fingerprint = 0; // see fingerprint_t
+
+        [[nodiscard]] bool operator==(const scope_state_t&) const = default;
+    };
+
+    // @note: bindings live in hash tables, so the fingerprint doesn't depend on the order the types are added in
+    //
+    struct fingerprint_t {
+        std::uint64_t m_value = 0;
+
+        fingerprint_t& add(const std::uint64_t a, const std::uint64_t b) {
+            m_value += mix(a ^ mix(b));
+            return *this;
+        }
+
+    private:
+        // @note: splitmix64 finalizer, neighbouring pointers must not cancel out in the sum
+        //
+        static constexpr std::uint64_t mix(std::uint64_t value) {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+    };
+
+    struct changes_t {
+        std::vector<std::string> m_dirty = {}; // new or changed since they were last reported, by name
+        std::vector<std::string> m_removed = {}; // reported before and gone now, by name
+    };
+
+    struct watcher_t {
+        explicit watcher_t(const std::uint32_t settle_polls = 1): _settle_polls(settle_polls) { }
+
+        changes_t poll(const std::vector<scope_state_t>& scopes) {
+            changes_t result;
+
+            for (auto& [name, entry] : _scopes)
+                entry.m_present = false;
+
+            for (const auto& state : scopes) {
+                auto& entry = _scopes[state.m_name];
+                entry.m_present = true;
+
+                if (entry.m_stable_polls == kUnseen || !(entry.m_seen == state)) {
+                    entry.m_seen = state;
+                    entry.m_stable_polls = 0;
+                } else if (entry.m_stable_polls < _settle_polls) {
+                    ++entry.m_stable_polls;
+                }
+
+                if (entry.m_stable_polls >= _settle_polls && !(entry.m_reported && entry.m_last_reported == state)) {
+                    entry.m_reported = true;
+                    entry.m_last_reported = state;
+                    result.m_dirty.push_back(state.m_name);
+                }
+            }
+
+            for (auto it = _scopes.begin(); it != _scopes.end();) {
+                if (it->second.m_present) {
+                    ++it;
+                    continue;
+                }
+
+                if (it->second.m_reported)
+                    result.m_removed.push_back(it->first);
+                it = _scopes.erase(it);
+            }
+
+            std::sort(result.m_dirty.begin(), result.m_dirty.end());
+            return result;
+        }
+
+        // @note: reports `names` again once they are settled, e.g. after dumping them failed
+        //
+        void retry(const std::vector<std::string>& names) {
+            for (const auto& name : names) {
+                if (const auto it = _scopes.find(name); it != _scopes.end())
+                    it->second.m_reported = false;
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return _scopes.size();
+        }
+    private:
+        static constexpr std::uint32_t kUnseen = 0xFFFFFFFF;
+
+        struct entry_t {
+            scope_state_t m_seen = {};
+            scope_state_t m_last_reported = {};
+            std::uint32_t m_stable_polls = kUnseen;
+            bool m_reported = false;
+            bool m_present = false;
+        };
+
+        std::uint32_t _settle_polls = 1;
+        std::map<std::string, entry_t> _scopes = {};
+    };
+} // namespace scope_watcher
@@ -0,0 +1,185 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Named shared memory segments, Win32 file mappings or POSIX shm objects.
+namespace shared_memory {
+    struct mapping_t {
+        mapping_t() = default;
+        mapping_t(const mapping_t&) = delete;
+        mapping_t& operator=(const mapping_t&) = delete;
+
+        mapping_t(mapping_t&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        mapping_t& operator=(mapping_t&& other) noexcept {
+            if (this != &other) {
+                close();
+                std::swap(_data, other._data);
+                std::swap(_size, other._size);
+#ifdef _WIN32
+                std::swap(_handle, other._handle);
+#endif
+            }
+
+            return *this;
+        }
+
+        ~mapping_t() {
+            close();
+        }
+
+        // @note: creates a segment of `size` bytes, or maps an existing one with the same name read/write at the size
+        // it already has. readers can have it mapped, they would fault past the end of a shrunk segment and never see
+        // a grown one, so size() can differ from `size`
+        //
+        static mapping_t create(const std::string_view name, const std::size_t size) {
+            mapping_t result;
+#ifdef _WIN32
+            result._handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                                static_cast<DWORD>(size & 0xFFFFFFFF), std::string(name).c_str());
+            if (result._handle == nullptr)
+                throw std::runtime_error(std::format("{} : CreateFileMapping '{}' failed: {}", __FUNCTION__, name, GetLastError()));
+
+            const auto existed = GetLastError() == ERROR_ALREADY_EXISTS;
+            result._data = MapViewOfFile(result._handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+            result._size = size;
+            if (result._data != nullptr && existed) {
+                MEMORY_BASIC_INFORMATION info = {};
+                VirtualQuery(result._data, &info, sizeof(info));
+                result._size = info.RegionSize;
+            }
+#else
+            const auto path = get_posix_name(name);
+            const auto fd = shm_open(path.c_str(), O_CREAT | O_RDWR, 0644);
+            if (fd < 0)
+                throw std::runtime_error(std::format("{} : shm_open '{}' failed: {}", __FUNCTION__, path, errno));
+
+            struct stat info = {};
+            if (fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw std::runtime_error(std::format("{} : fstat '{}' failed: {}", __FUNCTION__, path, errno));
+            }
+
+            // @note: a segment is empty until its creator sized it, nobody can have mapped anything of it yet
+            //
+            result._size = info.st_size > 0 ? static_cast<std::size_t>(info.st_size) : size;
+            if (info.st_size == 0 && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                ::close(fd);
+                throw std::runtime_error(std::format("{} : ftruncate '{}' failed: {}", __FUNCTION__, path, errno));
+            }
+
+            result._data = mmap(nullptr, result._size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (result._data == MAP_FAILED)
+                result._data = nullptr;
+#endif
+            if (result._data == nullptr)
+                throw std::runtime_error(std::format("{} : Unable to map '{}'", __FUNCTION__, name));
+
+            return result;
+        }
+
+        // @note: maps an existing segment read-only, returns an unmapped mapping_t if there is none
+        //
+        static mapping_t open(const std::string_view name) {
+            mapping_t result;
+#ifdef _WIN32
+            result._handle = OpenFileMappingA(FILE_MAP_READ, FALSE, std::string(name).c_str());
+            if (result._handle == nullptr)
+                return result;
+
+            result._data = MapViewOfFile(result._handle, FILE_MAP_READ, 0, 0, 0);
+            if (result._data != nullptr) {
+                MEMORY_BASIC_INFORMATION info = {};
+                VirtualQuery(result._data, &info, sizeof(info));
+                result._size = info.RegionSize;
+            }
+#else
+            const auto fd = shm_open(get_posix_name(name).c_str(), O_RDONLY, 0);
+            if (fd < 0)
+                return result;
+
+            struct stat info = {};
+            if (fstat(fd, &info) == 0 && info.st_size > 0) {
+                result._size = static_cast<std::size_t>(info.st_size);
+                result._data = mmap(nullptr, result._size, PROT_READ, MAP_SHARED, fd, 0);
+                if (result._data == MAP_FAILED)
+                    result._data = nullptr;
+            }
+
+            ::close(fd);
+#endif
+            if (result._data == nullptr)
+                result._size = 0;
+
+            return result;
+        }
+
+        // @note: POSIX segments outlive their processes, Win32 ones go away with the last handle
+        //
+        static void remove(const std::string_view name) {
+#ifndef _WIN32
+            shm_unlink(get_posix_name(name).c_str());
+#endif
+        }
+
+        void close() {
+            if (_data != nullptr) {
+#ifdef _WIN32
+                UnmapViewOfFile(_data);
+#else
+                munmap(_data, _size);
+#endif
+            }
+
+#ifdef _WIN32
+            if (_handle != nullptr)
+                CloseHandle(_handle);
+            _handle = nullptr;
+#endif
+            _data = nullptr;
+            _size = 0;
+        }
+
+        [[nodiscard]] bool is_open() const {
+            return _data != nullptr;
+        }
+
+        [[nodiscard]] void* data() const {
+            return _data;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return _size;
+        }
+    private:
+#ifndef _WIN32
+        static std::string get_posix_name(const std::string_view name) {
+            return name.starts_with('/') ? std::string(name) : std::format("/{}", name);
+        }
+#endif
+
+        void* _data = nullptr;
+        std::size_t _size = 0;
+#ifdef _WIN32
+        HANDLE _handle = nullptr;
+#endif
+    };
+} // namespace shared_memory
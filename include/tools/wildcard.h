@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wildcard {
+    // @note: glob style match, `*` matches any run of characters and `?` a single one
+    //
+    inline bool match(const std::string_view pattern, const std::string_view str) {
+        std::size_t p = 0, s = 0;
+        std::size_t star = std::string_view::npos, star_s = 0;
+
+        while (s < str.size()) {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s])) {
+                ++p;
+                ++s;
+            } else if (p < pattern.size() && pattern[p] == '*') {
+                star = p++;
+                star_s = s;
+            } else if (star != std::string_view::npos) {
+                p = star + 1;
+                s = ++star_s;
+            } else {
+                return false;
+            }
+        }
+
+        while (p < pattern.size() && pattern[p] == '*')
+            ++p;
+
+        return p == pattern.size();
+    }
+
+    inline bool match_any(const std::vector<std::string>& patterns, const std::string_view str) {
+        for (const auto& pattern : patterns) {
+            if (match(pattern, str))
+                return true;
+        }
+
+        return false;
+    }
+
+    // @note: erases the items whose `get_name(item)` matches none of `patterns`, returns how many were erased
+    //
+    template <typename T, typename GetName>
+    std::size_t erase_unmatched(std::vector<T>& items, const std::vector<std::string>& patterns, GetName&& get_name) {
+        return std::erase_if(items, [&](const T& item) { return !match_any(patterns, get_name(item)); });
+    }
+
+    // @note: splits a comma separated option value, e.g. `CCSPlayerPawn,C*Weapon*`
+    //
+    inline std::vector<std::string> split_list(const std::string_view list) {
+        std::vector<std::string> result;
+
+        std::size_t start = 0;
+        while (start <= list.size()) {
+            auto end = list.find(',', start);
+            if (end == std::string_view::npos)
+                end = list.size();
+
+            if (end != start)
+                result.emplace_back(list.substr(start, end - start));
+
+            start = end + 1;
+        }
+
+        return result;
+    }
+} // namespace wildcard
@@ -1,18 +1,243 @@
+#include <algorithm>
+#include <chrono>
 #include <map>
+#include <numeric>
+#include <optional>
 #include <string>
 #include <sstream>
 #include <fstream>
 #include <vector>
 #include "sdk/sdk.h"
+#include "tools/headless.h"
+#include "tools/parallel.h"
+#include "tools/scope_watcher.h"
+#include "tools/wildcard.h"
 
-void SchemaDumpAll(const char* outDirName)
+extern void SchemaPublishIndex(const std::string& name, const std::vector<sdk::scope_snapshot_t>& snapshots);
+
+// Calls `fn(snapshot_index)` for every snapshot on up to `threads` workers (0 = one per core). Biggest scopes are
+// handed out first so one large scope doesn't end up alone at the tail, the first exception is rethrown here.
+template <typename Fn>
+static void ForEachSnapshot(const std::vector<sdk::scope_snapshot_t>& snapshots, std::uint32_t threads, Fn&& fn)
+{
+    std::vector<std::size_t> order(snapshots.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return snapshots[a].m_classes.size() + snapshots[a].m_enums.size() > snapshots[b].m_classes.size() + snapshots[b].m_enums.size();
+    });
+
+    parallel::for_each(order, threads, std::forward<Fn>(fn));
+}
+
+// Only copies the binding lists, so this is cheap enough to run on the game thread. The snapshots keep pointing
+// at the schema system's class/enum infos, which stay alive for as long as their modules are loaded.
+// Scopes not selected by -scopes aren't visited at all, the result is empty if none of them is loaded (yet).
+std::vector<sdk::scope_snapshot_t> SchemaSnapshotSelected(const sdk::dump_options_t& options)
 {
     const auto schemaSystem = (CSchemaSystem*)g_pSchemaSystem;
 
+    const auto is_selected = [&](CSchemaSystemTypeScope* scope) {
+        return options.m_scope_patterns.empty() || wildcard::match_any(options.m_scope_patterns, sdk::GetTypeScopeName(scope));
+    };
+
+    std::vector<sdk::scope_snapshot_t> snapshots;
+
     const auto& type_scopes = schemaSystem->m_TypeScopes;
     for (auto i = 0; i < type_scopes.GetNumStrings(); ++i) {
-        sdk::GenerateTypeScopeSdk(type_scopes[i], outDirName);
+        if (is_selected(type_scopes[i])) {
+            snapshots.push_back(sdk::SnapshotTypeScope(type_scopes[i]));
+        }
+    }
+
+    if (is_selected(schemaSystem->GlobalTypeScope())) {
+        snapshots.push_back(sdk::SnapshotTypeScope(schemaSystem->GlobalTypeScope()));
     }
 
-    sdk::GenerateTypeScopeSdk(schemaSystem->GlobalTypeScope(), outDirName);
+    return snapshots;
+}
+
+// Names and binding counts of every registered type scope, without copying any bindings.
+headless::scopes_t SchemaGetScopes()
+{
+    const auto schemaSystem = (CSchemaSystem*)g_pSchemaSystem;
+
+    headless::scopes_t scopes;
+    scope_watcher::fingerprint_t fingerprint;
+    const auto add = [&](CSchemaSystemTypeScope* scope) {
+        auto name = sdk::GetTypeScopeName(scope);
+        fingerprint.add(fnv64::hash_runtime(name.c_str()),
+                        static_cast<std::uint32_t>(scope->m_ClassBindings.Count()) | static_cast<std::uint64_t>(scope->m_EnumBindings.Count()) << 32);
+        scopes.m_names.push_back(std::move(name));
+    };
+
+    const auto& type_scopes = schemaSystem->m_TypeScopes;
+    for (auto i = 0; i < type_scopes.GetNumStrings(); ++i) {
+        add(type_scopes[i]);
+    }
+
+    add(schemaSystem->GlobalTypeScope());
+
+    scopes.m_fingerprint = fingerprint.m_value;
+    return scopes;
+}
+
+std::vector<sdk::scope_snapshot_t> SchemaSnapshotAll(const sdk::dump_options_t& options)
+{
+    auto snapshots = SchemaSnapshotSelected(options);
+    if (snapshots.empty()) {
+        throw std::runtime_error(std::format("{} : No type scope matches -scopes", __FUNCTION__));
+    }
+
+    return snapshots;
+}
+
+// Renders and writes the snapshots, safe to call from any thread. `progress` may be null.
+void SchemaDumpSnapshots(std::vector<sdk::scope_snapshot_t> snapshots, const char* outDirName, const sdk::dump_options_t& options,
+                         sdk::dump_progress_t* progress)
+{
+    if (options.m_deduplicate && options.m_shard_mode != sdk::shard_mode_t::kNone) {
+        throw std::runtime_error(std::format("{} : -shards can't be combined with -dedup", __FUNCTION__));
+    }
+
+    if (options.m_compress_block_size != 0 && (options.m_deduplicate || options.m_shard_mode != sdk::shard_mode_t::kNone)) {
+        throw std::runtime_error(std::format("{} : -compress only applies to whole scope files, not to -dedup or -shards", __FUNCTION__));
+    }
+
+    if (options.m_ndjson && (options.m_deduplicate || options.m_shard_mode != sdk::shard_mode_t::kNone || options.m_compress_block_size != 0 || options.m_dump_index)) {
+        throw std::runtime_error(std::format("{} : -ndjson replaces the scope files, it can't be combined with -dedup, -shards, -compress or -idx", __FUNCTION__));
+    }
+
+    if (!options.m_archive_build.empty() && (options.m_ndjson || options.m_deduplicate || options.m_shard_mode != sdk::shard_mode_t::kNone ||
+                                             options.m_compress_block_size != 0 || options.m_dump_index || options.m_network_decode_plans ||
+                                             options.m_lookup_tables || options.m_enum_tables ||
+                                             options.m_layout_report != sdk::layout_report_t::kNone || options.m_size_report)) {
+        throw std::runtime_error(std::format("{} : -archive only stores the json, it can't be combined with other outputs", __FUNCTION__));
+    }
+
+    if (!options.m_root_patterns.empty()) {
+        // @note: with -classes the matches are roots as well, filtering them first would drop the types they depend on
+        //
+        auto roots = options.m_root_patterns;
+        roots.insert(roots.end(), options.m_class_patterns.begin(), options.m_class_patterns.end());
+
+        const auto stats = sdk::PruneUnreachableTypes(snapshots, roots);
+        Msg("%s: Kept %zu classes (pruned %zu) and %zu enums (pruned %zu) reachable from the roots\n", __FUNCTION__, stats.m_kept_classes,
+            stats.m_pruned_classes, stats.m_kept_enums, stats.m_pruned_enums);
+    } else if (!options.m_class_patterns.empty()) {
+        const auto stats = sdk::FilterTypes(snapshots, options.m_class_patterns);
+        Msg("%s: Kept %zu classes (filtered %zu) and %zu enums (filtered %zu) matching -classes\n", __FUNCTION__, stats.m_kept_classes,
+            stats.m_pruned_classes, stats.m_kept_enums, stats.m_pruned_enums);
+    }
+
+    // @note: don't overwrite the files of scopes that have nothing selected with empty ones
+    //
+    if (!options.m_class_patterns.empty()) {
+        std::erase_if(snapshots, [](const sdk::scope_snapshot_t& snapshot) { return snapshot.m_classes.empty() && snapshot.m_enums.empty(); });
+    }
+
+    std::optional<ids::registry_t> registry;
+    if (!options.m_id_registry_path.empty()) {
+        registry.emplace();
+        registry->load(options.m_id_registry_path);
+
+        const auto assigned = sdk::RegisterTypeIds(*registry, snapshots);
+        registry->save(options.m_id_registry_path);
+        Msg("%s: Assigned %zu new ids (%zu classes, %zu fields, %zu enums in the registry)\n", __FUNCTION__, assigned,
+            registry->size(ids::kind_t::kClass), registry->size(ids::kind_t::kField), registry->size(ids::kind_t::kEnum));
+    }
+
+    const auto ids = registry ? &*registry : nullptr;
+
+    if (!options.m_shared_memory_name.empty()) {
+        SchemaPublishIndex(options.m_shared_memory_name, snapshots);
+    }
+
+    if (progress) {
+        progress->m_total = snapshots.size();
+    }
+
+    if (!options.m_archive_build.empty()) {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<sdk::rendered_scope_t> rendered(snapshots.size());
+        ForEachSnapshot(snapshots, options.m_threads, [&](std::size_t i) {
+            if (progress && progress->m_cancel_requested) {
+                return;
+            }
+
+            rendered[i] = sdk::RenderTypeScope(snapshots[i], ids);
+            if (progress) {
+                ++progress->m_done;
+            }
+        });
+
+        if (progress && progress->m_cancel_requested) {
+            return;
+        }
+
+        const auto stats = sdk::IngestArchiveBuild(rendered, outDirName, options.m_archive_build, options.m_threads);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        Msg("%s: Archived build %s, %zu of %zu types were new (%zu bytes written) in %lld ms\n", __FUNCTION__, options.m_archive_build.c_str(),
+            stats.m_new_objects, stats.m_types, stats.m_bytes_written, (long long)elapsed.count());
+        return;
+    }
+
+    if (options.m_deduplicate) {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<sdk::rendered_scope_t> rendered(snapshots.size());
+        ForEachSnapshot(snapshots, options.m_threads, [&](std::size_t i) {
+            if (progress && progress->m_cancel_requested) {
+                return;
+            }
+
+            sdk::size_report_t sizes;
+            rendered[i] = sdk::RenderTypeScope(snapshots[i], ids, options.m_size_report ? &sizes : nullptr);
+            if (options.m_size_report) {
+                sdk::WriteSizeReport(sizes, std::format("{}\\{}.sizes.json", outDirName, snapshots[i].m_name));
+            }
+
+            if (progress) {
+                ++progress->m_done;
+            }
+        });
+
+        if (progress && progress->m_cancel_requested) {
+            return;
+        }
+
+        const auto stats = sdk::WriteDeduplicatedScopes(rendered, outDirName, options);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        Msg("%s: %zu classes and %zu enums shared between scopes, wrote %zu bytes instead of %zu (%.1f%% saved) in %lld ms\n", __FUNCTION__,
+            stats.m_shared_classes, stats.m_shared_enums, stats.m_bytes_written, stats.m_bytes_per_scope,
+            stats.m_bytes_per_scope ? 100.0 * (1.0 - (double)stats.m_bytes_written / (double)stats.m_bytes_per_scope) : 0.0,
+            (long long)elapsed.count());
+
+        ForEachSnapshot(snapshots, options.m_threads, [&](std::size_t i) {
+            if (progress && progress->m_cancel_requested) {
+                return;
+            }
+
+            sdk::WriteScopeExtras(snapshots[i], outDirName, options, ids);
+        });
+
+        return;
+    }
+
+    ForEachSnapshot(snapshots, options.m_threads, [&](std::size_t i) {
+        if (progress && progress->m_cancel_requested) {
+            return;
+        }
+
+        sdk::GenerateTypeScopeSdk(snapshots[i], outDirName, options, ids);
+        if (progress) {
+            const auto done = ++progress->m_done;
+            Msg("SchemaDumpSnapshots: Dumped %s (%zu/%zu)\n", snapshots[i].m_name.c_str(), done, snapshots.size());
+        }
+    });
+}
+
+void SchemaDumpAll(const char* outDirName, const sdk::dump_options_t& options)
+{
+    SchemaDumpSnapshots(SchemaSnapshotAll(options), outDirName, options, nullptr);
 }
@@ -0,0 +1,58 @@
+#include <string>
+#include <vector>
+#include "sdk/sdk.h"
+#include "tools/background_job.h"
+
+extern std::vector<sdk::scope_snapshot_t> SchemaSnapshotAll(const sdk::dump_options_t& options);
+extern void SchemaDumpSnapshots(std::vector<sdk::scope_snapshot_t> snapshots, const char* outDirName, const sdk::dump_options_t& options,
+                                sdk::dump_progress_t* progress);
+
+namespace {
+    // A single schema_dump_all -async at a time. The snapshot is taken on the calling thread, everything
+    // else happens on the worker so the server keeps ticking while the dump is rendered and written.
+    background_job::job_t g_BackgroundDump;
+} // namespace
+
+bool SchemaDumpAllAsync(const char* outDirName, const sdk::dump_options_t& options)
+{
+    if (g_BackgroundDump.running()) {
+        return false;
+    }
+
+    auto snapshots = SchemaSnapshotAll(options);
+    const auto total = snapshots.size();
+
+    auto work = [snapshots = std::move(snapshots), outDirName = std::string(outDirName), options](sdk::dump_progress_t& progress) mutable {
+        SchemaDumpSnapshots(std::move(snapshots), outDirName.c_str(), options, &progress);
+
+        if (progress.m_cancel_requested) {
+            Msg("SchemaDumpAllAsync: Cancelled after %zu/%zu scopes\n", progress.m_done.load(), progress.m_total.load());
+        } else {
+            Msg("SchemaDumpAllAsync: Dumped all schemas in %lld ms\n", g_BackgroundDump.elapsed_milliseconds());
+        }
+    };
+
+    return g_BackgroundDump.start(total, std::move(work), [](const std::string& error) { Warning("SchemaDumpAllAsync: Error: %s\n", error.c_str()); });
+}
+
+void SchemaDumpStatus()
+{
+    if (!g_BackgroundDump.running()) {
+        const auto failure = g_BackgroundDump.failure();
+        if (failure.empty()) {
+            Msg("SchemaDumpStatus: No dump in progress\n");
+        } else {
+            Msg("SchemaDumpStatus: No dump in progress, the last one failed: %s\n", failure.c_str());
+        }
+        return;
+    }
+
+    const auto& progress = g_BackgroundDump.progress();
+    Msg("SchemaDumpStatus: %zu/%zu scopes done, running for %lld ms%s\n", progress.m_done.load(), progress.m_total.load(),
+        g_BackgroundDump.elapsed_milliseconds(), progress.m_cancel_requested ? " (cancelling)" : "");
+}
+
+bool SchemaDumpCancel()
+{
+    return g_BackgroundDump.cancel();
+}
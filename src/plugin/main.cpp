@@ -3,12 +3,62 @@
 #include "icvar.h"
 #include <stdexcept>
 #include <format>
+#include "sdk/schema_capture.h"
+#include "sdk/schema_index.h"
+#include "sdk/sdk.h"
+#include "tools/headless.h"
+#include "tools/wildcard.h"
 
 ICvar* g_pCVar = NULL;
 ISchemaSystem* g_pSchemaSystem = NULL;
 CreateInterfaceFn g_pfnServerCreateInterface = NULL;
 
-extern void SchemaDumpAll(const char* outDirName);
+extern void SchemaDumpAll(const char* outDirName, const sdk::dump_options_t& options);
+extern bool SchemaDumpAllAsync(const char* outDirName, const sdk::dump_options_t& options);
+extern void SchemaDumpStatus();
+extern bool SchemaDumpCancel();
+extern ISchemaGenIndex* GetSchemaGenIndex();
+extern void SchemaIndexRebuild();
+extern bool SchemaWatchStart(const char* outDirName, const sdk::dump_options_t& options);
+extern bool SchemaWatchStop();
+extern void SchemaWatchStatus();
+extern headless::scopes_t SchemaGetScopes();
+
+// Launching with `-schemadump <output path>` dumps every scope on all cores once the modules stopped registering
+// type scopes (and every scope listed by `-schemadump_scopes` is there), then terminates the process without
+// waiting for the rest of the engine to start or shut down.
+static headless::trigger_t g_HeadlessDump({
+    .m_get_output_dir = []() { return CommandLine()->ParmValue("-schemadump", (const char*)NULL); },
+    .m_get_expected_scopes = []()
+    {
+        const auto scopes = CommandLine()->ParmValue("-schemadump_scopes", (const char*)NULL);
+        return scopes != NULL ? wildcard::split_list(scopes) : std::vector<std::string>{};
+    },
+    .m_get_scopes = []() { return g_pSchemaSystem != NULL ? std::optional(SchemaGetScopes()) : std::nullopt; },
+    .m_dump = [](const std::string& outDirName)
+    {
+        sdk::dump_options_t options;
+        options.m_threads = 0;
+
+        Msg("Headless: Dumping schemas to %s...\n", outDirName.c_str());
+        SchemaDumpAll(outDirName.c_str(), options);
+        Msg("Headless: Dumped all schemas\n");
+    },
+    .m_report_error = [](const std::string& message) { Warning("Headless: Error: %s\n", message.c_str()); },
+    .m_exit = [](int exitCode) { TerminateProcess(GetCurrentProcess(), exitCode); },
+});
+
+// Scopes get registered long after Connect, the timer keeps polling the trigger from the main thread (which
+// dispatches the timer messages) until it dumped, so the bindings aren't read while a module registers them.
+constexpr UINT kHeadlessPollMilliseconds = 1000;
+
+static void CALLBACK HeadlessPollTimer(HWND, UINT, UINT_PTR timerId, DWORD)
+{
+	if (g_HeadlessDump.poll() || g_HeadlessDump.done())
+	{
+		KillTimer(NULL, timerId);
+	}
+}
 
 typedef bool (*AppSystemConnectFn)(IAppSystem* appSystem, CreateInterfaceFn factory);
 static AppSystemConnectFn g_pfnServerConfigConnect = NULL;
@@ -22,6 +72,11 @@ bool Connect(IAppSystem* appSystem, CreateInterfaceFn factory)
 
 	g_pSchemaSystem = (ISchemaSystem*)factory(SCHEMASYSTEM_INTERFACE_VERSION, NULL);
 
+	if (!g_HeadlessDump.poll() && !g_HeadlessDump.done())
+	{
+		SetTimer(NULL, 0, kHeadlessPollMilliseconds, &HeadlessPollTimer);
+	}
+
 	return result;
 }
 
@@ -51,6 +106,17 @@ DLL_EXPORT void* CreateInterface(const char* pName, int* pReturnCode)
 		}
 	}
 
+	// Our own interfaces, the index is built from the schema system so it can only be handed out after Connect
+	if (strcmp(pName, SCHEMAGEN_INDEX_INTERFACE_VERSION) == 0)
+	{
+		if (pReturnCode)
+		{
+			*pReturnCode = g_pSchemaSystem != NULL ? IFACE_OK : IFACE_FAILED;
+		}
+
+		return g_pSchemaSystem != NULL ? GetSchemaGenIndex() : NULL;
+	}
+
 	auto original = g_pfnServerCreateInterface(pName, pReturnCode);
 
 	// Intercept the first interface requested by the engine
@@ -80,17 +146,169 @@ DLL_EXPORT void* CreateInterface(const char* pName, int* pReturnCode)
 
 CON_COMMAND(schema_dump_all, "")
 {
-	if (args.ArgC() != 2)
+	if (args.ArgC() < 2)
 	{
-        Warning("Format: <output path>\n");
+        Warning("Format: <output path> [-async] [-threads=<n>] [-scopes=<scope>,<pattern*>] [-classes=<class>,<pattern*>] [-netplan] [-lookup] [-enums] [-layout[=networked]] [-sizes] [-idx] [-dedup] [-shards=prefix:<n>|size:<KiB>|deps:<n>] [-compress[=<KiB>]] [-ndjson] [-archive=<build>] [-shm=<name>] [-roots=<class>,<pattern*>] [-ids=<registry file>]\n");
         return;
 	}
 
+    sdk::dump_options_t options;
+    for (int i = 2; i < args.ArgC(); ++i)
+    {
+        if (!sdk::ParseDumpOption(options, args.Arg(i)))
+        {
+            Warning("%s", std::format("{}: Unknown option '{}'\n", __FUNCTION__, args.Arg(i)).c_str());
+            return;
+        }
+    }
+
     try {
+        // @note: the snapshot is taken here and the worker thread may fail to start, both throw
+        //
+        if (options.m_async)
+        {
+            if (SchemaDumpAllAsync(args.Arg(1), options))
+                Msg(__FUNCTION__ ": Dumping schemas in the background, see schema_dump_status\n");
+            else
+                Warning(__FUNCTION__ ": A dump is already in progress\n");
+            return;
+        }
+
         Msg(__FUNCTION__ ": Dumping schemas...\n");
-        SchemaDumpAll(args.Arg(1));
+        SchemaDumpAll(args.Arg(1), options);
         Msg(__FUNCTION__ ": Dumped all schemas\n");
     } catch (std::runtime_error& err) {
-        Warning(std::format("{}: Error: {}\n", __FUNCTION__, err.what()).c_str());
+        Warning("%s", std::format("{}: Error: {}\n", __FUNCTION__, err.what()).c_str());
+    }
+}
+
+CON_COMMAND(schema_dump_status, "Reports the progress of a schema_dump_all -async")
+{
+    SchemaDumpStatus();
+}
+
+CON_COMMAND(schema_dump_cancel, "Cancels a schema_dump_all -async")
+{
+    if (!SchemaDumpCancel())
+    {
+        Warning(__FUNCTION__ ": No dump in progress\n");
+    }
+}
+
+CON_COMMAND(schema_watch, "Dumps type scopes as they get registered or change, until schema_watch_stop")
+{
+	if (args.ArgC() < 2)
+	{
+        Warning("Format: <output path> [schema_dump_all options]\n");
+        return;
+	}
+
+    sdk::dump_options_t options;
+    for (int i = 2; i < args.ArgC(); ++i)
+    {
+        if (!sdk::ParseDumpOption(options, args.Arg(i)))
+        {
+            Warning("%s", std::format("{}: Unknown option '{}'\n", __FUNCTION__, args.Arg(i)).c_str());
+            return;
+        }
+    }
+
+    try {
+        if (SchemaWatchStart(args.Arg(1), options))
+            Msg(__FUNCTION__ ": Watching type scopes, see schema_watch_status\n");
+        else
+            Warning(__FUNCTION__ ": Already watching, schema_watch_stop first\n");
+    } catch (std::runtime_error& err) {
+        Warning("%s", std::format("{}: Error: {}\n", __FUNCTION__, err.what()).c_str());
     }
-}
\ No newline at end of file
+}
+
+CON_COMMAND(schema_watch_status, "Reports what schema_watch is doing")
+{
+    SchemaWatchStatus();
+}
+
+CON_COMMAND(schema_watch_stop, "Stops schema_watch")
+{
+    if (!SchemaWatchStop())
+    {
+        Warning(__FUNCTION__ ": Not watching\n");
+    }
+}
+
+CON_COMMAND(schema_index_rebuild, "Rebuilds the index shared through " SCHEMAGEN_INDEX_INTERFACE_VERSION ", e.g. after a module got loaded")
+{
+    try {
+        SchemaIndexRebuild();
+    } catch (std::runtime_error& err) {
+        Warning("%s", std::format("{}: Error: {}\n", __FUNCTION__, err.what()).c_str());
+    }
+}
+
+CON_COMMAND(schema_capture_plan, "Shows how the networked state of a class gets captured, see sdk/schema_capture.h")
+{
+    if (args.ArgC() < 2)
+    {
+        Warning("Format: <class name>\n");
+        return;
+    }
+
+    try {
+        const schema_index::view_t view(GetSchemaGenIndex()->GetIndex());
+        const auto class_entry = view.find_class(fnv64::hash_runtime(args.Arg(1)));
+        if (class_entry == NULL)
+        {
+            Warning("%s", std::format("{}: {} isn't in the schema index\n", __FUNCTION__, args.Arg(1)).c_str());
+            return;
+        }
+
+        const auto plan = schema_capture::compile_networked(view, class_entry);
+        Msg("%s", std::format("{}: {} networked fields in {} copies, {} of {} bytes per entity\n", __FUNCTION__, plan.m_field_count, plan.m_ranges.size(),
+                              plan.m_record_size, class_entry->size).c_str());
+
+        for (const auto& range : plan.m_ranges)
+            Msg("%s", std::format("  +{:#06x} {} bytes\n", range.m_offset, range.m_size).c_str());
+    } catch (std::runtime_error& err) {
+        Warning("%s", std::format("{}: Error: {}\n", __FUNCTION__, err.what()).c_str());
+    }
+}
+
+CON_COMMAND(schema_archive_materialize, "Writes the dump of a build stored with schema_dump_all -archive")
+{
+    if (args.ArgC() < 4)
+    {
+        Warning("Format: <archive path> <build> <output path>\n");
+        return;
+    }
+
+    try {
+        sdk::MaterializeArchiveBuild(args.Arg(1), args.Arg(2), args.Arg(3), 0);
+        Msg("%s", std::format("{}: Wrote build {} to {}\n", __FUNCTION__, args.Arg(2), args.Arg(3)).c_str());
+    } catch (std::runtime_error& err) {
+        Warning("%s", std::format("{}: Error: {}\n", __FUNCTION__, err.what()).c_str());
+    }
+}
+
+CON_COMMAND(schema_archive_history, "Lists the archived builds in which a class or enum changed")
+{
+    if (args.ArgC() < 3)
+    {
+        Warning("Format: <archive path> <class or enum name>\n");
+        return;
+    }
+
+    try {
+        const auto changes = sdk::GetArchiveHistory(args.Arg(1), args.Arg(2));
+        for (const auto& change : changes)
+        {
+            constexpr const char* kinds[] = {"added", "changed", "removed"};
+            Msg("%s", std::format("{} {} {} {} ({:016x})\n", change.m_build, change.m_scope, change.m_is_class ? "class" : "enum",
+                                  kinds[static_cast<int>(change.m_kind)], change.m_object).c_str());
+        }
+
+        if (changes.empty())
+            Msg("%s", std::format("{}: {} isn't in any archived build\n", __FUNCTION__, args.Arg(2)).c_str());
+    } catch (std::runtime_error& err) {
+        Warning("%s", std::format("{}: Error: {}\n", __FUNCTION__, err.what()).c_str());
+    }
+}
@@ -0,0 +1,65 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "sdk/schema_index.h"
+#include "sdk/sdk.h"
+
+extern std::vector<sdk::scope_snapshot_t> SchemaSnapshotAll(const sdk::dump_options_t& options);
+
+namespace {
+    // Readers only ever do an acquire load of the published blob. Builds are serialised by the mutex and every
+    // blob is kept alive until the plugin unloads, so a pointer handed out before a rebuild never dangles.
+    class CSchemaGenIndex : public ISchemaGenIndex {
+    public:
+        const schema_index::header_t* GetIndex() override {
+            if (const auto index = m_published.load(std::memory_order_acquire)) {
+                return index;
+            }
+
+            std::lock_guard lock(m_mutex);
+            if (const auto index = m_published.load(std::memory_order_acquire)) {
+                return index;
+            }
+
+            return BuildLocked();
+        }
+
+        const schema_index::header_t* Rebuild() {
+            std::lock_guard lock(m_mutex);
+            return BuildLocked();
+        }
+
+    private:
+        const schema_index::header_t* BuildLocked() {
+            const auto start = std::chrono::steady_clock::now();
+
+            auto& blob = *m_blobs.emplace_back(std::make_unique<std::vector<std::uint8_t>>(sdk::BuildSchemaIndex(SchemaSnapshotAll({}))));
+            const auto index = reinterpret_cast<const schema_index::header_t*>(blob.data());
+            m_published.store(index, std::memory_order_release);
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            Msg("SchemaGenIndex: Indexed %u classes and %u fields (%zu bytes) in %lld ms\n", index->class_count, index->field_count, blob.size(),
+                (long long)elapsed.count());
+
+            return index;
+        }
+
+        std::mutex m_mutex;
+        std::vector<std::unique_ptr<std::vector<std::uint8_t>>> m_blobs;
+        std::atomic<const schema_index::header_t*> m_published = nullptr;
+    };
+
+    CSchemaGenIndex g_SchemaGenIndex;
+} // namespace
+
+ISchemaGenIndex* GetSchemaGenIndex()
+{
+    return &g_SchemaGenIndex;
+}
+
+void SchemaIndexRebuild()
+{
+    g_SchemaGenIndex.Rebuild();
+}
@@ -0,0 +1,33 @@
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "sdk/sdk.h"
+#include "sdk/shared_index.h"
+
+namespace {
+    // Slots get twice the size of the first index published under a name, a segment can't grow once
+    // readers have it mapped and the index of a later game build is usually a little bigger. A segment
+    // left by an earlier run keeps its slots, the writer reuses them.
+    constexpr std::size_t kSlotGranularity = 1 << 20;
+
+    std::mutex g_SharedIndexMutex;
+    std::map<std::string, std::unique_ptr<shared_index::writer_t>> g_SharedIndexWriters;
+} // namespace
+
+void SchemaPublishIndex(const std::string& name, const std::vector<sdk::scope_snapshot_t>& snapshots)
+{
+    const auto index = sdk::BuildSchemaIndex(snapshots);
+
+    std::lock_guard lock(g_SharedIndexMutex);
+
+    auto& writer = g_SharedIndexWriters[name];
+    if (!writer) {
+        const auto slot_capacity = (index.size() * 2 + kSlotGranularity - 1) / kSlotGranularity * kSlotGranularity;
+        writer = std::make_unique<shared_index::writer_t>(name, slot_capacity);
+    }
+
+    const auto generation = writer->publish(index);
+    Msg("%s: Published %zu bytes to '%s' (generation %llu)\n", __FUNCTION__, index.size(), name.c_str(), (unsigned long long)generation);
+}
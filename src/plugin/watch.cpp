@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sdk/sdk.h"
+#include "tools/scope_watcher.h"
+
+extern std::vector<sdk::scope_snapshot_t> SchemaSnapshotSelected(const sdk::dump_options_t& options);
+extern void SchemaDumpSnapshots(std::vector<sdk::scope_snapshot_t> snapshots, const char* outDirName, const sdk::dump_options_t& options,
+                                sdk::dump_progress_t* progress);
+
+namespace {
+    constexpr UINT kPollMilliseconds = 1000;
+
+    // Counts and a fingerprint of the bindings a snapshot copied, a module that gets reloaded comes back with
+    // new infos even if nothing about its types changed, and that's worth a dump as well.
+    scope_watcher::scope_state_t GetScopeState(const sdk::scope_snapshot_t& snapshot) {
+        scope_watcher::fingerprint_t fingerprint;
+        for (const auto class_info : snapshot.m_classes) {
+            fingerprint.add(reinterpret_cast<std::uintptr_t>(class_info),
+                            static_cast<std::uint32_t>(class_info->m_nSize) | static_cast<std::uint64_t>(class_info->m_nFieldCount) << 32);
+        }
+
+        for (const auto enum_info : snapshot.m_enums)
+            fingerprint.add(reinterpret_cast<std::uintptr_t>(enum_info), static_cast<std::uint64_t>(enum_info->m_nEnumeratorCount));
+
+        return {snapshot.m_name, snapshot.m_classes.size(), snapshot.m_enums.size(), fingerprint.m_value};
+    }
+
+    void CALLBACK WatchPollTimer(HWND, UINT, UINT_PTR, DWORD);
+
+    // A single schema_watch at a time. There is no event for a module registering its types, so a timer polls the
+    // schema system from the main thread, the one modules register their types on, and snapshots the scopes that
+    // are new or changed once they stopped changing, as schema_dump_all -async does. The worker only renders and
+    // writes the snapshots it gets handed.
+    class CScopeWatch {
+    public:
+        ~CScopeWatch() {
+            Stop();
+        }
+
+        // @note: main thread only, like Poll and Stop
+        //
+        bool Start(std::string outDirName, const sdk::dump_options_t& options) {
+            if (m_timer != 0) {
+                return false;
+            }
+
+            m_watcher = scope_watcher::watcher_t();
+            m_out_dir = std::move(outDirName);
+            m_options = options;
+            m_stop_requested = false;
+            m_scopes_dumped = 0;
+            m_scopes_watched = 0;
+
+            m_thread = std::thread([this]() { Work(); });
+
+            m_timer = SetTimer(NULL, 0, kPollMilliseconds, &WatchPollTimer);
+            if (m_timer == 0) {
+                Stop();
+                throw std::runtime_error(std::format("{} : SetTimer failed: {}", __FUNCTION__, GetLastError()));
+            }
+
+            return true;
+        }
+
+        bool Stop() {
+            if (m_timer != 0) {
+                KillTimer(NULL, m_timer);
+                m_timer = 0;
+            }
+
+            if (!m_thread.joinable()) {
+                return false;
+            }
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_stop_requested = true;
+            }
+
+            m_wake.notify_all();
+            m_thread.join();
+
+            m_batches.clear();
+            m_failed.clear();
+            return true;
+        }
+
+        void PrintStatus() {
+            if (m_timer == 0) {
+                Msg("SchemaWatchStatus: Not watching\n");
+                return;
+            }
+
+            Msg("SchemaWatchStatus: Watching %zu scopes, %zu dumped so far\n", m_scopes_watched.load(), m_scopes_dumped.load());
+        }
+
+        void Poll() {
+            {
+                std::lock_guard lock(m_mutex);
+                m_watcher.retry(m_failed);
+                m_failed.clear();
+            }
+
+            auto snapshots = SchemaSnapshotSelected(m_options);
+
+            std::vector<scope_watcher::scope_state_t> states;
+            states.reserve(snapshots.size());
+            for (const auto& snapshot : snapshots) {
+                states.push_back(GetScopeState(snapshot));
+            }
+
+            const auto changes = m_watcher.poll(states);
+            m_scopes_watched = m_watcher.size();
+
+            for (const auto& name : changes.m_removed) {
+                Msg("SchemaWatch: %s got unloaded, its files are left alone\n", name.c_str());
+            }
+
+            if (changes.m_dirty.empty()) {
+                return;
+            }
+
+            std::erase_if(snapshots, [&](const sdk::scope_snapshot_t& snapshot) {
+                return !std::binary_search(changes.m_dirty.begin(), changes.m_dirty.end(), snapshot.m_name);
+            });
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_batches.push_back({std::move(snapshots), changes.m_dirty});
+            }
+
+            m_wake.notify_all();
+        }
+
+    private:
+        struct batch_t {
+            std::vector<sdk::scope_snapshot_t> m_snapshots;
+            std::vector<std::string> m_names;
+        };
+
+        void Work() {
+            std::unique_lock lock(m_mutex);
+            while (true) {
+                m_wake.wait(lock, [this]() { return m_stop_requested || !m_batches.empty(); });
+                if (m_stop_requested) {
+                    return;
+                }
+
+                auto batch = std::move(m_batches.front());
+                m_batches.erase(m_batches.begin());
+
+                lock.unlock();
+                const auto dumped = Dump(batch);
+                lock.lock();
+
+                // @note: the main thread hands the scopes to the watcher again on its next poll
+                //
+                if (!dumped) {
+                    m_failed.insert(m_failed.end(), batch.m_names.begin(), batch.m_names.end());
+                }
+            }
+        }
+
+        // @note: nothing may leave the thread, an exception there terminates the game
+        //
+        bool Dump(batch_t& batch) {
+            try {
+                const auto start = std::chrono::steady_clock::now();
+                SchemaDumpSnapshots(std::move(batch.m_snapshots), m_out_dir.c_str(), m_options, nullptr);
+
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+                for (const auto& name : batch.m_names) {
+                    Msg("SchemaWatch: Dumped %s\n", name.c_str());
+                }
+                Msg("SchemaWatch: Dumped %zu scopes in %lld ms\n", batch.m_names.size(), (long long)elapsed.count());
+
+                m_scopes_dumped += batch.m_names.size();
+                return true;
+            } catch (std::exception& err) {
+                Warning("SchemaWatch: Error: %s, retrying on the next poll\n", err.what());
+            } catch (...) {
+                Warning("SchemaWatch: Unknown error, retrying on the next poll\n");
+            }
+
+            return false;
+        }
+
+        UINT_PTR m_timer = 0;
+        std::string m_out_dir;
+        sdk::dump_options_t m_options;
+        scope_watcher::watcher_t m_watcher; // main thread only
+
+        std::thread m_thread;
+        std::mutex m_mutex; // guards everything below, shared with the worker
+        std::condition_variable m_wake;
+        bool m_stop_requested = false;
+        std::vector<batch_t> m_batches;
+        std::vector<std::string> m_failed; // scopes of batches the worker failed to dump
+
+        std::atomic<std::size_t> m_scopes_watched = 0;
+        std::atomic<std::size_t> m_scopes_dumped = 0;
+    };
+
+    CScopeWatch g_ScopeWatch;
+
+    // @note: a failing poll only loses that poll, the next one takes another snapshot
+    //
+    void CALLBACK WatchPollTimer(HWND, UINT, UINT_PTR, DWORD) {
+        try {
+            g_ScopeWatch.Poll();
+        } catch (std::exception& err) {
+            Warning("SchemaWatch: Error: %s\n", err.what());
+        }
+    }
+} // namespace
+
+// Throws std::runtime_error for options that need every scope at once, returns false if a watch is already running.
+// Has to be called on the main thread, the polls run there.
+bool SchemaWatchStart(const char* outDirName, const sdk::dump_options_t& options)
+{
+    if (options.m_async) {
+        throw std::runtime_error(std::format("{} : A watch always dumps in the background, -async doesn't apply", __FUNCTION__));
+    }
+
+    if (options.m_deduplicate || !options.m_archive_build.empty() || !options.m_shared_memory_name.empty() || !options.m_root_patterns.empty()) {
+        throw std::runtime_error(std::format("{} : -dedup, -archive, -shm and -roots need every scope at once, they can't be watched", __FUNCTION__));
+    }
+
+    return g_ScopeWatch.Start(outDirName, options);
+}
+
+bool SchemaWatchStop()
+{
+    return g_ScopeWatch.Stop();
+}
+
+void SchemaWatchStatus()
+{
+    g_ScopeWatch.PrintStatus();
+}
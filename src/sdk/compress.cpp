@@ -0,0 +1,13 @@
+#include "sdk/sdk.h"
+#include "sdk/compressed_dump.h"
+
+namespace sdk {
+    void WriteCompressedJson(const std::string_view text, const std::vector<dump_index::entry_t>& index_entries, const std::size_t block_size,
+                             const std::uint32_t threads, const std::string& out_file_path) {
+        const auto data = compressed_dump::serialize(text, index_entries, block_size, threads);
+
+        std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+        f.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        f.close();
+    }
+} // namespace sdk
@@ -0,0 +1,124 @@
+#include "sdk/sdk.h"
+#include <unordered_map>
+
+namespace sdk {
+    namespace {
+        struct shared_fragments_t {
+            std::vector<const type_fragment_t*> m_fragments; // first occurrence of every shared fragment
+            std::unordered_map<std::uint64_t, std::size_t> m_scope_counts;
+            std::unordered_map<std::string_view, std::uint64_t> m_names; // name -> the fingerprint that gets shared
+
+            static std::uint64_t Fingerprint(const type_fragment_t& fragment) {
+                // @note: the text starts with the quoted name, so equal fingerprints mean equal name and definition
+                //
+                return fnv64::hash_runtime_data(fragment.m_text.data(), fragment.m_text.size());
+            }
+
+            void Count(const std::vector<type_fragment_t>& fragments) {
+                for (const auto& fragment : fragments)
+                    ++m_scope_counts[Fingerprint(fragment)];
+            }
+
+            void Select(const std::vector<type_fragment_t>& fragments) {
+                for (const auto& fragment : fragments) {
+                    const auto fingerprint = Fingerprint(fragment);
+                    if (m_scope_counts[fingerprint] < 2)
+                        continue;
+
+                    // @note: if scopes disagree on a type, only its first shared variant goes to the shared file
+                    //
+                    if (m_names.emplace(fragment.m_name, fingerprint).second)
+                        m_fragments.push_back(&fragment);
+                }
+            }
+
+            [[nodiscard]] bool IsShared(const type_fragment_t& fragment) const {
+                const auto it = m_names.find(fragment.m_name);
+                return it != m_names.end() && it->second == Fingerprint(fragment);
+            }
+        };
+
+        void WriteFile(const std::string& path, const std::string& text) {
+            std::ofstream f(path, std::ios::out | std::ios::binary);
+            f << text;
+            f.close();
+        }
+    } // namespace
+
+    dedup_stats_t WriteDeduplicatedScopes(const std::vector<rendered_scope_t>& scopes, const char* outDirName, const dump_options_t& options) {
+        if (!std::filesystem::exists(outDirName))
+            std::filesystem::create_directories(outDirName);
+
+        shared_fragments_t shared_enums, shared_classes;
+        for (const auto& scope : scopes) {
+            shared_enums.Count(scope.m_enums);
+            shared_classes.Count(scope.m_classes);
+        }
+        for (const auto& scope : scopes) {
+            shared_enums.Select(scope.m_enums);
+            shared_classes.Select(scope.m_classes);
+        }
+
+        dedup_stats_t stats;
+        stats.m_shared_enums = shared_enums.m_fragments.size();
+        stats.m_shared_classes = shared_classes.m_fragments.size();
+
+        std::vector<dump_index::entry_t> index_entries;
+        const auto index = options.m_dump_index ? &index_entries : nullptr;
+
+        const auto shared_text = AssembleScopeJson(shared_enums.m_fragments, shared_classes.m_fragments, nullptr, index);
+        WriteFile(std::format("{}\\_shared.json", outDirName), shared_text);
+        stats.m_bytes_written += shared_text.size();
+
+        if (index != nullptr)
+            WriteDumpIndex(std::move(index_entries), shared_text.size(), std::format("{}\\_shared.idx", outDirName));
+
+        for (const auto& scope : scopes) {
+            index_entries.clear();
+
+            std::vector<const type_fragment_t*> local_enums, local_classes;
+            std::vector<const char*> shared_enum_names, shared_class_names;
+
+            for (const auto& fragment : scope.m_enums) {
+                if (shared_enums.IsShared(fragment))
+                    shared_enum_names.push_back(fragment.m_name);
+                else
+                    local_enums.push_back(&fragment);
+            }
+
+            for (const auto& fragment : scope.m_classes) {
+                if (shared_classes.IsShared(fragment))
+                    shared_class_names.push_back(fragment.m_name);
+                else
+                    local_classes.push_back(&fragment);
+            }
+
+            // @note: the "shared" key lists which definitions of _shared.json belong to this scope
+            //
+            const auto text = AssembleScopeJson(local_enums, local_classes, [&](codegen::generator_t::self_ref builder) {
+                builder.json_key("shared").begin_json_object_value();
+
+                builder.json_key("enums").begin_json_array_value();
+                for (const auto name : shared_enum_names)
+                    builder.json_string_element(name);
+                builder.end_json_array();
+
+                builder.json_key("classes").begin_json_array_value();
+                for (const auto name : shared_class_names)
+                    builder.json_string_element(name);
+                builder.end_json_array();
+
+                builder.end_json_object();
+            }, index);
+
+            WriteFile(std::format("{}\\{}.json", outDirName, scope.m_name), text);
+            stats.m_bytes_written += text.size();
+
+            if (index != nullptr)
+                WriteDumpIndex(std::move(index_entries), text.size(), std::format("{}\\{}.idx", outDirName, scope.m_name));
+            stats.m_bytes_per_scope += AssembleScopeJson(scope).size();
+        }
+
+        return stats;
+    }
+} // namespace sdk
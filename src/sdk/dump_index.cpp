@@ -0,0 +1,11 @@
+#include "sdk/sdk.h"
+
+namespace sdk {
+    void WriteDumpIndex(std::vector<dump_index::entry_t> entries, const std::uint64_t file_size, const std::string& out_file_path) {
+        const auto data = dump_index::serialize(std::move(entries), file_size);
+
+        std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+        f.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        f.close();
+    }
+} // namespace sdk
@@ -0,0 +1,251 @@
+#include "sdk/enum_lookup.h"
+#include "sdk/sdk.h"
+#include "tools/enum_table.h"
+#include <limits>
+#include <unordered_set>
+
+namespace sdk {
+    namespace {
+        static_assert(static_cast<std::uint8_t>(enum_table::kind_t::kDense) == static_cast<std::uint8_t>(enum_lookup::kind_t::kDense));
+        static_assert(static_cast<std::uint8_t>(enum_table::kind_t::kSparse) == static_cast<std::uint8_t>(enum_lookup::kind_t::kSparse));
+        static_assert(static_cast<std::uint8_t>(enum_table::kind_t::kFlags) == static_cast<std::uint8_t>(enum_lookup::kind_t::kFlags));
+
+        constexpr const char* kKindNames[] = {"dense", "sparse", "flags"};
+
+        struct enum_entry_t {
+            CSchemaEnumInfo* m_info = nullptr;
+            enum_table::table_t m_table = {};
+            std::string m_identifier = ""; // namespace of the enum in the header, unique within the scope
+        };
+
+        // @note: GetIdentifierName maps e.g. `A::B` and `A_B` to the same identifier. an enum whose name already is
+        // that identifier keeps it, the others get the hash of their name appended, so the suffix doesn't depend on
+        // which other enums the scope has. `detail` is taken by the helpers of the header
+        //
+        void AssignIdentifiers(std::vector<enum_entry_t>& entries) {
+            std::unordered_set<std::string> taken = {"detail"};
+            std::vector<enum_entry_t*> renamed;
+            for (auto& entry : entries) {
+                entry.m_identifier = GetIdentifierName(entry.m_info->m_pszName);
+                if (entry.m_identifier != entry.m_info->m_pszName || !taken.insert(entry.m_identifier).second)
+                    renamed.push_back(&entry);
+            }
+
+            for (const auto entry : renamed) {
+                if (taken.insert(entry->m_identifier).second)
+                    continue;
+
+                const auto hash = fnv64::hash_runtime(entry->m_info->m_pszName);
+                auto identifier = std::format("{}_{:08x}", entry->m_identifier, static_cast<std::uint32_t>(hash));
+                if (!taken.insert(identifier).second) {
+                    identifier = std::format("{}_{:016x}", entry->m_identifier, hash);
+                    taken.insert(identifier);
+                }
+
+                entry->m_identifier = std::move(identifier);
+            }
+        }
+
+        std::vector<enum_entry_t> BuildTables(const scope_snapshot_t& snapshot) {
+            std::vector<enum_entry_t> result;
+            result.reserve(snapshot.m_enums.size());
+
+            std::vector<std::int64_t> values;
+            for (const auto enum_info : snapshot.m_enums) {
+                values.clear();
+                for (int i = 0; i < enum_info->m_nEnumeratorCount; ++i)
+                    values.push_back(GetEnumeratorValue(enum_info->m_pEnumerators[i]));
+
+                result.push_back({enum_info, enum_table::build(values, enum_info->m_nAlignment)});
+            }
+
+            // @note: sorted by name so readers can binary search the enum table
+            //
+            std::sort(result.begin(), result.end(), [](const enum_entry_t& a, const enum_entry_t& b) { return strcmp(a.m_info->m_pszName, b.m_info->m_pszName) < 0; });
+            AssignIdentifiers(result);
+            return result;
+        }
+
+        const char* GetEnumeratorName(const enum_entry_t& entry, const std::uint32_t index) {
+            return index != enum_table::kNone ? entry.m_info->m_pEnumerators[index].m_pszName : nullptr;
+        }
+
+        void WriteBinary(const std::vector<enum_entry_t>& entries, const std::string& out_file_path) {
+            std::vector<enum_lookup::source_t> sources;
+            sources.reserve(entries.size());
+            for (const auto& entry : entries) {
+                auto& source = sources.emplace_back();
+                source.m_name = entry.m_info->m_pszName;
+                source.m_size = entry.m_info->m_nAlignment;
+                source.m_table = &entry.m_table;
+                for (int i = 0; i < entry.m_info->m_nEnumeratorCount; ++i)
+                    source.m_enumerators.emplace_back(entry.m_info->m_pEnumerators[i].m_pszName);
+            }
+
+            const auto data = enum_lookup::serialize(sources);
+            std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+            f.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            f.close();
+        }
+
+        // @note: -9223372036854775808 isn't a literal, it's the negation of one that doesn't fit
+        //
+        std::string FormatValue(const std::int64_t value) {
+            if (value == std::numeric_limits<std::int64_t>::min())
+                return "(-9223372036854775807 - 1)";
+
+            return std::format("{}", value);
+        }
+
+        void WriteNames(codegen::generator_t::self_ref builder, const char* name, const enum_entry_t& entry, const std::vector<std::uint32_t>& indices) {
+            builder.push_line(std::format("inline constexpr std::string_view {}[] = {{", name));
+            builder.inc_tabs_count(codegen::kTabsPerBlock);
+
+            for (const auto index : indices) {
+                const auto enumerator = GetEnumeratorName(entry, index);
+                builder.push_line(std::format("\"{}\",", codegen::escape_cpp_string(enumerator != nullptr ? enumerator : "")));
+            }
+
+            builder.dec_tabs_count(codegen::kTabsPerBlock);
+            builder.push_line("};");
+        }
+
+        void WriteSorted(codegen::generator_t::self_ref builder, const enum_entry_t& entry) {
+            std::vector<std::uint32_t> indices;
+            builder.push_line("inline constexpr std::int64_t kValues[] = {");
+            builder.inc_tabs_count(codegen::kTabsPerBlock);
+            for (const auto& item : entry.m_table.m_sorted) {
+                builder.push_line(std::format("{},", FormatValue(item.m_value)));
+                indices.push_back(item.m_index);
+            }
+            builder.dec_tabs_count(codegen::kTabsPerBlock);
+            builder.push_line("};");
+
+            WriteNames(builder, "kNames", entry, indices);
+        }
+
+        void WriteEnum(codegen::generator_t::self_ref builder, const enum_entry_t& entry) {
+            const auto& table = entry.m_table;
+
+            builder.comment(std::format("{}, {}", entry.m_info->m_pszName, kKindNames[static_cast<std::uint8_t>(table.m_kind)]));
+            builder.push_line(std::format("namespace {} {{", entry.m_identifier));
+            builder.inc_tabs_count(codegen::kTabsPerBlock);
+
+            std::string lookup;
+            switch (table.m_kind) {
+            case enum_table::kind_t::kDense:
+                builder.push_line(std::format("inline constexpr std::int64_t kBase = {};", FormatValue(table.m_base)));
+                WriteNames(builder, "kNames", entry, table.m_slots);
+                lookup = "return detail::find_dense(kNames, kBase, value);";
+                break;
+            case enum_table::kind_t::kFlags:
+                WriteNames(builder, "kBits", entry, table.m_slots);
+                if (table.m_sorted.empty()) {
+                    lookup = "return detail::find_bit(kBits, value);";
+                } else {
+                    WriteSorted(builder, entry);
+                    lookup = "return detail::is_bit(value) ? detail::find_bit(kBits, value) : detail::find_sorted(kValues, kNames, value);";
+                }
+                break;
+            case enum_table::kind_t::kSparse:
+                if (table.m_sorted.empty()) {
+                    lookup = "return {};";
+                } else {
+                    WriteSorted(builder, entry);
+                    lookup = "return detail::find_sorted(kValues, kNames, value);";
+                }
+                break;
+            }
+
+            builder.next_line();
+            builder.comment("name of the enumerator with exactly this value, empty if there is none");
+            builder.push_line("constexpr std::string_view name(const std::int64_t value) {");
+            builder.push_line(std::format("  {}", lookup));
+            builder.push_line("}");
+
+            if (table.m_kind == enum_table::kind_t::kFlags) {
+                builder.next_line();
+                builder.comment("calls `fn(std::string_view)` with the name of every set bit, lowest first");
+                builder.push_line("template <typename Fn>");
+                builder.push_line("constexpr void for_each_flag(const std::uint64_t value, Fn&& fn) {");
+                builder.push_line("  detail::for_each_bit(kBits, value, fn);");
+                builder.push_line("}");
+            }
+
+            builder.dec_tabs_count(codegen::kTabsPerBlock);
+            builder.push_line(std::format("}} // namespace {}", entry.m_identifier));
+        }
+
+        void WriteHeader(const std::vector<enum_entry_t>& entries, const std::string& scope_name, const std::string& out_file_path) {
+            auto builder = codegen::get();
+
+            builder.comment("Generated by CS2SchemaGen, do not edit");
+            builder.push_line("#pragma once");
+            builder.push_line("#include <bit>");
+            builder.push_line("#include <cstdint>");
+            builder.push_line("#include <string_view>");
+            builder.next_line();
+            builder.push_line(std::format("namespace schema_enums::{} {{", GetIdentifierName(scope_name)));
+            builder.inc_tabs_count(codegen::kTabsPerBlock);
+
+            builder.push_line("namespace detail {");
+            builder.inc_tabs_count(codegen::kTabsPerBlock);
+            builder.push_line("template <std::size_t N>");
+            builder.push_line("constexpr std::string_view find_dense(const std::string_view (&names)[N], const std::int64_t base, const std::int64_t value) {");
+            builder.push_line("  const auto slot = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(base);");
+            builder.push_line("  return slot < N ? names[slot] : std::string_view();");
+            builder.push_line("}");
+            builder.next_line();
+            builder.comment("branchless binary search, the values are a handful and unpredictable");
+            builder.push_line("template <std::size_t N>");
+            builder.push_line("constexpr std::string_view find_sorted(const std::int64_t (&values)[N], const std::string_view (&names)[N], const std::int64_t value) {");
+            builder.push_line("  std::size_t first = 0;");
+            builder.push_line("  for (std::size_t count = N; count > 1; count -= count / 2)");
+            builder.push_line("    first += static_cast<std::size_t>(values[first + count / 2 - 1] < value) * (count / 2);");
+            builder.push_line("  return values[first] == value ? names[first] : std::string_view();");
+            builder.push_line("}");
+            builder.next_line();
+            builder.push_line("constexpr bool is_bit(const std::int64_t value) {");
+            builder.push_line("  return value > 0 && (value & (value - 1)) == 0;");
+            builder.push_line("}");
+            builder.next_line();
+            builder.push_line("template <std::size_t N>");
+            builder.push_line("constexpr std::string_view find_bit(const std::string_view (&bits)[N], const std::int64_t value) {");
+            builder.push_line("  if (!is_bit(value))");
+            builder.push_line("    return {};");
+            builder.push_line("  const auto bit = static_cast<std::size_t>(std::countr_zero(static_cast<std::uint64_t>(value)));");
+            builder.push_line("  return bit < N ? bits[bit] : std::string_view();");
+            builder.push_line("}");
+            builder.next_line();
+            builder.push_line("template <std::size_t N, typename Fn>");
+            builder.push_line("constexpr void for_each_bit(const std::string_view (&bits)[N], std::uint64_t value, Fn& fn) {");
+            builder.push_line("  for (; value != 0; value &= value - 1) {");
+            builder.push_line("    const auto bit = static_cast<std::size_t>(std::countr_zero(value));");
+            builder.push_line("    if (bit < N && !bits[bit].empty())");
+            builder.push_line("      fn(bits[bit]);");
+            builder.push_line("  }");
+            builder.push_line("}");
+            builder.dec_tabs_count(codegen::kTabsPerBlock);
+            builder.push_line("} // namespace detail");
+
+            for (const auto& entry : entries) {
+                builder.next_line();
+                WriteEnum(builder, entry);
+            }
+
+            builder.dec_tabs_count(codegen::kTabsPerBlock);
+            builder.push_line(std::format("}} // namespace schema_enums::{}", GetIdentifierName(scope_name)));
+
+            std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+            f << builder.str();
+            f.close();
+        }
+    } // namespace
+
+    void WriteEnumTables(const scope_snapshot_t& snapshot, const std::string& out_binary_path, const std::string& out_header_path) {
+        const auto entries = BuildTables(snapshot);
+
+        WriteBinary(entries, out_binary_path);
+        WriteHeader(entries, snapshot.m_name, out_header_path);
+    }
+} // namespace sdk
@@ -0,0 +1,17 @@
+#include "sdk/sdk.h"
+#include "tools/wildcard.h"
+
+namespace sdk {
+    prune_stats_t FilterTypes(std::vector<scope_snapshot_t>& snapshots, const std::vector<std::string>& patterns) {
+        prune_stats_t stats;
+
+        for (auto& snapshot : snapshots) {
+            stats.m_pruned_classes += wildcard::erase_unmatched(snapshot.m_classes, patterns, [](const CSchemaClassInfo* class_info) { return class_info->m_pszName; });
+            stats.m_pruned_enums += wildcard::erase_unmatched(snapshot.m_enums, patterns, [](const CSchemaEnumInfo* enum_info) { return enum_info->m_pszName; });
+            stats.m_kept_classes += snapshot.m_classes.size();
+            stats.m_kept_enums += snapshot.m_enums.size();
+        }
+
+        return stats;
+    }
+} // namespace sdk
@@ -0,0 +1,19 @@
+#include "sdk/sdk.h"
+
+namespace sdk {
+    std::size_t RegisterTypeIds(ids::registry_t& registry, const std::vector<scope_snapshot_t>& snapshots) {
+        for (const auto& snapshot : snapshots) {
+            for (const auto enum_info : snapshot.m_enums)
+                registry.request(ids::kind_t::kEnum, enum_info->m_pszName);
+
+            for (const auto class_info : snapshot.m_classes) {
+                registry.request(ids::kind_t::kClass, class_info->m_pszName);
+
+                for (const auto field : GetNetworkedFields(class_info))
+                    registry.request(ids::kind_t::kField, ids::registry_t::field_key(class_info->m_pszName, field->m_pszName));
+            }
+        }
+
+        return registry.commit();
+    }
+} // namespace sdk
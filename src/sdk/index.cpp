@@ -0,0 +1,134 @@
+#include "sdk/schema_index.h"
+#include "sdk/schema_metadata.h"
+#include "sdk/sdk.h"
+#include "tools/binary_writer.h"
+#include <unordered_map>
+#include <unordered_set>
+
+namespace sdk {
+    namespace {
+        struct class_entry_t {
+            schema_index::class_t m_entry = {};
+            CSchemaClassInfo* m_class_info = nullptr;
+        };
+
+        schema_index::field_t MakeField(binary::string_table_t& strings, const SchemaClassFieldData_t* field, const std::int32_t base_offset,
+                                        const bool is_networked) {
+            schema_index::field_t result = {};
+            result.hash = fnv64::hash_runtime(field->m_pszName);
+            result.name = strings.add(field->m_pszName);
+            result.type_name = strings.add(field->m_pType->m_sTypeName.Get());
+            result.offset = base_offset + field->m_nSingleInheritanceOffset;
+            result.encoder = schema_index::kNoString;
+
+            int size = 0;
+            std::uint8_t alignment = 0;
+            if (field->m_pType->GetSizeAndAlignment(size, alignment))
+                result.size = size;
+
+            if (is_networked)
+                result.flags |= schema_index::kNetworked;
+
+            const auto metadata = field->m_pStaticMetadata;
+            const auto metadata_count = field->m_nStaticMetadataCount;
+
+            if (const auto value = FindMetadata(metadata, metadata_count, "MNetworkBitCount")) {
+                result.bit_count = static_cast<std::uint16_t>(value->m_n_value);
+                result.flags |= schema_index::kHasBitCount;
+            }
+
+            if (const auto value = FindMetadata(metadata, metadata_count, "MNetworkEncoder"))
+                result.encoder = strings.add(value->m_p_sz_value);
+
+            if (HasMetadata(metadata, metadata_count, "MNetworkChangeCallback"))
+                result.flags |= schema_index::kHasChangeCallback;
+
+            return result;
+        }
+
+        // @note: own fields first, then every base class with its fields moved by the base class offset
+        //
+        void AddFields(std::vector<schema_index::field_t>& fields, binary::string_table_t& strings, CSchemaClassInfo* class_info,
+                       const std::int32_t base_offset, const bool inherited) {
+            const auto networked_fields = GetNetworkedFields(class_info);
+            const std::unordered_set<const SchemaClassFieldData_t*> networked(networked_fields.begin(), networked_fields.end());
+
+            for (auto i = 0; i < class_info->m_nFieldCount; ++i) {
+                const auto field = &class_info->m_pFields[i];
+
+                auto& entry = fields.emplace_back(MakeField(strings, field, base_offset, networked.contains(field)));
+                if (inherited)
+                    entry.flags |= schema_index::kInherited;
+            }
+
+            for (auto i = 0; i < class_info->m_nBaseClassCount; ++i) {
+                const auto& base = class_info->m_pBaseClasses[i];
+                if (base.m_pClass != nullptr)
+                    AddFields(fields, strings, base.m_pClass, base_offset + static_cast<std::int32_t>(base.m_unOffset), true);
+            }
+        }
+    } // namespace
+
+    std::vector<std::uint8_t> BuildSchemaIndex(const std::vector<scope_snapshot_t>& snapshots) {
+        binary::string_table_t strings;
+        std::vector<class_entry_t> classes;
+
+        for (const auto& snapshot : snapshots) {
+            const auto scope = strings.add(snapshot.m_name);
+            for (const auto class_info : snapshot.m_classes) {
+                auto& entry = classes.emplace_back();
+                entry.m_class_info = class_info;
+                entry.m_entry.hash = fnv64::hash_runtime(class_info->m_pszName);
+                entry.m_entry.name = strings.add(class_info->m_pszName);
+                entry.m_entry.scope = scope;
+                entry.m_entry.size = class_info->m_nSize;
+            }
+        }
+
+        std::stable_sort(classes.begin(), classes.end(), [](const class_entry_t& a, const class_entry_t& b) { return a.m_entry.hash < b.m_entry.hash; });
+
+        std::unordered_map<const CSchemaClassInfo*, std::uint32_t> class_indices;
+        for (std::uint32_t i = 0; i < classes.size(); ++i)
+            class_indices.emplace(classes[i].m_class_info, i);
+
+        std::vector<schema_index::class_t> class_entries;
+        std::vector<schema_index::field_t> fields;
+        class_entries.reserve(classes.size());
+
+        for (auto& [entry, class_info] : classes) {
+            entry.base_class = schema_index::kNoClass;
+            if (class_info->m_nBaseClassCount > 0) {
+                if (const auto it = class_indices.find(class_info->m_pBaseClasses[0].m_pClass); it != class_indices.end())
+                    entry.base_class = it->second;
+            }
+
+            entry.first_field = static_cast<std::uint32_t>(fields.size());
+            AddFields(fields, strings, class_info, 0, false);
+            entry.field_count = static_cast<std::uint32_t>(fields.size()) - entry.first_field;
+
+            // @note: a field shadowing one of a base class sorts first, so lookups find the most derived one
+            //
+            std::stable_sort(fields.begin() + entry.first_field, fields.end(), [](const schema_index::field_t& a, const schema_index::field_t& b) {
+                if (a.hash != b.hash)
+                    return a.hash < b.hash;
+
+                return (a.flags & schema_index::kInherited) < (b.flags & schema_index::kInherited);
+            });
+
+            class_entries.push_back(entry);
+        }
+
+        schema_index::header_t header = {};
+        header.magic = schema_index::kMagic;
+        header.version = schema_index::kVersion;
+        header.class_count = static_cast<std::uint32_t>(class_entries.size());
+        header.field_count = static_cast<std::uint32_t>(fields.size());
+        header.strings_size = static_cast<std::uint32_t>(strings.data().size());
+
+        binary::writer_t writer;
+        writer.write(header).write_array(class_entries).write_array(fields);
+        writer.write_bytes(strings.data().data(), strings.data().size());
+
+        return writer.data();
+    }
+} // namespace sdk
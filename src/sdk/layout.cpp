@@ -0,0 +1,148 @@
+#include "sdk/sdk.h"
+#include "tools/layout.h"
+#include <unordered_set>
+
+namespace sdk {
+    namespace {
+        constexpr std::size_t kWorstClasses = 20;
+
+        // @note: own fields and then those of every base class, moved by the offset of the base class, same as the schema index
+        //
+        void AddFields(std::vector<layout::field_t>& fields, CSchemaClassInfo* class_info, const std::int32_t base_offset, const bool inherited) {
+            const auto networked_fields = GetNetworkedFields(class_info);
+            const std::unordered_set<const SchemaClassFieldData_t*> networked(networked_fields.begin(), networked_fields.end());
+
+            for (auto i = 0; i < class_info->m_nFieldCount; ++i) {
+                const auto field = &class_info->m_pFields[i];
+
+                int size = 0;
+                std::uint8_t alignment = 0;
+                if (!field->m_pType->GetSizeAndAlignment(size, alignment) || size < 0)
+                    size = 0;
+
+                auto& entry = fields.emplace_back();
+                entry.m_name = field->m_pszName;
+                entry.m_owner = inherited ? class_info->m_pszName : "";
+                entry.m_offset = static_cast<std::uint32_t>(base_offset + field->m_nSingleInheritanceOffset);
+                entry.m_size = static_cast<std::uint32_t>(size);
+                entry.m_networked = networked.contains(field);
+            }
+
+            for (auto i = 0; i < class_info->m_nBaseClassCount; ++i) {
+                const auto& base = class_info->m_pBaseClasses[i];
+                if (base.m_pClass != nullptr)
+                    AddFields(fields, base.m_pClass, base_offset + static_cast<std::int32_t>(base.m_unOffset), true);
+            }
+        }
+
+        struct class_report_t {
+            CSchemaClassInfo* m_class_info = nullptr;
+            layout::report_t m_report = {};
+        };
+
+        void WriteClass(codegen::generator_t::self_ref builder, const class_report_t& entry) {
+            const auto& report = entry.m_report;
+
+            builder.json_key(entry.m_class_info->m_pszName).begin_json_object_value();
+            builder.json_key("size").json_literal(report.m_size);
+            builder.json_key("align").json_literal(entry.m_class_info->m_unAlignOf);
+            builder.json_key("leading").json_literal(report.m_leading);
+            builder.json_key("padding").json_literal(report.m_padding);
+            builder.json_key("tailPadding").json_literal(report.m_tail_padding);
+            builder.json_key("cacheLines").json_literal(report.m_cache_lines);
+            builder.json_key("networkedCacheLines").json_literal(report.m_networked_lines);
+            builder.json_key("straddling").json_literal(report.m_straddling);
+
+            builder.json_key("fields").begin_json_array_value();
+            for (const auto& field : report.m_fields) {
+                builder.begin_json_object().json_key("name").json_string(field.m_name);
+                if (!field.m_owner.empty())
+                    builder.json_key("owner").json_string(field.m_owner);
+
+                builder.json_key("offset").json_literal(field.m_offset);
+                builder.json_key("size").json_literal(field.m_size);
+                builder.json_key("line").json_literal(field.first_line());
+                if (field.last_line() != field.first_line())
+                    builder.json_key("lastLine").json_literal(field.last_line());
+
+                if (field.m_networked)
+                    builder.json_key("networked").json_literal(true);
+
+                builder.end_json_object();
+            }
+            builder.end_json_array();
+
+            builder.json_key("holes").begin_json_array_value();
+            for (const auto& hole : report.m_holes)
+                builder.begin_json_object().json_key("offset").json_literal(hole.m_offset).json_key("size").json_literal(hole.m_size).end_json_object();
+            builder.end_json_array();
+
+            builder.end_json_object();
+        }
+    } // namespace
+
+    void WriteLayoutReport(const scope_snapshot_t& snapshot, const std::string& out_file_path, const layout_report_t mode) {
+        std::vector<class_report_t> reports;
+        reports.reserve(snapshot.m_classes.size());
+
+        std::vector<layout::field_t> fields;
+        for (const auto class_info : snapshot.m_classes) {
+            fields.clear();
+            AddFields(fields, class_info, 0, false);
+
+            if (mode == layout_report_t::kNetworked && std::none_of(fields.begin(), fields.end(), [](const layout::field_t& field) { return field.m_networked; }))
+                continue;
+
+            reports.push_back({class_info, layout::analyze(static_cast<std::uint32_t>(std::max(class_info->m_nSize, 0)), fields)});
+        }
+
+        std::sort(reports.begin(), reports.end(), [](const class_report_t& a, const class_report_t& b) { return strcmp(a.m_class_info->m_pszName, b.m_class_info->m_pszName) < 0; });
+
+        // @note: most wasted bytes first, it's the bytes that cost cache lines and not the ratio
+        //
+        std::vector<const class_report_t*> worst;
+        for (const auto& entry : reports) {
+            if (entry.m_report.m_padding != 0)
+                worst.push_back(&entry);
+        }
+
+        std::stable_sort(worst.begin(), worst.end(), [](const class_report_t* a, const class_report_t* b) {
+            if (a->m_report.m_padding != b->m_report.m_padding)
+                return a->m_report.m_padding > b->m_report.m_padding;
+
+            return a->m_report.fragmentation() > b->m_report.fragmentation();
+        });
+        worst.resize(std::min(worst.size(), kWorstClasses));
+
+        auto builder = codegen::get();
+        builder.begin_json_object();
+
+        builder.json_key("cacheLineSize").json_literal(layout::kCacheLineSize);
+
+        builder.json_key("worst").begin_json_array_value();
+        for (const auto entry : worst) {
+            builder.begin_json_object()
+                .json_key("name")
+                .json_string(entry->m_class_info->m_pszName)
+                .json_key("size")
+                .json_literal(entry->m_report.m_size)
+                .json_key("padding")
+                .json_literal(entry->m_report.m_padding)
+                .json_key("fragmentation")
+                .json_literal(std::format("{:.3f}", entry->m_report.fragmentation()))
+                .end_json_object();
+        }
+        builder.end_json_array();
+
+        builder.json_key("classes").begin_json_object_value();
+        for (const auto& entry : reports)
+            WriteClass(builder, entry);
+        builder.end_json_object();
+
+        builder.end_json_object(false);
+
+        std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+        f << builder.str();
+        f.close();
+    }
+} // namespace sdk
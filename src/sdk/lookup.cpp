@@ -0,0 +1,26 @@
+#include "sdk/sdk.h"
+#include "sdk/lookup_tables.h"
+
+namespace sdk {
+    void WriteLookupTables(const scope_snapshot_t& snapshot, const std::string& out_file_path, const ids::registry_t* ids) {
+        std::vector<lookup_class_t> classes(snapshot.m_classes.size());
+        for (std::size_t i = 0; i < snapshot.m_classes.size(); ++i) {
+            const auto class_info = snapshot.m_classes[i];
+            auto& lookup_class = classes[i];
+
+            lookup_class.m_name = class_info->m_pszName;
+            if (ids != nullptr)
+                lookup_class.m_id = *ids->find(ids::kind_t::kClass, class_info->m_pszName);
+
+            for (const auto field : GetNetworkedFields(class_info)) {
+                lookup_class.m_fields.push_back(field->m_pszName);
+                if (ids != nullptr)
+                    lookup_class.m_field_ids.push_back(*ids->find(ids::kind_t::kField, ids::registry_t::field_key(class_info->m_pszName, field->m_pszName)));
+            }
+        }
+
+        std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+        f << RenderLookupTables(GetIdentifierName(snapshot.m_name), classes, ids != nullptr);
+        f.close();
+    }
+} // namespace sdk
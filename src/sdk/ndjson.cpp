@@ -0,0 +1,28 @@
+#include "sdk/sdk.h"
+#include "tools/ndjson.h"
+
+namespace sdk {
+    void WriteNdjsonScope(const rendered_scope_t& rendered, const std::string& out_file_path) {
+        const auto scope_token = ndjson::make_string_token(rendered.m_name);
+
+        // @note: a record drops the indentation of its fragment and adds the scope, kind and name, this rarely grows
+        //
+        std::size_t capacity = 0;
+        for (const auto& fragment : rendered.m_enums)
+            capacity += fragment.m_text.size() + scope_token.size() + 64;
+        for (const auto& fragment : rendered.m_classes)
+            capacity += fragment.m_text.size() + scope_token.size() + 64;
+
+        std::string text;
+        text.reserve(capacity);
+
+        for (const auto& fragment : rendered.m_enums)
+            ndjson::append_record(text, scope_token, "enum", fragment.m_name, fragment.m_text);
+        for (const auto& fragment : rendered.m_classes)
+            ndjson::append_record(text, scope_token, "class", fragment.m_name, fragment.m_text);
+
+        std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+        f << text;
+        f.close();
+    }
+} // namespace sdk
@@ -0,0 +1,196 @@
+#include "sdk/netplan.h"
+#include "sdk/schema_metadata.h"
+#include "sdk/sdk.h"
+#include "tools/binary_writer.h"
+#include <unordered_map>
+
+namespace sdk {
+    namespace {
+        constinit std::array float_type_names = {
+            FNV32("float32"), FNV32("Vector"), FNV32("Vector2D"), FNV32("Vector4D"), FNV32("QAngle"), FNV32("GameTime_t"),
+        };
+
+        struct encoder_rule_t {
+            fnv32::hash m_name;
+            netplan::decoder_t m_decoder;
+        };
+
+        // clang-format off
+        constinit std::array encoder_rules = {
+            encoder_rule_t{FNV32("coord"), netplan::decoder_t::kCoord},
+            encoder_rule_t{FNV32("normal"), netplan::decoder_t::kNormal},
+            encoder_rule_t{FNV32("fixed64"), netplan::decoder_t::kFixed64},
+            encoder_rule_t{FNV32("qangle"), netplan::decoder_t::kQAngle},
+            encoder_rule_t{FNV32("qangle_pitch_yaw"), netplan::decoder_t::kQAnglePitchYaw},
+            encoder_rule_t{FNV32("qangle_precise"), netplan::decoder_t::kQAnglePrecise},
+            encoder_rule_t{FNV32("simtime"), netplan::decoder_t::kSimulationTime},
+            encoder_rule_t{FNV32("runetime"), netplan::decoder_t::kRuneTime},
+        };
+        // clang-format on
+
+        // @note: strip fixed arrays and templates, the decoder is picked per element
+        //
+        CSchemaType* GetElementType(CSchemaType* type) {
+            while (type != nullptr) {
+                if (type->m_eTypeCategory == SCHEMA_TYPE_FIXED_ARRAY) {
+                    type = ((CSchemaType_FixedArray*)type)->m_pElementType;
+                } else if (type->m_eTypeCategory == SCHEMA_TYPE_ATOMIC &&
+                           (type->m_eAtomicCategory == SCHEMA_ATOMIC_T || type->m_eAtomicCategory == SCHEMA_ATOMIC_COLLECTION_OF_T) &&
+                           ((CSchemaType_Atomic_T*)type)->m_pTemplateType != nullptr) {
+                    type = ((CSchemaType_Atomic_T*)type)->m_pTemplateType;
+                } else {
+                    break;
+                }
+            }
+
+            return type;
+        }
+
+        bool IsFloatType(CSchemaType* type) {
+            const auto element_type = GetElementType(type);
+            if (element_type == nullptr)
+                return false;
+
+            const auto hash = fnv32::hash_runtime(element_type->m_sTypeName.Get());
+            return std::find(float_type_names.begin(), float_type_names.end(), hash) != float_type_names.end();
+        }
+
+        // @note: same adjustments as the engine's quantized float decoder does on construction, so a consumer
+        // only has to do `min_value + bits * decode_scale` (zero/integer exactness is left to the consumer)
+        //
+        void ApplyQuantization(netplan::field_t& plan) {
+            const auto steps = static_cast<float>((1ull << plan.bit_count) - 1);
+            const auto range = plan.max_value - plan.min_value;
+            const auto offset = range / static_cast<float>(1ull << plan.bit_count);
+
+            if (plan.encode_flags & netplan::kRoundDown)
+                plan.max_value -= offset;
+            else if (plan.encode_flags & netplan::kRoundUp)
+                plan.min_value += offset;
+
+            const auto adjusted_range = plan.max_value - plan.min_value;
+            plan.decode_scale = adjusted_range / steps;
+            plan.encode_scale = adjusted_range != 0.f ? steps / adjusted_range : 0.f;
+        }
+
+        netplan::decoder_t GetDecoder(const netplan::field_t& plan, const char* encoder, const bool is_float) {
+            if (encoder != nullptr) {
+                const auto hash = fnv32::hash_runtime(encoder);
+                for (const auto& rule : encoder_rules) {
+                    if (rule.m_name == hash)
+                        return rule.m_decoder;
+                }
+
+                return netplan::decoder_t::kOtherEncoder;
+            }
+
+            if (!is_float)
+                return netplan::decoder_t::kDefault;
+
+            if (plan.bit_count <= 0 || plan.bit_count >= 32)
+                return netplan::decoder_t::kNoScale;
+
+            return netplan::decoder_t::kQuantizedFloat;
+        }
+    } // namespace
+
+    void WriteNetworkDecodePlans(const scope_snapshot_t& snapshot, const std::string& out_file_path, const ids::registry_t* ids) {
+        auto classes = snapshot.m_classes;
+
+        // @note: sorted by name so readers can binary search the class table
+        //
+        std::sort(classes.begin(), classes.end(), [](const CSchemaClassInfo* a, const CSchemaClassInfo* b) { return strcmp(a->m_pszName, b->m_pszName) < 0; });
+
+        binary::string_table_t strings;
+        std::vector<netplan::class_t> class_plans;
+        std::vector<netplan::field_t> field_plans;
+        std::vector<std::uint32_t> serializers;
+        std::unordered_map<std::string_view, std::uint16_t> serializer_indices;
+
+        for (const auto class_info : classes) {
+            const auto networked_fields = GetNetworkedFields(class_info);
+            if (networked_fields.empty())
+                continue;
+
+            auto& class_plan = class_plans.emplace_back();
+            class_plan.id = ids != nullptr ? *ids->find(ids::kind_t::kClass, class_info->m_pszName) : netplan::kNoId;
+            class_plan.name = strings.add(class_info->m_pszName);
+            class_plan.first_field = static_cast<std::uint32_t>(field_plans.size());
+            class_plan.field_count = static_cast<std::uint32_t>(networked_fields.size());
+
+            for (const auto field : networked_fields) {
+                const auto metadata = field->m_pStaticMetadata;
+                const auto metadata_count = field->m_nStaticMetadataCount;
+
+                auto& plan = field_plans.emplace_back();
+                plan.id = ids != nullptr ? *ids->find(ids::kind_t::kField, ids::registry_t::field_key(class_info->m_pszName, field->m_pszName)) : netplan::kNoId;
+                plan.name = strings.add(field->m_pszName);
+                plan.type_name = strings.add(field->m_pType->m_sTypeName.Get());
+                plan.encoder = netplan::kNoString;
+                plan.offset = field->m_nSingleInheritanceOffset;
+                plan.min_value = 0.f;
+                plan.max_value = 1.f;
+                plan.serializer = netplan::kNoSerializer;
+
+                if (const auto value = FindMetadata(metadata, metadata_count, "MNetworkBitCount")) {
+                    plan.bit_count = value->m_n_value;
+                    plan.flags |= netplan::kHasBitCount;
+                }
+
+                if (const auto value = FindMetadata(metadata, metadata_count, "MNetworkEncodeFlags"))
+                    plan.encode_flags = static_cast<std::uint32_t>(value->m_n_value);
+
+                if (const auto value = FindMetadata(metadata, metadata_count, "MNetworkPriority"))
+                    plan.priority = value->m_n_value;
+
+                const auto min_value = FindMetadata(metadata, metadata_count, "MNetworkMinValue");
+                const auto max_value = FindMetadata(metadata, metadata_count, "MNetworkMaxValue");
+                if (min_value != nullptr)
+                    plan.min_value = min_value->m_f_value;
+                if (max_value != nullptr)
+                    plan.max_value = max_value->m_f_value;
+                if (min_value != nullptr || max_value != nullptr)
+                    plan.flags |= netplan::kHasRange;
+
+                if (HasMetadata(metadata, metadata_count, "MNetworkChangeCallback"))
+                    plan.flags |= netplan::kHasChangeCallback;
+
+                const auto encoder_value = FindMetadata(metadata, metadata_count, "MNetworkEncoder");
+                const auto encoder = encoder_value != nullptr ? encoder_value->m_p_sz_value : nullptr;
+                if (encoder != nullptr)
+                    plan.encoder = strings.add(encoder);
+
+                plan.decoder = GetDecoder(plan, encoder, IsFloatType(field->m_pType));
+                if (plan.decoder == netplan::decoder_t::kQuantizedFloat)
+                    ApplyQuantization(plan);
+
+                if (const auto value = FindMetadata(metadata, metadata_count, "MNetworkSerializer")) {
+                    const std::string_view serializer = value->m_p_sz_value;
+                    auto it = serializer_indices.find(serializer);
+                    if (it == serializer_indices.end()) {
+                        it = serializer_indices.emplace(serializer, static_cast<std::uint16_t>(serializers.size())).first;
+                        serializers.push_back(strings.add(serializer));
+                    }
+
+                    plan.serializer = it->second;
+                }
+            }
+        }
+
+        netplan::header_t header = {};
+        header.magic = netplan::kMagic;
+        header.version = netplan::kVersion;
+        header.class_count = static_cast<std::uint32_t>(class_plans.size());
+        header.field_count = static_cast<std::uint32_t>(field_plans.size());
+        header.serializer_count = static_cast<std::uint32_t>(serializers.size());
+        header.strings_size = static_cast<std::uint32_t>(strings.data().size());
+
+        binary::writer_t writer;
+        writer.write(header).write_array(class_plans).write_array(field_plans).write_array(serializers);
+        writer.write_bytes(strings.data().data(), strings.data().size());
+
+        std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+        f.write(reinterpret_cast<const char*>(writer.data().data()), static_cast<std::streamsize>(writer.size()));
+        f.close();
+    }
+} // namespace sdk
@@ -0,0 +1,140 @@
+#include "sdk/sdk.h"
+#include "tools/wildcard.h"
+#include <charconv>
+
+namespace sdk {
+    bool ParseDumpOption(dump_options_t& options, std::string_view arg) {
+        if (arg == "-netplan") {
+            options.m_network_decode_plans = true;
+            return true;
+        }
+
+        if (arg == "-lookup") {
+            options.m_lookup_tables = true;
+            return true;
+        }
+
+        if (arg == "-enums") {
+            options.m_enum_tables = true;
+            return true;
+        }
+
+        if (arg == "-layout") {
+            options.m_layout_report = layout_report_t::kAll;
+            return true;
+        }
+
+        if (arg == "-layout=networked") {
+            options.m_layout_report = layout_report_t::kNetworked;
+            return true;
+        }
+
+        if (arg == "-sizes") {
+            options.m_size_report = true;
+            return true;
+        }
+
+        if (arg == "-ndjson") {
+            options.m_ndjson = true;
+            return true;
+        }
+
+        if (arg == "-idx") {
+            options.m_dump_index = true;
+            return true;
+        }
+
+        if (arg == "-dedup") {
+            options.m_deduplicate = true;
+            return true;
+        }
+
+        if (arg == "-async") {
+            options.m_async = true;
+            return true;
+        }
+
+        if (arg.starts_with("-roots=")) {
+            const auto roots = wildcard::split_list(arg.substr(std::string_view("-roots=").size()));
+            options.m_root_patterns.insert(options.m_root_patterns.end(), roots.begin(), roots.end());
+            return !roots.empty();
+        }
+
+        if (arg.starts_with("-scopes=")) {
+            const auto scopes = wildcard::split_list(arg.substr(std::string_view("-scopes=").size()));
+            options.m_scope_patterns.insert(options.m_scope_patterns.end(), scopes.begin(), scopes.end());
+            return !scopes.empty();
+        }
+
+        if (arg.starts_with("-classes=")) {
+            const auto classes = wildcard::split_list(arg.substr(std::string_view("-classes=").size()));
+            options.m_class_patterns.insert(options.m_class_patterns.end(), classes.begin(), classes.end());
+            return !classes.empty();
+        }
+
+        if (arg.starts_with("-ids=")) {
+            options.m_id_registry_path = arg.substr(std::string_view("-ids=").size());
+            return !options.m_id_registry_path.empty();
+        }
+
+        if (arg.starts_with("-shm=")) {
+            options.m_shared_memory_name = arg.substr(std::string_view("-shm=").size());
+            return !options.m_shared_memory_name.empty();
+        }
+
+        if (arg.starts_with("-archive=")) {
+            options.m_archive_build = arg.substr(std::string_view("-archive=").size());
+            return !options.m_archive_build.empty();
+        }
+
+        if (arg.starts_with("-shards=")) {
+            const auto value = arg.substr(std::string_view("-shards=").size());
+            const auto separator = value.find(':');
+            if (separator == std::string_view::npos)
+                return false;
+
+            const auto mode = value.substr(0, separator);
+            const auto parameter = value.substr(separator + 1);
+            if (mode == "prefix")
+                options.m_shard_mode = shard_mode_t::kPrefix;
+            else if (mode == "size")
+                options.m_shard_mode = shard_mode_t::kSize;
+            else if (mode == "deps")
+                options.m_shard_mode = shard_mode_t::kDependencies;
+            else
+                return false;
+
+            const auto [end, error] = std::from_chars(parameter.data(), parameter.data() + parameter.size(), options.m_shard_parameter);
+            if (parameter.empty() || error != std::errc() || end != parameter.data() + parameter.size() || options.m_shard_parameter == 0)
+                return false;
+
+            if (options.m_shard_mode == shard_mode_t::kSize)
+                options.m_shard_parameter *= 1024;
+
+            return true;
+        }
+
+        if (arg == "-compress") {
+            options.m_compress_block_size = 64 * 1024;
+            return true;
+        }
+
+        if (arg.starts_with("-compress=")) {
+            const auto value = arg.substr(std::string_view("-compress=").size());
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), options.m_compress_block_size);
+            if (value.empty() || error != std::errc() || end != value.data() + value.size() || options.m_compress_block_size == 0)
+                return false;
+
+            options.m_compress_block_size *= 1024;
+            return true;
+        }
+
+        if (arg.starts_with("-threads=")) {
+            const auto value = arg.substr(std::string_view("-threads=").size());
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), options.m_threads);
+            return !value.empty() && error == std::errc() && end == value.data() + value.size();
+        }
+
+        return false;
+    }
+} // namespace sdk
@@ -0,0 +1,96 @@
+#include "sdk/sdk.h"
+#include "tools/wildcard.h"
+#include <unordered_set>
+
+namespace sdk {
+    namespace {
+        struct reachable_set_t {
+            std::unordered_set<const CSchemaClassInfo*> m_classes;
+            std::unordered_set<const CSchemaEnumInfo*> m_enums;
+            std::vector<CSchemaClassInfo*> m_pending;
+
+            void AddClass(CSchemaClassInfo* class_info) {
+                if (class_info != nullptr && m_classes.insert(class_info).second)
+                    m_pending.push_back(class_info);
+            }
+
+            // @note: walks the same type tree as WriteTypeJson does
+            //
+            void AddType(CSchemaType* type) {
+                while (type != nullptr) {
+                    switch (type->m_eTypeCategory) {
+                    case SCHEMA_TYPE_DECLARED_CLASS:
+                        AddClass(((CSchemaType_DeclaredClass*)type)->m_pClassInfo);
+                        return;
+                    case SCHEMA_TYPE_DECLARED_ENUM:
+                        if (const auto enum_info = ((CSchemaType_DeclaredEnum*)type)->m_pEnumInfo)
+                            m_enums.insert(enum_info);
+                        return;
+                    case SCHEMA_TYPE_FIXED_ARRAY:
+                        type = ((CSchemaType_FixedArray*)type)->m_pElementType;
+                        break;
+                    case SCHEMA_TYPE_PTR:
+                        type = type->GetInnerType().Get();
+                        break;
+                    case SCHEMA_TYPE_ATOMIC:
+                        if (type->m_eAtomicCategory != SCHEMA_ATOMIC_T && type->m_eAtomicCategory != SCHEMA_ATOMIC_COLLECTION_OF_T)
+                            return;
+                        type = ((CSchemaType_Atomic_T*)type)->m_pTemplateType;
+                        break;
+                    default:
+                        return;
+                    }
+                }
+            }
+
+            void Expand() {
+                while (!m_pending.empty()) {
+                    const auto class_info = m_pending.back();
+                    m_pending.pop_back();
+
+                    for (int i = 0; i < class_info->m_nBaseClassCount; ++i)
+                        AddClass(class_info->m_pBaseClasses[i].m_pClass);
+
+                    for (const auto field : GetNetworkedFields(class_info))
+                        AddType(field->m_pType);
+                }
+            }
+        };
+    } // namespace
+
+    prune_stats_t PruneUnreachableTypes(std::vector<scope_snapshot_t>& snapshots, const std::vector<std::string>& root_patterns) {
+        reachable_set_t reachable;
+
+        // @note: roots are looked up in every scope, a type found through a field can live in another scope
+        //
+        for (const auto& snapshot : snapshots) {
+            for (const auto class_info : snapshot.m_classes) {
+                if (wildcard::match_any(root_patterns, class_info->m_pszName))
+                    reachable.AddClass(class_info);
+            }
+
+            for (const auto enum_info : snapshot.m_enums) {
+                if (wildcard::match_any(root_patterns, enum_info->m_pszName))
+                    reachable.m_enums.insert(enum_info);
+            }
+        }
+
+        reachable.Expand();
+
+        prune_stats_t stats;
+        for (auto& snapshot : snapshots) {
+            const auto class_count = snapshot.m_classes.size();
+            const auto enum_count = snapshot.m_enums.size();
+
+            std::erase_if(snapshot.m_classes, [&](const CSchemaClassInfo* class_info) { return !reachable.m_classes.contains(class_info); });
+            std::erase_if(snapshot.m_enums, [&](const CSchemaEnumInfo* enum_info) { return !reachable.m_enums.contains(enum_info); });
+
+            stats.m_kept_classes += snapshot.m_classes.size();
+            stats.m_pruned_classes += class_count - snapshot.m_classes.size();
+            stats.m_kept_enums += snapshot.m_enums.size();
+            stats.m_pruned_enums += enum_count - snapshot.m_enums.size();
+        }
+
+        return stats;
+    }
+} // namespace sdk
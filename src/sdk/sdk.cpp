@@ -1,77 +1,64 @@
 #include "sdk/sdk.h"
+#include "sdk/schema_metadata.h"
+#include <cctype>
 #include <filesystem>
+#include <functional>
 #include <set>
 #include <string_view>
 
 namespace {
     using namespace std::string_view_literals;
 
-    struct CSchemaVarName {
-        const char* m_name;
-        const char* m_type;
-    };
-
-    struct CSchemaNetworkValue {
-        union {
-            const char* m_p_sz_value;
-            int m_n_value;
-            float m_f_value;
-            std::uintptr_t m_p_value;
-            CSchemaVarName m_var_value;
-            std::array<char, 32> m_sz_value;
-        };
-    };
-
-    constinit std::array string_metadata_entries = {FNV32("MNetworkChangeCallback"),
-                                                    FNV32("MPropertyFriendlyName"),
-                                                    FNV32("MPropertyDescription"),
-                                                    FNV32("MPropertyAttributeRange"),
-                                                    FNV32("MPropertyStartGroup"),
-                                                    FNV32("MPropertyAttributeChoiceName"),
-                                                    FNV32("MPropertyGroupName"),
-                                                    FNV32("MNetworkUserGroup"),
-                                                    FNV32("MNetworkAlias"),
-                                                    FNV32("MNetworkTypeAlias"),
-                                                    FNV32("MNetworkSerializer"),
-                                                    FNV32("MPropertyAttributeEditor"),
-                                                    FNV32("MPropertySuppressExpr"),
-                                                    FNV32("MKV3TransferName"),
-                                                    FNV32("MFieldVerificationName"),
-                                                    FNV32("MVectorIsSometimesCoordinate"),
-                                                    FNV32("MNetworkEncoder"),
-                                                    FNV32("MPropertyCustomFGDType"),
-                                                    FNV32("MVDataUniqueMonotonicInt"),
-                                                    FNV32("MScriptDescription")};
+    constinit std::array string_metadata_entries = {WHASH64("MNetworkChangeCallback"),
+                                                    WHASH64("MPropertyFriendlyName"),
+                                                    WHASH64("MPropertyDescription"),
+                                                    WHASH64("MPropertyAttributeRange"),
+                                                    WHASH64("MPropertyStartGroup"),
+                                                    WHASH64("MPropertyAttributeChoiceName"),
+                                                    WHASH64("MPropertyGroupName"),
+                                                    WHASH64("MNetworkUserGroup"),
+                                                    WHASH64("MNetworkAlias"),
+                                                    WHASH64("MNetworkTypeAlias"),
+                                                    WHASH64("MNetworkSerializer"),
+                                                    WHASH64("MPropertyAttributeEditor"),
+                                                    WHASH64("MPropertySuppressExpr"),
+                                                    WHASH64("MKV3TransferName"),
+                                                    WHASH64("MFieldVerificationName"),
+                                                    WHASH64("MVectorIsSometimesCoordinate"),
+                                                    WHASH64("MNetworkEncoder"),
+                                                    WHASH64("MPropertyCustomFGDType"),
+                                                    WHASH64("MVDataUniqueMonotonicInt"),
+                                                    WHASH64("MScriptDescription")};
 
     constinit std::array string_class_metadata_entries = {
-        FNV32("MResourceTypeForInfoType"),
+        WHASH64("MResourceTypeForInfoType"),
     };
 
     constinit std::array var_name_string_class_metadata_entries = {
-        FNV32("MNetworkVarNames"),
-        FNV32("MNetworkOverride"),
-        FNV32("MNetworkVarTypeOverride"),
+        WHASH64("MNetworkVarNames"),
+        WHASH64("MNetworkOverride"),
+        WHASH64("MNetworkVarTypeOverride"),
     };
 
     constinit std::array var_string_class_metadata_entries = {
-        FNV32("MPropertyArrayElementNameKey"), FNV32("MPropertyFriendlyName"),      FNV32("MPropertyDescription"),
-        FNV32("MNetworkExcludeByName"),        FNV32("MNetworkExcludeByUserGroup"), FNV32("MNetworkIncludeByName"),
-        FNV32("MNetworkIncludeByUserGroup"),   FNV32("MNetworkUserGroupProxy"),     FNV32("MNetworkReplayCompatField"),
+        WHASH64("MPropertyArrayElementNameKey"), WHASH64("MPropertyFriendlyName"),      WHASH64("MPropertyDescription"),
+        WHASH64("MNetworkExcludeByName"),        WHASH64("MNetworkExcludeByUserGroup"), WHASH64("MNetworkIncludeByName"),
+        WHASH64("MNetworkIncludeByUserGroup"),   WHASH64("MNetworkUserGroupProxy"),     WHASH64("MNetworkReplayCompatField"),
     };
 
     constinit std::array integer_metadata_entries = {
-        FNV32("MNetworkVarEmbeddedFieldOffsetDelta"),
-        FNV32("MNetworkBitCount"),
-        FNV32("MNetworkPriority"),
-        FNV32("MPropertySortPriority"),
-        FNV32("MParticleMinVersion"),
-        FNV32("MParticleMaxVersion"),
-        FNV32("MNetworkEncodeFlags"),
+        WHASH64("MNetworkVarEmbeddedFieldOffsetDelta"),
+        WHASH64("MNetworkBitCount"),
+        WHASH64("MNetworkPriority"),
+        WHASH64("MPropertySortPriority"),
+        WHASH64("MParticleMinVersion"),
+        WHASH64("MParticleMaxVersion"),
+        WHASH64("MNetworkEncodeFlags"),
     };
 
     constinit std::array float_metadata_entries = {
-        FNV32("MNetworkMinValue"),
-        FNV32("MNetworkMaxValue"),
+        WHASH64("MNetworkMinValue"),
+        WHASH64("MNetworkMaxValue"),
     };
 
     inline bool ends_with(const std::string& str, const std::string& suffix) {
@@ -80,15 +67,51 @@ namespace {
 } // namespace
 
 namespace sdk {
+    std::vector<const SchemaClassFieldData_t*> GetNetworkedFields(CSchemaClassInfo* class_info) {
+        bool is_atomic = false;
+        std::set<std::string> network_var_names;
+        for (int metadataIdx = 0; metadataIdx < class_info->m_nStaticMetadataCount; ++metadataIdx) {
+            const auto& metadata = class_info->m_pStaticMetadata[metadataIdx];
+            const auto metadata_value = ((CSchemaNetworkValue*)metadata.m_pData);
+            if (strcmp(metadata.m_pszName, "MNetworkVarNames") == 0) {
+                // Keep track of all network vars
+                network_var_names.insert(metadata_value->m_var_value.m_name);
+            } else if (strcmp(metadata.m_pszName, "MNetworkVarsAtomic") == 0) {
+                is_atomic = true;
+            }
+        }
+
+        std::vector<const SchemaClassFieldData_t*> result;
+        for (int fieldIdx = 0; fieldIdx < class_info->m_nFieldCount; ++fieldIdx) {
+            const auto& field = class_info->m_pFields[fieldIdx];
+            if (!network_var_names.contains(field.m_pszName) && !is_atomic) {
+                bool is_network_enable = strcmp(class_info->m_pszName, "ServerAuthoritativeWeaponSlot_t") == 0;
+                if (!is_network_enable)
+                    is_network_enable = HasMetadata(field.m_pStaticMetadata, field.m_nStaticMetadataCount, "MNetworkEnable");
+
+                if (!is_network_enable) {
+                    continue;
+                }
+            }
+
+            result.push_back(&field);
+        }
+
+        return result;
+    }
+
     namespace {
-        void AssembleEnums(codegen::generator_t::self_ref builder, CUtlTSHash<CSchemaEnumInfo*, 256, uint>& enums) {
-            builder.json_key("enums").begin_json_object_value();
+        // @note: fragments are rendered at the depth they end up at in the scope file, i.e. inside "enums"/"classes"
+        //
+        constexpr std::size_t kFragmentTabs = 2 * codegen::kTabsPerBlock;
 
-            UtlTSHashHandle_t* handles = new UtlTSHashHandle_t[enums.Count()];
-            enums.GetElements(0, enums.Count(), handles);
+        std::vector<type_fragment_t> AssembleEnums(const std::vector<CSchemaEnumInfo*>& enums, const ids::registry_t* ids, codegen::key_cache_t& key_cache) {
+            std::vector<type_fragment_t> fragments;
+            fragments.reserve(enums.size());
 
-            for (int i = 0; i < enums.Count(); ++i) {
-                auto schema_enum_binding = enums[handles[i]];
+            for (const auto schema_enum_binding : enums) {
+                auto builder = codegen::get();
+                builder.use_key_cache(&key_cache).inc_tabs_count(kFragmentTabs);
 
                 // @note: @es3n1n: get type name by align size
                 //
@@ -123,6 +146,9 @@ namespace sdk {
                 //
                 builder.json_key(schema_enum_binding->m_pszName).begin_json_object_value();
 
+                if (ids != nullptr)
+                    builder.json_key("id").json_literal(*ids->find(ids::kind_t::kEnum, schema_enum_binding->m_pszName));
+
                 builder.json_key("align").json_literal(schema_enum_binding->m_nAlignment);
 
                 // @note: @es3n1n: assemble enum items
@@ -134,7 +160,7 @@ namespace sdk {
                         .json_key("name")
                         .json_string(field.m_pszName)
                         .json_key("value")
-                        .json_literal(field.m_nValue == std::numeric_limits<int64>::max() ? -1 : field.m_nValue)
+                        .json_literal(GetEnumeratorValue(field))
                         .end_json_object();
                 }
                 builder.end_json_array();
@@ -142,9 +168,11 @@ namespace sdk {
                 // @note: @es3n1n: we are done with this enum
                 //
                 builder.end_json_object();
+
+                fragments.push_back({schema_enum_binding->m_pszName, builder.str()});
             }
 
-            builder.end_json_object();
+            return fragments;
         }
 
         void WriteTypeJson(codegen::generator_t::self_ref builder, CSchemaType* current_type) {
@@ -178,7 +206,8 @@ namespace sdk {
             builder.end_json_object();
         }
 
-        void AssembleClasses(CSchemaSystemTypeScope* current, codegen::generator_t::self_ref builder, CUtlTSHash<CSchemaClassInfo*, 256, uint>& classes) {
+        std::vector<type_fragment_t> AssembleClasses(const std::vector<CSchemaClassInfo*>& classes, const ids::registry_t* ids, codegen::key_cache_t& key_cache,
+                                                     size_report_t* sizes) {
             struct class_t {
                 CSchemaClassInfo* target_;
                 std::set<CSchemaClassInfo*> refs_;
@@ -225,11 +254,7 @@ namespace sdk {
             // ==================
             std::list<class_t> classes_to_dump;
 
-            UtlTSHashHandle_t* handles = new UtlTSHashHandle_t[classes.Count()];
-            classes.GetElements(0, classes.Count(), handles);
-
-            for (int i = 0; i < classes.Count(); ++i) {
-                auto class_info = classes[handles[i]];
+            for (const auto class_info : classes) {
                 auto& class_dump = classes_to_dump.emplace_back();
                 class_dump.target_ = class_info;
 
@@ -278,7 +303,8 @@ namespace sdk {
             } while (did_change);
             // ==================
 
-            builder.json_key("classes").begin_json_object_value();
+            std::vector<type_fragment_t> fragments;
+            fragments.reserve(classes_to_dump.size());
 
             for (auto& class_dump : classes_to_dump) {
                 // @note: @es3n1n: get class info, assemble it
@@ -286,8 +312,14 @@ namespace sdk {
                 const auto class_parent = class_dump.GetParent();
                 const auto class_info = class_dump.target_;
 
+                auto builder = codegen::get();
+                builder.use_key_cache(&key_cache).inc_tabs_count(kFragmentTabs);
+
                 builder.json_key(class_info->m_pszName).begin_json_object_value();
 
+                if (ids != nullptr)
+                    builder.json_key("id").json_literal(*ids->find(ids::kind_t::kClass, class_info->m_pszName));
+
                 if (class_info->m_nBaseClassCount >= 1) {
                     builder.json_key("parent").json_string(class_info->m_pBaseClasses[0].m_pClass->m_pszName);
                 }
@@ -295,7 +327,7 @@ namespace sdk {
                 auto write_metadata_json = [&](const SchemaMetadataEntryData_t metadata_entry) -> void {
                     std::string value;
 
-                    const auto value_hash_name = fnv32::hash_runtime(metadata_entry.m_pszName);
+                    const auto value_hash_name = whash64::hash_runtime(metadata_entry.m_pszName);
 
                     builder.begin_json_object();
                     builder.json_key("name").json_string(metadata_entry.m_pszName);
@@ -335,26 +367,20 @@ namespace sdk {
                     builder.end_json_object();
                 };
 
-                bool is_atomic = false;
-                std::set<std::string> network_var_names;
+                const auto write_measured_metadata_json = [&](const SchemaMetadataEntryData_t& metadata_entry) -> void {
+                    const auto entry = sizes != nullptr ? &sizes->m_metadata[whash64::hash_runtime(metadata_entry.m_pszName)] : nullptr;
+                    MeasureSize(builder, entry, metadata_entry.m_pszName, [&] { write_metadata_json(metadata_entry); });
+                };
+
                 builder.json_key("metadata").begin_json_array_value();
                 for (int metadataIdx = 0; metadataIdx < class_info->m_nStaticMetadataCount; ++metadataIdx) { 
                     const auto& metadata = class_info->m_pStaticMetadata[metadataIdx];
-                    const auto metadata_value = ((CSchemaNetworkValue*)metadata.m_pData);
                     if (strcmp(metadata.m_pszName, "MNetworkVarNames") == 0) {
-                        // Keep track of all network vars
-                        network_var_names.insert(metadata_value->m_var_value.m_name);
-
                         // don't write var names - too verbose
                         continue;
                     }
-                    
-                    if (strcmp(metadata.m_pszName, "MNetworkVarsAtomic") == 0)
-                    {
-                        is_atomic = true;
-                    }
 
-                    write_metadata_json(metadata);
+                    write_measured_metadata_json(metadata);
                 }
                 builder.end_json_array();
 
@@ -367,33 +393,25 @@ namespace sdk {
                     printf(".");
                 }
 
-                for (int fieldIdx = 0; fieldIdx < class_info->m_nFieldCount; ++fieldIdx) { 
-                    const auto& field = class_info->m_pFields[fieldIdx];
-                    if (!network_var_names.contains(field.m_pszName) && !is_atomic) {
-                        bool is_network_enable = strcmp(class_info->m_pszName, "ServerAuthoritativeWeaponSlot_t") == 0;
-                        for (auto j = 0; j < field.m_nStaticMetadataCount; j++) {
-                            if (strcmp(field.m_pStaticMetadata[j].m_pszName, "MNetworkEnable") == 0) {
-                                is_network_enable = true;
-                                break;
-                            }
-                        }
-
-                        if (!is_network_enable) {
-                            continue;
-                        }
-                    }
+                for (const auto field_ptr : GetNetworkedFields(class_info)) {
+                    const auto& field = *field_ptr;
 
                     builder.begin_json_object().json_key("name").json_string(field.m_pszName);
 
+                    if (ids != nullptr)
+                        builder.json_key("id").json_literal(*ids->find(ids::kind_t::kField, ids::registry_t::field_key(class_info->m_pszName, field.m_pszName)));
+
                     builder.json_key("type");
 
-                    WriteTypeJson(builder, field.m_pType);
+                    const auto type_name = field.m_pType->m_sTypeName.Get();
+                    const auto entry = sizes != nullptr ? &sizes->m_field_types[whash64::hash_runtime(type_name)] : nullptr;
+                    MeasureSize(builder, entry, type_name, [&] { WriteTypeJson(builder, field.m_pType); });
 
                     builder.json_key("metadata").begin_json_array_value();
 
                     for (auto j = 0; j < field.m_nStaticMetadataCount; j++) {
                         if (strcmp(field.m_pStaticMetadata[j].m_pszName, "MNetworkEnable")) {
-                            write_metadata_json(field.m_pStaticMetadata[j]);
+                            write_measured_metadata_json(field.m_pStaticMetadata[j]);
                         }
                     }
 
@@ -405,19 +423,99 @@ namespace sdk {
                 builder.end_json_array();
 
                 builder.end_json_object();
+
+                fragments.push_back({class_info->m_pszName, builder.str()});
             }
 
-            builder.end_json_object();
+            return fragments;
         }
     } // namespace
 
-    void GenerateTypeScopeSdk(CSchemaSystemTypeScope* current, const char* outDirName) {
+    std::string GetIdentifierName(const std::string& name) {
+        std::string result;
+        for (const auto c : name) {
+            if (std::isalnum(static_cast<unsigned char>(c)) || c == '_')
+                result.push_back(c);
+            else if (!result.empty() && result.back() != '_')
+                result.push_back('_');
+        }
+
+        if (result.empty() || std::isdigit(static_cast<unsigned char>(result.front())))
+            result.insert(result.begin(), '_');
+
+        return result;
+    }
+
+    std::int64_t GetEnumeratorValue(const SchemaEnumeratorInfoData_t& enumerator) {
+        return enumerator.m_nValue == std::numeric_limits<int64>::max() ? -1 : enumerator.m_nValue;
+    }
+
+    std::string GetTypeScopeName(CSchemaSystemTypeScope* current) {
         // @note: @es3n1n: getting current scope name & formatting it
         //
         constexpr std::string_view dll_extension = ".dll";
-        std::string scope_name = current->GetScopeName();
-        if (ends_with(scope_name.data(), dll_extension.data()))
-            scope_name.erase(scope_name.length() - dll_extension.size());
+        std::string result = current->GetScopeName();
+        if (ends_with(result.data(), dll_extension.data()))
+            result.erase(result.length() - dll_extension.size());
+
+        return result;
+    }
+
+    scope_snapshot_t SnapshotTypeScope(CSchemaSystemTypeScope* current) {
+        scope_snapshot_t snapshot;
+        snapshot.m_name = GetTypeScopeName(current);
+
+        auto& enums = current->m_EnumBindings;
+        std::vector<UtlTSHashHandle_t> enum_handles(enums.Count());
+        enums.GetElements(0, enums.Count(), enum_handles.data());
+        for (const auto handle : enum_handles)
+            snapshot.m_enums.push_back(enums[handle]);
+
+        auto& classes = current->m_ClassBindings;
+        std::vector<UtlTSHashHandle_t> class_handles(classes.Count());
+        classes.GetElements(0, classes.Count(), class_handles.data());
+        for (const auto handle : class_handles)
+            snapshot.m_classes.push_back(classes[handle]);
+
+        return snapshot;
+    }
+
+    rendered_scope_t RenderTypeScope(const scope_snapshot_t& snapshot, const ids::registry_t* ids, size_report_t* sizes) {
+        rendered_scope_t rendered;
+        rendered.m_name = snapshot.m_name;
+
+        // @note: @es3n1n: assemble props
+        //
+        // @note: keys are literals and schema names, so they can be escaped once for the whole scope
+        //
+        codegen::key_cache_t key_cache;
+        rendered.m_enums = AssembleEnums(snapshot.m_enums, ids, key_cache);
+        rendered.m_classes = AssembleClasses(snapshot.m_classes, ids, key_cache, sizes);
+
+        if (sizes != nullptr)
+            AddFragmentSizes(*sizes, rendered);
+
+        return rendered;
+    }
+
+    void WriteScopeExtras(const scope_snapshot_t& snapshot, const char* outDirName, const dump_options_t& options, const ids::registry_t* ids) {
+        const auto& scope_name = snapshot.m_name;
+
+        if (options.m_network_decode_plans)
+            WriteNetworkDecodePlans(snapshot, std::format("{}\\{}.netplan.bin", outDirName, scope_name), ids);
+
+        if (options.m_lookup_tables)
+            WriteLookupTables(snapshot, std::format("{}\\{}_lookup.hpp", outDirName, scope_name), ids);
+
+        if (options.m_enum_tables)
+            WriteEnumTables(snapshot, std::format("{}\\{}.enums.bin", outDirName, scope_name), std::format("{}\\{}_enums.hpp", outDirName, scope_name));
+
+        if (options.m_layout_report != layout_report_t::kNone)
+            WriteLayoutReport(snapshot, std::format("{}\\{}.layout.json", outDirName, scope_name), options.m_layout_report);
+    }
+
+    void GenerateTypeScopeSdk(const scope_snapshot_t& snapshot, const char* outDirName, const dump_options_t& options, const ids::registry_t* ids) {
+        const auto& scope_name = snapshot.m_name;
 
         // @note: @es3n1n: build file path
         //
@@ -425,21 +523,45 @@ namespace sdk {
             std::filesystem::create_directories(outDirName);
         const std::string out_file_path = std::format("{}\\{}.json", outDirName, scope_name);
 
-        auto builder = codegen::get();
+        size_report_t sizes;
+        const auto rendered = RenderTypeScope(snapshot, ids, options.m_size_report ? &sizes : nullptr);
+        if (options.m_size_report)
+            WriteSizeReport(sizes, std::format("{}\\{}.sizes.json", outDirName, scope_name));
 
-        builder.begin_json_object();
+        if (options.m_shard_mode != shard_mode_t::kNone) {
+            WriteShardedScope(snapshot, rendered, outDirName, options);
+            WriteScopeExtras(snapshot, outDirName, options, ids);
+            return;
+        }
 
-        // @note: @es3n1n: assemble props
+        if (options.m_ndjson) {
+            WriteNdjsonScope(rendered, std::format("{}\\{}.ndjson", outDirName, scope_name));
+            WriteScopeExtras(snapshot, outDirName, options, ids);
+            return;
+        }
+
+        // @note: compression needs the entries too, blocks are cut where they start
         //
-        AssembleEnums(builder, current->m_EnumBindings);
-        AssembleClasses(current, builder, current->m_ClassBindings);
+        const auto compress = options.m_compress_block_size != 0;
+        std::vector<dump_index::entry_t> index_entries;
+        const auto text = AssembleScopeJson(rendered, options.m_dump_index || compress ? &index_entries : nullptr);
+
+        if (compress) {
+            WriteCompressedJson(text, index_entries, options.m_compress_block_size, options.m_threads,
+                                std::format("{}\\{}.jsonlz", outDirName, scope_name));
+        } else {
+            // @note: @es3n1n: write generated data to output file
+            //
+            // binary, so the offsets in the sidecar match the file on every platform
+            //
+            std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+            f << text;
+            f.close();
+        }
 
-        builder.end_json_object(false);
+        if (options.m_dump_index)
+            WriteDumpIndex(std::move(index_entries), text.size(), std::format("{}\\{}.idx", outDirName, scope_name));
 
-        // @note: @es3n1n: write generated data to output file
-        //
-        std::ofstream f(out_file_path, std::ios::out);
-        f << builder.str();
-        f.close();
+        WriteScopeExtras(snapshot, outDirName, options, ids);
     }
 } // namespace sdk
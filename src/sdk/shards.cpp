@@ -0,0 +1,83 @@
+#include "sdk/sdk.h"
+#include "sdk/shards.h"
+#include <unordered_map>
+
+namespace sdk {
+    namespace {
+        // @note: what a type needs to be complete: its base classes and the types it holds by value. a pointer or a template
+        // argument (handles, vectors) only needs a declaration, so it doesn't order anything
+        //
+        void AddValueDependency(std::vector<std::uint32_t>& edges, const std::unordered_map<const char*, std::uint32_t>& nodes, CSchemaType* type) {
+            while (type != nullptr && type->m_eTypeCategory == SCHEMA_TYPE_FIXED_ARRAY)
+                type = ((CSchemaType_FixedArray*)type)->m_pElementType;
+
+            if (type == nullptr)
+                return;
+
+            const char* name = nullptr;
+            if (type->m_eTypeCategory == SCHEMA_TYPE_DECLARED_CLASS && ((CSchemaType_DeclaredClass*)type)->m_pClassInfo != nullptr)
+                name = ((CSchemaType_DeclaredClass*)type)->m_pClassInfo->m_pszName;
+            else if (type->m_eTypeCategory == SCHEMA_TYPE_DECLARED_ENUM && ((CSchemaType_DeclaredEnum*)type)->m_pEnumInfo != nullptr)
+                name = ((CSchemaType_DeclaredEnum*)type)->m_pEnumInfo->m_pszName;
+
+            // @note: types of other scopes aren't in the graph, they are in another file anyway
+            //
+            if (const auto it = nodes.find(name); name != nullptr && it != nodes.end())
+                edges.push_back(it->second);
+        }
+
+        // @note: enums and classes are the nodes, in this order, fragments and schema share the name pointers
+        //
+        partition::graph_t GetDependencyGraph(const scope_snapshot_t& snapshot, const rendered_scope_t& rendered) {
+            std::unordered_map<const char*, std::uint32_t> nodes;
+            partition::graph_t graph;
+            const auto add_node = [&](const type_fragment_t& fragment) {
+                nodes.emplace(fragment.m_name, static_cast<std::uint32_t>(graph.m_weights.size()));
+                graph.m_weights.push_back(fragment.m_text.size());
+            };
+
+            for (const auto& fragment : rendered.m_enums)
+                add_node(fragment);
+            for (const auto& fragment : rendered.m_classes)
+                add_node(fragment);
+            graph.m_edges.resize(graph.m_weights.size());
+
+            for (const auto class_info : snapshot.m_classes) {
+                const auto node = nodes.find(class_info->m_pszName);
+                if (node == nodes.end())
+                    continue;
+
+                auto& edges = graph.m_edges[node->second];
+                for (auto i = 0; i < class_info->m_nBaseClassCount; ++i) {
+                    const auto base = class_info->m_pBaseClasses[i].m_pClass;
+                    if (const auto it = base != nullptr ? nodes.find(base->m_pszName) : nodes.end(); it != nodes.end())
+                        edges.push_back(it->second);
+                }
+
+                for (const auto field : GetNetworkedFields(class_info))
+                    AddValueDependency(edges, nodes, field->m_pType);
+            }
+
+            return graph;
+        }
+    } // namespace
+
+    void WriteShardedScope(const scope_snapshot_t& snapshot, const rendered_scope_t& rendered, const char* outDirName, const dump_options_t& options) {
+        partition_stats_t partition_stats;
+        std::vector<shard_t> shards;
+        switch (options.m_shard_mode) {
+        case shard_mode_t::kPrefix:
+            shards = SplitByPrefix(rendered, options.m_shard_parameter);
+            break;
+        case shard_mode_t::kSize:
+            shards = SplitBySize(rendered, options.m_shard_parameter);
+            break;
+        default:
+            shards = SplitByPartitions(rendered, GetDependencyGraph(snapshot, rendered), options.m_shard_parameter, partition_stats);
+            break;
+        }
+
+        WriteShards(rendered, shards, outDirName, options.m_shard_mode == shard_mode_t::kDependencies ? &partition_stats : nullptr, options.m_dump_index,
+                    options.m_threads);
+    }
+} // namespace sdk
@@ -0,0 +1,9 @@
+#include "sdk/sdk.h"
+
+namespace sdk {
+    void WriteSizeReport(const size_report_t& report, const std::string& out_file_path) {
+        std::ofstream f(out_file_path, std::ios::out | std::ios::binary);
+        f << RenderSizeReport(report);
+        f.close();
+    }
+} // namespace sdk
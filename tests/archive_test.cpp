@@ -0,0 +1,163 @@
+#include "sdk/archive_store.h"
+#include "synthetic_scope.h"
+#include "test.h"
+#include <tuple>
+
+// Three synthetic builds archived one after the other: the first stores every definition once, later ones only the
+// definitions that changed, a reverted class finds its old object again. Materializing a build gives back the exact
+// json a plain dump of it writes, and the history of a type lists the builds that added, changed or removed it.
+namespace {
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream f(path, std::ios::in | std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    }
+
+    std::size_t count_objects(const std::filesystem::path& archive_dir) {
+        std::size_t count = 0;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(archive_dir / "objects"))
+            count += entry.is_regular_file() ? 1 : 0;
+
+        return count;
+    }
+
+    struct build_t {
+        std::string m_name;
+        std::vector<synthetic::scope_t> m_scopes;
+
+        [[nodiscard]] std::vector<sdk::rendered_scope_t> rendered() const {
+            std::vector<sdk::rendered_scope_t> result;
+            for (const auto& scope : m_scopes)
+                result.push_back(scope.m_rendered);
+
+            return result;
+        }
+    };
+
+    synthetic::type_t* find_type(std::vector<synthetic::type_t>& types, const std::string_view name) {
+        const auto it = std::find_if(types.begin(), types.end(), [&](const synthetic::type_t& type) { return type.m_name == name; });
+        return it != types.end() ? &*it : nullptr;
+    }
+
+    // @note: "EShared" is the same in both scopes, so it's stored once
+    //
+    struct schema_t {
+        std::vector<synthetic::type_t> m_client_enums = synthetic::make_types("E_Client", 20, 5);
+        std::vector<synthetic::type_t> m_client_classes = synthetic::make_types("C_Client", 120, 10);
+        std::vector<synthetic::type_t> m_server_enums = synthetic::make_types("E_Server", 10, 5);
+        std::vector<synthetic::type_t> m_server_classes = synthetic::make_types("CServer", 60, 10);
+
+        schema_t() {
+            m_client_enums.push_back({"EShared", 3});
+            m_server_enums.push_back({"EShared", 3});
+        }
+
+        [[nodiscard]] build_t make_build(std::string name) const {
+            build_t result = {std::move(name), {}};
+            result.m_scopes.push_back(synthetic::make_scope("client", m_client_enums, m_client_classes));
+            result.m_scopes.push_back(synthetic::make_scope("server", m_server_enums, m_server_classes));
+            return result;
+        }
+    };
+
+    void check_materialized(const std::filesystem::path& archive_dir, const build_t& build, const std::filesystem::path& out_dir) {
+        sdk::MaterializeArchiveBuild(archive_dir, build.m_name, out_dir, 4);
+
+        for (const auto& scope : build.m_scopes)
+            CHECK(read_file(out_dir / (scope.m_rendered.m_name + ".json")) == sdk::AssembleScopeJson(scope.m_rendered));
+    }
+
+    void check_history(const std::vector<sdk::archive_change_t>& history,
+                       const std::vector<std::tuple<std::string, std::string, sdk::archive_change_kind_t>>& expected) {
+        CHECK(history.size() == expected.size());
+        for (std::size_t i = 0; i < history.size(); ++i) {
+            CHECK(history[i].m_build == std::get<0>(expected[i]));
+            CHECK(history[i].m_scope == std::get<1>(expected[i]));
+            CHECK(history[i].m_kind == std::get<2>(expected[i]));
+        }
+    }
+} // namespace
+
+int main() {
+    const auto dir = test::temp_dir("archive");
+    const auto archive_dir = dir / "archive";
+
+    // @note: the first build stores every definition, the shared enum once
+    //
+    schema_t schema;
+    const auto first = schema.make_build("1.0");
+    const auto type_count = schema.m_client_enums.size() + schema.m_client_classes.size() + schema.m_server_enums.size() + schema.m_server_classes.size();
+
+    const auto first_stats = sdk::IngestArchiveBuild(first.rendered(), archive_dir, first.m_name, 4);
+    CHECK(first_stats.m_types == type_count);
+    CHECK(first_stats.m_new_objects == type_count - 1);
+    CHECK(count_objects(archive_dir) == type_count - 1);
+
+    // @note: two classes change, one is added, a class and an enum are removed
+    //
+    find_type(schema.m_client_classes, "C_Client5")->m_revision = 1;
+    find_type(schema.m_server_classes, "CServer7")->m_revision = 1;
+    schema.m_client_classes.push_back({"C_ClientNew", 4});
+    std::erase_if(schema.m_client_classes, [](const synthetic::type_t& type) { return type.m_name == "C_Client9"; });
+    std::erase_if(schema.m_server_enums, [](const synthetic::type_t& type) { return type.m_name == "E_Server3"; });
+
+    const auto second = schema.make_build("1.1");
+    const auto second_stats = sdk::IngestArchiveBuild(second.rendered(), archive_dir, second.m_name, 1);
+    CHECK(second_stats.m_types == type_count - 1);
+    CHECK(second_stats.m_new_objects == 3);
+    CHECK(count_objects(archive_dir) == type_count - 1 + 3);
+
+    std::size_t changed_bytes = 0;
+    for (const auto& scope : second.m_scopes) {
+        for (const auto& fragment : scope.m_rendered.m_classes) {
+            if (std::string_view(fragment.m_name) == "C_Client5" || std::string_view(fragment.m_name) == "CServer7" ||
+                std::string_view(fragment.m_name) == "C_ClientNew")
+                changed_bytes += fragment.m_text.size();
+        }
+    }
+    CHECK(second_stats.m_bytes_written > changed_bytes && second_stats.m_bytes_written < changed_bytes + 8 * 1024);
+
+    // @note: a class reverted to how it was two builds ago is already stored
+    //
+    find_type(schema.m_client_classes, "C_Client5")->m_revision = 0;
+    const auto third = schema.make_build("1.2");
+    CHECK(sdk::IngestArchiveBuild(third.rendered(), archive_dir, third.m_name, 2).m_new_objects == 0);
+    CHECK(count_objects(archive_dir) == type_count - 1 + 3);
+
+    // @note: archiving a build again keeps its place in the history
+    //
+    CHECK(sdk::IngestArchiveBuild(second.rendered(), archive_dir, second.m_name, 1).m_new_objects == 0);
+    const auto builds_text = read_file(archive_dir / "builds.json");
+    const auto builds = dump_reader::parser_t(builds_text).parse();
+    CHECK(builds.find("builds")->items().size() == 3);
+    CHECK(builds.find("builds")->items()[1].as_string() == "1.1" && builds.find("builds")->items()[2].as_string() == "1.2");
+
+    for (const auto* build : {&first, &second, &third})
+        check_materialized(archive_dir, *build, dir / ("out_" + build->m_name));
+
+    using kind_t = sdk::archive_change_kind_t;
+    check_history(sdk::GetArchiveHistory(archive_dir, "C_Client5"),
+                  {{"1.0", "client", kind_t::kAdded}, {"1.1", "client", kind_t::kChanged}, {"1.2", "client", kind_t::kChanged}});
+    check_history(sdk::GetArchiveHistory(archive_dir, "CServer7"), {{"1.0", "server", kind_t::kAdded}, {"1.1", "server", kind_t::kChanged}});
+    check_history(sdk::GetArchiveHistory(archive_dir, "C_ClientNew"), {{"1.1", "client", kind_t::kAdded}});
+    check_history(sdk::GetArchiveHistory(archive_dir, "C_Client9"), {{"1.0", "client", kind_t::kAdded}, {"1.1", "client", kind_t::kRemoved}});
+    check_history(sdk::GetArchiveHistory(archive_dir, "E_Server3"), {{"1.0", "server", kind_t::kAdded}, {"1.1", "server", kind_t::kRemoved}});
+    check_history(sdk::GetArchiveHistory(archive_dir, "EShared"), {{"1.0", "client", kind_t::kAdded}, {"1.0", "server", kind_t::kAdded}});
+    check_history(sdk::GetArchiveHistory(archive_dir, "C_Client6"), {{"1.0", "client", kind_t::kAdded}});
+    CHECK(sdk::GetArchiveHistory(archive_dir, "C_Missing").empty());
+
+    const auto removed = sdk::GetArchiveHistory(archive_dir, "C_Client9").back();
+    CHECK(std::filesystem::exists(sdk::detail::GetObjectPath(archive_dir, removed.m_object)));
+
+    // @note: bad build names and damaged objects are errors
+    //
+    CHECK_THROWS(sdk::IngestArchiveBuild(first.rendered(), archive_dir, "../1.3", 1));
+    CHECK_THROWS(sdk::IngestArchiveBuild(first.rendered(), archive_dir, "", 1));
+    CHECK_THROWS(sdk::MaterializeArchiveBuild(archive_dir, "0.9", dir / "out_missing", 1));
+
+    const auto object = sdk::GetArchiveHistory(archive_dir, "C_ClientNew").front().m_object;
+    std::ofstream(sdk::detail::GetObjectPath(archive_dir, object), std::ios::out | std::ios::binary | std::ios::app) << ' ';
+    CHECK_THROWS(sdk::MaterializeArchiveBuild(archive_dir, "1.1", dir / "out_corrupted", 1));
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
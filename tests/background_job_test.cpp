@@ -0,0 +1,164 @@
+#include "test.h"
+#include "tools/background_job.h"
+#include <condition_variable>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+// A schema_dump_all -async against a stand-in schema source: the scopes are snapshotted on the calling thread and
+// rendered and written on the worker, one progress step per scope, the way SchemaDumpSnapshots does it.
+namespace {
+    struct scope_t {
+        std::string m_name;
+        std::vector<std::string> m_classes;
+    };
+
+    std::vector<scope_t> make_scopes(const std::size_t count) {
+        std::vector<scope_t> scopes(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            scopes[i].m_name = std::format("scope{}", i);
+            for (std::size_t j = 0; j <= i; ++j)
+                scopes[i].m_classes.push_back(std::format("C_Class{}_{}", i, j));
+        }
+
+        return scopes;
+    }
+
+    // @note: holds the worker before every scope until the test lets it go on
+    //
+    struct gate_t {
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::size_t m_allowed = 0;
+
+        void allow(const std::size_t count) {
+            {
+                std::lock_guard lock(m_mutex);
+                m_allowed += count;
+            }
+            m_cv.notify_all();
+        }
+
+        void pass() {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [&]() { return m_allowed != 0; });
+            --m_allowed;
+        }
+    };
+
+    background_job::job_t::work_t make_dump(std::vector<scope_t> snapshots, std::filesystem::path dir, gate_t* gate) {
+        return [snapshots = std::move(snapshots), dir = std::move(dir), gate](background_job::progress_t& progress) {
+            for (const auto& scope : snapshots) {
+                if (gate)
+                    gate->pass();
+                if (progress.m_cancel_requested)
+                    return;
+
+                std::ofstream f(dir / (scope.m_name + ".json"), std::ios::out | std::ios::binary);
+                for (const auto& name : scope.m_classes)
+                    f << name << '\n';
+                ++progress.m_done;
+            }
+        };
+    }
+
+    void test_dump(const std::filesystem::path& dir) {
+        const auto scopes = make_scopes(8);
+
+        std::vector<std::string> errors;
+        background_job::job_t job;
+        CHECK(!job.running() && !job.cancel());
+        CHECK(job.start(scopes.size(), make_dump(scopes, dir, nullptr), [&](const std::string& error) { errors.push_back(error); }));
+        job.wait();
+
+        CHECK(!job.running() && errors.empty() && job.failure().empty());
+        CHECK(job.progress().m_done == scopes.size() && job.progress().m_total == scopes.size());
+        for (const auto& scope : scopes) {
+            std::ifstream f(dir / (scope.m_name + ".json"));
+            std::size_t lines = 0;
+            for (std::string line; std::getline(f, line); ++lines)
+                CHECK(line == scope.m_classes[lines]);
+            CHECK(lines == scope.m_classes.size());
+        }
+    }
+
+    void test_one_at_a_time_and_cancel(const std::filesystem::path& dir) {
+        gate_t gate;
+        background_job::job_t job;
+        const auto ignore = [](const std::string&) { };
+
+        CHECK(job.start(8, make_dump(make_scopes(8), dir, &gate), ignore));
+        gate.allow(3);
+        while (job.progress().m_done != 3)
+            std::this_thread::yield();
+
+        // @note: a second dump is refused while the first one runs, the progress stays the first one's
+        //
+        CHECK(job.running());
+        CHECK(!job.start(2, make_dump(make_scopes(2), dir, nullptr), ignore));
+        CHECK(job.progress().m_total == 8);
+
+        CHECK(job.cancel());
+        gate.allow(1);
+        job.wait();
+        CHECK(!job.running() && !job.cancel());
+        CHECK(job.progress().m_done == 3 && job.progress().m_cancel_requested);
+        CHECK(job.failure().empty());
+
+        // @note: the next one starts over
+        //
+        CHECK(job.start(2, make_dump(make_scopes(2), dir, nullptr), ignore));
+        job.wait();
+        CHECK(job.progress().m_done == 2 && job.progress().m_total == 2 && !job.progress().m_cancel_requested);
+    }
+
+    void test_failures(const std::filesystem::path& dir) {
+        std::vector<std::string> errors;
+        const auto report = [&](const std::string& error) { errors.push_back(error); };
+
+        background_job::job_t job;
+        CHECK(job.start(1, [](background_job::progress_t&) { throw std::runtime_error("disk full"); }, report));
+        job.wait();
+        CHECK(job.failure() == "disk full");
+        CHECK(errors.size() == 1 && errors[0] == "disk full");
+
+        CHECK(job.start(1, [](background_job::progress_t&) { throw 42; }, report));
+        job.wait();
+        CHECK(job.failure() == "Unknown error" && errors.size() == 2);
+
+        // @note: a failure doesn't stick to the next dump
+        //
+        CHECK(job.start(2, make_dump(make_scopes(2), dir, nullptr), report));
+        job.wait();
+        CHECK(job.failure().empty() && errors.size() == 2 && job.progress().m_done == 2);
+    }
+
+    // @note: destroying a running job cancels it and waits for the worker, this work only ends once it's cancelled
+    //
+    void test_destroy_while_running() {
+        std::atomic<bool> stopped = false;
+        {
+            background_job::job_t job;
+            const auto work = [&](background_job::progress_t& progress) {
+                while (!progress.m_cancel_requested)
+                    std::this_thread::yield();
+                stopped = true;
+            };
+
+            CHECK(job.start(1, work, [](const std::string&) { }));
+        }
+
+        CHECK(stopped);
+    }
+} // namespace
+
+int main() {
+    const auto dir = test::temp_dir("background_job");
+    test_dump(dir);
+    test_one_at_a_time_and_cancel(dir);
+    test_failures(dir);
+    test_destroy_while_running();
+    std::filesystem::remove_all(dir);
+    return 0;
+}
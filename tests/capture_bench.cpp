@@ -0,0 +1,132 @@
+#include "test.h"
+#include "tools/capture.h"
+#include <chrono>
+#include <random>
+
+// Captures of a synthetic networked class out of 16384 entities, with the coalesced plan compile() builds and
+// with one copy per field, on one thread and on every core. Every byte of every frame is checked against the
+// entity it came from.
+namespace {
+    constexpr std::size_t kEntityCount = 16384;
+    constexpr std::uint32_t kObjectSize = 2048;
+    constexpr std::size_t kFieldCount = 96;
+    constexpr std::size_t kFrames = 40;
+
+    struct entities_t {
+        std::vector<std::uint8_t> m_storage;
+        std::vector<const void*> m_objects; // every 64th slot is empty
+    };
+
+    // @note: scalars and vectors at their natural alignment, some next to each other and some with a gap
+    //
+    std::vector<capture::field_t> make_fields(std::mt19937_64& random) {
+        constexpr std::uint32_t sizes[] = {1, 2, 4, 4, 4, 8, 12, 16};
+
+        std::vector<capture::field_t> fields;
+        std::uint32_t offset = 16;
+        for (std::size_t i = 0; i < kFieldCount; ++i) {
+            const auto size = sizes[random() % std::size(sizes)];
+            const auto alignment = std::min<std::uint32_t>(size, 8);
+            offset = (offset + static_cast<std::uint32_t>(random() % 4 == 0 ? random() % 24 : 0) + alignment - 1) / alignment * alignment;
+            if (offset + size > kObjectSize)
+                break;
+
+            fields.push_back({offset, size});
+            offset += size;
+        }
+
+        std::shuffle(fields.begin(), fields.end(), random);
+        return fields;
+    }
+
+    entities_t make_entities(std::mt19937_64& random) {
+        entities_t result;
+        result.m_storage.resize(kEntityCount * kObjectSize);
+        for (auto& byte : result.m_storage)
+            byte = static_cast<std::uint8_t>(random());
+
+        for (std::size_t i = 0; i < kEntityCount; ++i)
+            result.m_objects.push_back(i % 64 == 63 ? nullptr : result.m_storage.data() + i * kObjectSize);
+
+        return result;
+    }
+
+    // @note: what compile() would build without merging anything, one copy per field
+    //
+    capture::plan_t make_per_field_plan(std::vector<capture::field_t> fields) {
+        std::sort(fields.begin(), fields.end(), [](const capture::field_t& a, const capture::field_t& b) { return a.m_offset < b.m_offset; });
+
+        capture::plan_t result;
+        result.m_field_count = static_cast<std::uint32_t>(fields.size());
+        for (const auto& field : fields) {
+            result.m_ranges.push_back({field.m_offset, field.m_size, result.m_record_size});
+            result.m_record_size += field.m_size;
+        }
+
+        return result;
+    }
+
+    bool verify(const capture::plan_t& plan, const std::vector<capture::field_t>& fields, const entities_t& entities, const std::vector<std::uint8_t>& frame) {
+        const auto count = entities.m_objects.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto object = static_cast<const std::uint8_t*>(entities.m_objects[i]);
+            for (std::size_t range = 0; range < plan.m_ranges.size(); ++range) {
+                const auto& copy = plan.m_ranges[range];
+                const auto captured = frame.data() + plan.column_offset(range, count) + i * copy.m_size;
+                for (std::uint32_t byte = 0; byte < copy.m_size; ++byte) {
+                    if (captured[byte] != (object != nullptr ? object[copy.m_offset + byte] : 0))
+                        return false;
+                }
+            }
+
+            // @note: every byte of every field is covered, and find() leads to it
+            //
+            for (const auto& field : fields) {
+                for (std::uint32_t byte = 0; byte < field.m_size; ++byte) {
+                    const auto position = plan.find(field.m_offset + byte, i, count);
+                    if (position >= frame.size() || frame[position] != (object != nullptr ? object[field.m_offset + byte] : 0))
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    double measure(const capture::plan_t& plan, const entities_t& entities, std::vector<std::uint8_t>& frame, const std::uint32_t threads) {
+        capture::capture(plan, entities.m_objects, frame.data(), threads);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < kFrames; ++i)
+            capture::capture(plan, entities.m_objects, frame.data(), threads);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return static_cast<double>(kEntityCount * kFrames) / seconds;
+    }
+} // namespace
+
+int main() {
+    std::mt19937_64 random(48);
+    const auto fields = make_fields(random);
+    const auto entities = make_entities(random);
+
+    const auto coalesced = capture::compile(fields);
+    const auto per_field = make_per_field_plan(fields);
+    CHECK(coalesced.m_field_count == fields.size() && per_field.m_field_count == fields.size());
+    CHECK(coalesced.m_ranges.size() < per_field.m_ranges.size());
+
+    std::printf("%zu fields, %zu entities of %u bytes\n", fields.size(), kEntityCount, kObjectSize);
+    for (const auto& [name, plan] : {std::pair{"coalesced", &coalesced}, std::pair{"per field", &per_field}}) {
+        std::vector<std::uint8_t> frame(kEntityCount * plan->m_record_size, 0xCD);
+        for (const auto threads : {1u, 0u}) {
+            const auto entities_per_second = measure(*plan, entities, frame, threads);
+            CHECK(verify(*plan, fields, entities, frame));
+
+            std::printf("%-10s %3zu copies, %4u bytes per entity, %s: %6.2f M entities/s, %6.2f GB/s\n", name, plan->m_ranges.size(),
+                        plan->m_record_size, threads == 1 ? "1 thread " : "all cores", entities_per_second / 1e6,
+                        entities_per_second * plan->m_record_size / 1e9);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/codegen.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+// Rendering a synthetic scope the way RenderTypeScope does, with and without a key cache, then only its keys.
+// Allocations are counted by replacing the global operator new. Both have to render the same text before anything
+// is timed.
+namespace {
+    constexpr std::size_t kClassCount = 4000;
+    constexpr std::size_t kEnumCount = 1000;
+    constexpr std::size_t kRounds = 3;
+
+    std::atomic<std::size_t> g_allocations = 0;
+
+    struct result_t {
+        double m_ms = 0.0;
+        std::size_t m_allocations = 0;
+        std::size_t m_size = 0;
+    };
+
+    // @note: the best of a few rounds, a new key cache every round like every scope gets one
+    //
+    result_t render(const std::vector<synthetic::type_t>& enums, const std::vector<synthetic::type_t>& classes, const bool use_key_cache) {
+        result_t result = {1e300, 0, 0};
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            codegen::key_cache_t key_cache;
+            const auto key_cache_ptr = use_key_cache ? &key_cache : nullptr;
+
+            std::size_t size = 0;
+            const auto allocations = g_allocations.load();
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& type : enums)
+                size += synthetic::render_enum(key_cache_ptr, type.m_name.c_str(), type.m_members).size();
+            for (const auto& type : classes)
+                size += synthetic::render_class(key_cache_ptr, type.m_name.c_str(), type.m_members).size();
+            const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            result.m_ms = std::min(result.m_ms, ms);
+            result.m_allocations = g_allocations.load() - allocations;
+            result.m_size = size;
+        }
+
+        return result;
+    }
+
+    // @note: only the keys of the same scope, where the cache makes the difference
+    //
+    result_t render_keys(const std::vector<synthetic::type_t>& classes, const bool use_key_cache) {
+        result_t result = {1e300, 0, 0};
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            codegen::key_cache_t key_cache;
+            auto builder = codegen::get();
+            builder.use_key_cache(use_key_cache ? &key_cache : nullptr).inc_tabs_count(synthetic::kFragmentTabs);
+
+            const auto allocations = g_allocations.load();
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& type : classes) {
+                builder.json_key(type.m_name.c_str()).json_key("size").json_key("fields");
+                for (std::size_t i = 0; i < type.m_members; ++i)
+                    builder.json_key("name").json_key("offset").json_key("type").json_key("name").json_key("metadata");
+            }
+            const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            result.m_ms = std::min(result.m_ms, ms);
+            result.m_allocations = g_allocations.load() - allocations;
+            result.m_size = builder.size();
+        }
+
+        return result;
+    }
+} // namespace
+
+void* operator new(const std::size_t size) {
+    ++g_allocations;
+    if (const auto result = std::malloc(size != 0 ? size : 1))
+        return result;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+int main() {
+    const auto enums = synthetic::make_types("E_Synthetic", kEnumCount, 16);
+    const auto classes = synthetic::make_types("C_Synthetic", kClassCount, 40);
+
+    codegen::key_cache_t key_cache;
+    for (const auto& type : classes)
+        CHECK(synthetic::render_class(&key_cache, type.m_name.c_str(), type.m_members) == synthetic::render_class(nullptr, type.m_name.c_str(), type.m_members));
+    for (const auto& type : enums)
+        CHECK(synthetic::render_enum(&key_cache, type.m_name.c_str(), type.m_members) == synthetic::render_enum(nullptr, type.m_name.c_str(), type.m_members));
+
+    const auto plain = render(enums, classes, false);
+    const auto cached = render(enums, classes, true);
+    CHECK(plain.m_size == cached.m_size);
+
+    std::printf("%zu enums, %zu classes, %zu bytes of json\n", enums.size(), classes.size(), plain.m_size);
+    std::printf("without key cache: %.1f ms, %zu allocations\n", plain.m_ms, plain.m_allocations);
+    std::printf("with key cache:    %.1f ms, %zu allocations\n", cached.m_ms, cached.m_allocations);
+
+    const auto plain_keys = render_keys(classes, false);
+    const auto cached_keys = render_keys(classes, true);
+    CHECK(plain_keys.m_size == cached_keys.m_size);
+
+    std::printf("keys only, %zu bytes\n", plain_keys.m_size);
+    std::printf("without key cache: %.1f ms, %zu allocations\n", plain_keys.m_ms, plain_keys.m_allocations);
+    std::printf("with key cache:    %.1f ms, %zu allocations\n", cached_keys.m_ms, cached_keys.m_allocations);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "synthetic_lookup.h"
+#include "synthetic_lookup.hpp"
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/codegen.h"
+
+namespace {
+    void test_escape_cpp_string() {
+        CHECK(codegen::escape_cpp_string("C_BaseEntity") == "C_BaseEntity");
+        CHECK(codegen::escape_cpp_string(R"(a"b\c)") == R"(a\"b\\c)");
+        CHECK(codegen::escape_cpp_string("a\n1\x7f") == R"(a\0121\177)");
+
+        // @note: the generated lookup header holds the escaped names as literals, the compiler has to decode them back
+        //
+        namespace lookup = schema_lookup::synthetic;
+        const auto names = synthetic::get_escaped_names();
+        const auto class_index = lookup::find_class(names[0]);
+        CHECK(class_index != lookup::kNotFound && lookup::class_name(class_index) == names[0]);
+        for (const auto& name : names) {
+            const auto field_index = lookup::find_field(class_index, name);
+            CHECK(field_index != lookup::kNotFound && lookup::field_name(field_index) == name);
+            CHECK(lookup::find_class(name) == (name == names[0] ? class_index : lookup::kNotFound));
+        }
+
+        static_assert(lookup::field_name(lookup::find_field(lookup::find_class("C_\"Quoted\""), "C_Line\nBreak1")) == "C_Line\nBreak1");
+        static_assert(lookup::find_field(lookup::find_class("C_\"Quoted\""), "C_Line\nBreak") == lookup::kNotFound);
+    }
+
+    // @note: keys written through a key cache come out byte for byte as written without one, escapes included
+    //
+    void test_key_cache() {
+        const std::vector<std::string> keys = {"m_nPlain", "m_\"quoted\"", "path/to", "back\\slash", "tab\there", "line\nbreak", std::string("\x01\x1f", 2), "", "m_nPlain"};
+
+        const auto render = [&](codegen::key_cache_t* key_cache) {
+            auto builder = codegen::get();
+            builder.use_key_cache(key_cache).begin_json_object();
+            for (std::size_t pass = 0; pass < 2; ++pass) {
+                for (const auto& key : keys)
+                    builder.json_key(key.c_str()).json_literal(pass);
+                builder.json_key("literal").json_string("value");
+            }
+            builder.end_json_object(false);
+            return builder.str();
+        };
+
+        codegen::key_cache_t key_cache;
+        const auto plain = render(nullptr);
+        CHECK(render(&key_cache) == plain);
+        CHECK(render(&key_cache) == plain);
+
+        CHECK(plain.find(R"("m_\"quoted\"": 0,)") != std::string::npos);
+        CHECK(plain.find(R"("path\/to": 0,)") != std::string::npos);
+        CHECK(plain.find(R"("back\\slash": 0,)") != std::string::npos);
+        CHECK(plain.find(R"("tab\there": 0,)") != std::string::npos);
+        CHECK(plain.find(R"("line\nbreak": 0,)") != std::string::npos);
+        CHECK(plain.find(R"("\u0001\u001f": 0,)") != std::string::npos);
+        CHECK(plain.find(R"("": 0,)") != std::string::npos);
+
+        // @note: whole synthetic scopes, their metadata strings need escaping as well
+        //
+        const auto types = synthetic::make_types("C_Synthetic", 200, 12);
+        for (const auto& type : types) {
+            CHECK(synthetic::render_class(&key_cache, type.m_name.c_str(), type.m_members) == synthetic::render_class(nullptr, type.m_name.c_str(), type.m_members));
+            CHECK(synthetic::render_enum(&key_cache, type.m_name.c_str(), type.m_members) == synthetic::render_enum(nullptr, type.m_name.c_str(), type.m_members));
+        }
+    }
+} // namespace
+
+int main() {
+    test_escape_cpp_string();
+    test_key_cache();
+    return 0;
+}
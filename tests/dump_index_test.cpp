@@ -0,0 +1,184 @@
+#include "sdk/dump_index.h"
+#include "test.h"
+#include "tools/codegen.h"
+#include "tools/dump_reader.h"
+#include <fstream>
+
+// A scope json assembled from rendered fragments the way AssembleScopeJson does it, with its <scope>.idx. Every
+// entry has to lead back to exactly the bytes of its fragment, through dump_index::find and through dump_reader,
+// and a sidecar written for another version of the json has to be ignored.
+namespace {
+    constexpr std::size_t kFragmentTabs = 2 * codegen::kTabsPerBlock;
+
+    struct fragment_t {
+        std::string m_name;
+        std::string m_text;
+        dump_index::kind_t m_kind;
+    };
+
+    fragment_t render_enum(codegen::key_cache_t& key_cache, const std::string& name, const std::size_t items) {
+        auto builder = codegen::get();
+        builder.use_key_cache(&key_cache).inc_tabs_count(kFragmentTabs);
+
+        builder.json_key(name.c_str()).begin_json_object_value();
+        builder.json_key("align").json_literal(4);
+        builder.json_key("items").begin_json_array_value();
+        for (std::size_t i = 0; i < items; ++i) {
+            builder.begin_json_object();
+            builder.json_key("name").json_string(std::format("k{}Value{}", name, i));
+            builder.json_key("value").json_literal(i);
+            builder.end_json_object();
+        }
+        builder.end_json_array();
+        builder.end_json_object();
+
+        return {name, builder.str(), dump_index::kind_t::kEnum};
+    }
+
+    // @note: metadata strings with the characters a scan has to get right inside a string
+    //
+    fragment_t render_class(codegen::key_cache_t& key_cache, const std::string& name, const std::size_t fields) {
+        auto builder = codegen::get();
+        builder.use_key_cache(&key_cache).inc_tabs_count(kFragmentTabs);
+
+        builder.json_key(name.c_str()).begin_json_object_value();
+        if (fields > 0) {
+            builder.json_key("fields").begin_json_array_value();
+            for (std::size_t i = 0; i < fields; ++i) {
+                builder.begin_json_object();
+                builder.json_key("name").json_string(std::format("m_field{}", i));
+                builder.json_key("offset").json_literal(i * 4);
+                builder.json_key("metadata").begin_json_array_value();
+                builder.json_string_element(std::format("MPropertyDescription \"{}\" }}, {{ \\ \"x\": {{", i));
+                builder.end_json_array();
+                builder.end_json_object();
+            }
+            builder.end_json_array();
+        }
+        builder.end_json_object();
+
+        return {name, builder.str(), dump_index::kind_t::kClass};
+    }
+
+    struct scope_t {
+        std::vector<fragment_t> m_fragments;
+        std::string m_json;
+        std::vector<dump_index::entry_t> m_entries;
+    };
+
+    scope_t make_scope() {
+        // @note: the key cache finds names by their address, like schema names they have to stay put
+        //
+        std::vector<std::string> enum_names, class_names;
+        for (std::size_t i = 0; i < 50; ++i)
+            enum_names.push_back(std::format("E_Synthetic{}", i));
+        enum_names.push_back("Shared");
+        for (std::size_t i = 0; i < 300; ++i)
+            class_names.push_back(std::format("C_Synthetic{}", i));
+        class_names.push_back("Shared");
+
+        scope_t result;
+        codegen::key_cache_t key_cache;
+        for (std::size_t i = 0; i < enum_names.size(); ++i)
+            result.m_fragments.push_back(render_enum(key_cache, enum_names[i], i % 7));
+        for (std::size_t i = 0; i < class_names.size(); ++i)
+            result.m_fragments.push_back(render_class(key_cache, class_names[i], i % 11));
+
+        auto builder = codegen::get();
+        const auto append_fragments = [&](const dump_index::kind_t kind) {
+            for (const auto& fragment : result.m_fragments) {
+                if (fragment.m_kind != kind)
+                    continue;
+
+                result.m_entries.push_back(dump_index::make_entry(fragment.m_name, fragment.m_text, builder.size(), kind));
+                builder.append(fragment.m_text);
+            }
+        };
+
+        builder.begin_json_object();
+        builder.json_key("enums").begin_json_object_value();
+        append_fragments(dump_index::kind_t::kEnum);
+        builder.end_json_object();
+        builder.json_key("classes").begin_json_object_value();
+        append_fragments(dump_index::kind_t::kClass);
+        builder.end_json_object();
+        builder.end_json_object(false);
+
+        result.m_json = builder.str();
+        return result;
+    }
+
+    void write_file(const std::filesystem::path& path, const std::string_view data) {
+        std::ofstream f(path, std::ios::out | std::ios::binary);
+        f.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    // @note: `"Name": { ... }` of a fragment, without the indent and the trailing comma
+    //
+    std::string_view get_expected_text(const fragment_t& fragment) {
+        const std::string_view text = fragment.m_text;
+        const auto begin = text.find('"');
+        return text.substr(begin, text.rfind('}') + 1 - begin);
+    }
+} // namespace
+
+int main() {
+    const auto scope = make_scope();
+    const auto sidecar = dump_index::serialize(scope.m_entries, scope.m_json.size());
+
+    // @note: every entry through the sidecar alone
+    //
+    const auto header = reinterpret_cast<const dump_index::header_t*>(sidecar.data());
+    CHECK(header->magic == dump_index::kMagic && header->version == dump_index::kVersion);
+    CHECK(header->entry_count == scope.m_fragments.size());
+    CHECK(header->file_size == scope.m_json.size());
+    CHECK(sidecar.size() == sizeof(dump_index::header_t) + header->entry_count * sizeof(dump_index::entry_t));
+
+    const std::string_view json = scope.m_json;
+    for (const auto& fragment : scope.m_fragments) {
+        const auto entry = dump_index::find(header, fnv64::hash_runtime(fragment.m_name.c_str()), fragment.m_kind);
+        CHECK(entry != nullptr);
+        CHECK(entry->offset + entry->length < json.size());
+        CHECK(json.substr(entry->offset, entry->length) == get_expected_text(fragment));
+        CHECK(json[entry->offset + entry->length] == ',');
+    }
+
+    CHECK(dump_index::find(header, fnv64::hash_runtime("C_Missing"), dump_index::kind_t::kClass) == nullptr);
+    CHECK(dump_index::find(header, fnv64::hash_runtime("C_Synthetic0"), dump_index::kind_t::kEnum) == nullptr);
+
+    // @note: through dump_reader, the sidecar and a scan of the same json find the same byte ranges
+    //
+    const auto dir = test::temp_dir("dump_index");
+    std::filesystem::create_directories(dir / "scan");
+    write_file(dir / "scope.json", scope.m_json);
+    write_file(dir / "scope.idx", std::string_view(reinterpret_cast<const char*>(sidecar.data()), sidecar.size()));
+    write_file(dir / "scan" / "scope.json", scope.m_json);
+
+    const auto indexed = dump_reader::dump_t::open(dir / "scope.json");
+    const auto scanned = dump_reader::dump_t::open(dir / "scan" / "scope.json");
+    CHECK(indexed.uses_sidecar());
+    CHECK(!scanned.uses_sidecar());
+
+    for (const auto& fragment : scope.m_fragments) {
+        const auto is_class = fragment.m_kind == dump_index::kind_t::kClass;
+        const auto from_index = is_class ? indexed.find_class(fragment.m_name) : indexed.find_enum(fragment.m_name);
+        const auto from_scan = is_class ? scanned.find_class(fragment.m_name) : scanned.find_enum(fragment.m_name);
+        CHECK(from_index != nullptr && from_scan != nullptr);
+        CHECK(from_index->m_offset == from_scan->m_offset && from_index->m_length == from_scan->m_length);
+        CHECK(indexed.text(*from_index) == get_expected_text(fragment));
+    }
+
+    CHECK(indexed.classes().size() == scanned.classes().size() && indexed.enums().size() == scanned.enums().size());
+    CHECK(indexed.parse_class("C_Synthetic10")->find("fields")->items().size() == 10);
+
+    // @note: a sidecar of another version of the json is ignored, the reader scans instead
+    //
+    write_file(dir / "scope.json", scope.m_json + "\n");
+    const auto mismatched = dump_reader::dump_t::open(dir / "scope.json");
+    CHECK(!mismatched.uses_sidecar());
+    CHECK(mismatched.find_class("C_Synthetic299") != nullptr);
+    CHECK(mismatched.text(*mismatched.find_class("C_Synthetic299")) == get_expected_text(scope.m_fragments[scope.m_fragments.size() - 2]));
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "sdk/scope_json.h"
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/dump_reader.h"
+#include <chrono>
+#include <fstream>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+// Time to the first class of a large synthetic dump and the memory it takes: dump_reader scanning the json,
+// dump_reader through the <scope>.idx sidecar, and a full parse of the json into a tree. Resident memory is read
+// from /proc/self/statm, so it's only reported on Linux.
+namespace {
+    constexpr std::size_t kClassCount = 12000;
+    constexpr std::size_t kEnumCount = 2000;
+    constexpr std::size_t kRounds = 3;
+
+    void write_file(const std::filesystem::path& path, const std::string_view data) {
+        std::ofstream f(path, std::ios::out | std::ios::binary);
+        f.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream f(path, std::ios::in | std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    }
+
+    // @note: in bytes, 0 where there is no /proc
+    //
+    std::size_t get_resident_size() {
+#ifdef __linux__
+        std::ifstream f("/proc/self/statm");
+        std::size_t pages = 0, resident = 0;
+        if (f >> pages >> resident)
+            return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        return 0;
+    }
+
+    struct result_t {
+        double m_ms = 1e300;
+        std::size_t m_resident = 0;
+    };
+
+    // @note: `open` returns what has to stay alive for the lookup, `lookup` the number of fields of the class it found
+    //
+    template <typename Open, typename Lookup>
+    result_t measure(Open&& open, Lookup&& lookup) {
+        result_t result;
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            const auto resident = get_resident_size();
+            const auto start = std::chrono::steady_clock::now();
+            const auto state = open();
+            CHECK(lookup(state) == 40);
+            const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            // @note: memory freed by an earlier round stays with the process, only the first one tells
+            //
+            const auto used = get_resident_size();
+            result.m_ms = std::min(result.m_ms, ms);
+            if (round == 0)
+                result.m_resident = used > resident ? used - resident : 0;
+        }
+
+        return result;
+    }
+
+    double to_mb(const std::size_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+} // namespace
+
+int main() {
+    const auto dir = test::temp_dir("dump_reader_bench");
+    std::filesystem::create_directories(dir / "scan");
+
+    std::size_t json_size = 0;
+    {
+        const auto scope = synthetic::make_scope("client", synthetic::make_types("E_Synthetic", kEnumCount, 16), synthetic::make_types("C_Synthetic", kClassCount, 40));
+
+        std::vector<dump_index::entry_t> index_entries;
+        const auto json = sdk::AssembleScopeJson(scope.m_rendered, &index_entries);
+        const auto sidecar = dump_index::serialize(std::move(index_entries), json.size());
+
+        write_file(dir / "client.json", json);
+        write_file(dir / "client.idx", std::string_view(reinterpret_cast<const char*>(sidecar.data()), sidecar.size()));
+        write_file(dir / "scan" / "client.json", json);
+        json_size = json.size();
+    }
+
+    // @note: one of the last classes, 40 fields
+    //
+    constexpr std::string_view kClass = "C_Synthetic11971";
+    const auto count_fields = [](const dump_reader::dump_t& dump) { return dump.parse_class(kClass)->find("fields")->items().size(); };
+
+    const auto indexed = measure([&] { return dump_reader::dump_t::open(dir / "client.json"); }, count_fields);
+    const auto scanned = measure([&] { return dump_reader::dump_t::open(dir / "scan" / "client.json"); }, count_fields);
+
+    // @note: the text has to stay alive with the tree, its strings are views into it
+    //
+    struct tree_t {
+        std::string m_text;
+        dump_reader::value_t m_root;
+    };
+    const auto parsed = measure(
+        [&] {
+            auto tree = std::make_unique<tree_t>();
+            tree->m_text = read_file(dir / "client.json");
+            tree->m_root = dump_reader::parser_t(tree->m_text).parse();
+            return tree;
+        },
+        [](const std::unique_ptr<tree_t>& tree) { return tree->m_root.find("classes")->find(kClass)->find("fields")->items().size(); });
+
+    std::printf("%zu enums, %zu classes, %.1f MB of json\n", kEnumCount, kClassCount, to_mb(json_size));
+    std::printf("dump_reader, sidecar: %7.1f ms to the first class, %6.1f MB resident\n", indexed.m_ms, to_mb(indexed.m_resident));
+    std::printf("dump_reader, scan:    %7.1f ms to the first class, %6.1f MB resident\n", scanned.m_ms, to_mb(scanned.m_resident));
+    std::printf("full parse:           %7.1f ms to the first class, %6.1f MB resident\n", parsed.m_ms, to_mb(parsed.m_resident));
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
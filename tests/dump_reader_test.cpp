@@ -0,0 +1,171 @@
+#include "sdk/scope_json.h"
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/dump_reader.h"
+#include <fstream>
+
+// A synthetic scope json read back through dump_reader: every entry is found with its exact text and parses to what
+// was rendered, with and without the sidecar. A dump cut short anywhere, with brackets that don't match or with
+// stray data is an error, and a sidecar that points outside of the json is ignored.
+namespace {
+    void write_file(const std::filesystem::path& path, const std::string_view data) {
+        std::ofstream f(path, std::ios::out | std::ios::binary);
+        f.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    // @note: `"Name": { ... }` of a fragment, without the indent and the trailing comma
+    //
+    std::string_view get_expected_text(const sdk::type_fragment_t& fragment) {
+        const std::string_view text = fragment.m_text;
+        const auto begin = text.find('"');
+        return text.substr(begin, text.rfind('}') + 1 - begin);
+    }
+
+    // @note: keys of every kind in front of "enums", the scan has to step over them
+    //
+    std::string assemble(const sdk::rendered_scope_t& rendered, std::vector<dump_index::entry_t>* index_entries = nullptr) {
+        std::vector<const sdk::type_fragment_t*> enums, classes;
+        for (const auto& fragment : rendered.m_enums)
+            enums.push_back(&fragment);
+        for (const auto& fragment : rendered.m_classes)
+            classes.push_back(&fragment);
+
+        return sdk::AssembleScopeJson(
+            enums, classes,
+            [](codegen::generator_t::self_ref builder) {
+                builder.json_key("scope").json_string("client, \"with\" {braces}");
+                builder.json_key("version").json_literal(3);
+                builder.json_key("stripped").json_literal("false");
+                builder.json_key("modules").begin_json_array_value();
+                builder.json_string_element("client.dll ]");
+                builder.end_json_array();
+                builder.json_key("classes_count").begin_json_object_value();
+                builder.json_key("client").json_literal(2);
+                builder.end_json_object();
+            },
+            index_entries);
+    }
+
+    void check_dump(const dump_reader::dump_t& dump, const sdk::rendered_scope_t& rendered) {
+        CHECK(dump.enums().size() == rendered.m_enums.size() && dump.classes().size() == rendered.m_classes.size());
+
+        for (const auto& fragment : rendered.m_enums) {
+            const auto entry = dump.find_enum(fragment.m_name);
+            CHECK(entry != nullptr && dump.text(*entry) == get_expected_text(fragment));
+            CHECK(dump.find_class(fragment.m_name) == nullptr);
+        }
+
+        for (const auto& fragment : rendered.m_classes) {
+            const auto entry = dump.find_class(fragment.m_name);
+            CHECK(entry != nullptr && dump.text(*entry) == get_expected_text(fragment));
+        }
+
+        CHECK(dump.find_class("C_Missing") == nullptr && !dump.parse_class("C_Missing").has_value());
+
+        // @note: C_Synthetic7 has 7 fields, the metadata string comes back unescaped
+        //
+        const auto parsed = dump.parse_class("C_Synthetic7");
+        CHECK(parsed.has_value());
+        const auto& fields = parsed->find("fields")->items();
+        CHECK(fields.size() == 7);
+        CHECK(fields[3].find("name")->as_string() == "m_field3");
+        CHECK(fields[3].find("offset")->as_int() == 8 + 3 * 4);
+        CHECK(fields[3].find("metadata")->items()[0].as_string() == "MPropertyDescription \"3\" }, { \\ \"x\": {");
+        CHECK(dump.parse_enum("E_Synthetic5")->find("items")->items().size() == 5);
+    }
+
+    void test_read(const synthetic::scope_t& scope, const std::filesystem::path& dir) {
+        std::vector<dump_index::entry_t> index_entries;
+        const auto json = assemble(scope.m_rendered, &index_entries);
+        write_file(dir / "client.json", json);
+        write_file(dir / "scan" / "client.json", json);
+
+        const auto sidecar = dump_index::serialize(index_entries, json.size());
+        write_file(dir / "client.idx", std::string_view(reinterpret_cast<const char*>(sidecar.data()), sidecar.size()));
+
+        const auto indexed = dump_reader::dump_t::open(dir / "client.json");
+        const auto scanned = dump_reader::dump_t::open(dir / "scan" / "client.json");
+        CHECK(indexed.uses_sidecar() && !scanned.uses_sidecar());
+        check_dump(indexed, scope.m_rendered);
+        check_dump(scanned, scope.m_rendered);
+
+        // @note: a sidecar whose entries don't fit the json it was written for falls back to the scan
+        //
+        const auto corrupt = [&](auto&& change) {
+            auto bad = sidecar;
+            change(*reinterpret_cast<dump_index::entry_t*>(bad.data() + sizeof(dump_index::header_t) + 5 * sizeof(dump_index::entry_t)));
+            write_file(dir / "client.idx", std::string_view(reinterpret_cast<const char*>(bad.data()), bad.size()));
+
+            const auto dump = dump_reader::dump_t::open(dir / "client.json");
+            CHECK(!dump.uses_sidecar());
+            check_dump(dump, scope.m_rendered);
+        };
+
+        corrupt([&](dump_index::entry_t& entry) { entry.offset = json.size(); });
+        corrupt([](dump_index::entry_t& entry) { entry.offset = ~std::uint64_t{0} - 4; });
+        corrupt([](dump_index::entry_t& entry) { entry.length = 0xFFFFFFFF; });
+        corrupt([](dump_index::entry_t& entry) { entry.length -= 1; });
+        corrupt([](dump_index::entry_t& entry) { entry.offset += 1; });
+    }
+
+    // @note: every proper prefix of the json is missing at least the closing brace of the root
+    //
+    void test_truncated(const std::filesystem::path& dir) {
+        std::filesystem::remove(dir / "client.idx");
+        const auto scope = synthetic::make_scope("client", synthetic::make_types("E_Synthetic", 6, 5), synthetic::make_types("C_Synthetic", 8, 7));
+        const auto json = assemble(scope.m_rendered);
+        const auto end = json.rfind('}');
+
+        write_file(dir / "client.json", std::string_view(json).substr(0, end + 1));
+        check_dump(dump_reader::dump_t::open(dir / "client.json"), scope.m_rendered);
+
+        for (std::size_t size = 0; size <= end; ++size) {
+            write_file(dir / "client.json", std::string_view(json).substr(0, size));
+            CHECK_THROWS(dump_reader::dump_t::open(dir / "client.json"));
+        }
+    }
+
+    void test_malformed(const std::filesystem::path& dir) {
+        std::filesystem::remove(dir / "client.idx");
+        const auto scope = synthetic::make_scope("client", synthetic::make_types("E_Synthetic", 6, 5), synthetic::make_types("C_Synthetic", 8, 7));
+        const auto json = assemble(scope.m_rendered);
+
+        const auto check_throws = [&](const std::string& text) {
+            write_file(dir / "client.json", text);
+            CHECK_THROWS(dump_reader::dump_t::open(dir / "client.json"));
+        };
+
+        // @note: a class closed with the wrong bracket, or closed once too often
+        //
+        const auto fields_end = json.find("],", json.find("\"C_Synthetic2\""));
+        check_throws(json.substr(0, fields_end) + "}" + json.substr(fields_end + 1));
+        check_throws(json.substr(0, fields_end) + "]]" + json.substr(fields_end + 1));
+
+        const auto classes_end = json.rfind('}', json.rfind('}') - 1);
+        check_throws(json.substr(0, classes_end) + json.substr(classes_end + 1));
+        check_throws(json + "{}");
+        auto array_root = json;
+        array_root[0] = '[';
+        check_throws(array_root);
+
+        // @note: a key without its colon, an entry that isn't an object
+        //
+        const auto name = json.find("\"C_Synthetic3\"");
+        check_throws(json.substr(0, name + 14) + json.substr(name + 15));
+        const auto value = json.find('{', name);
+        check_throws(json.substr(0, value) + "7,\n" + json.substr(json.find("\"C_Synthetic4\"")));
+    }
+} // namespace
+
+int main() {
+    const auto dir = test::temp_dir("dump_reader");
+    std::filesystem::create_directories(dir / "scan");
+
+    const auto scope = synthetic::make_scope("client", synthetic::make_types("E_Synthetic", 30, 8), synthetic::make_types("C_Synthetic", 200, 12));
+    test_read(scope, dir);
+    test_truncated(dir);
+    test_malformed(dir);
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "sdk/enum_lookup.h"
+#include "test.h"
+#include "tools/enum_table.h"
+#include <chrono>
+#include <format>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+// Value to name lookups through a <scope>.enums.bin against one std::unordered_map per enum, over a synthetic
+// scope with counter enums (dense), enums with scattered values (sparse) and flag enums. Queries are the values
+// of one enum after the other, mostly values it has.
+namespace {
+    constexpr std::size_t kEnumsPerKind = 100;
+    constexpr std::size_t kLookups = 4000000;
+
+    struct enum_t {
+        std::string m_name = "";
+        std::uint8_t m_size = 4;
+        std::vector<std::int64_t> m_values = {};
+        std::vector<std::string> m_names = {};
+        enum_table::table_t m_table = {};
+        std::unordered_map<std::int64_t, std::string_view> m_map = {};
+    };
+
+    std::vector<enum_t> make_enums(std::mt19937_64& random, const enum_table::kind_t kind) {
+        std::vector<enum_t> result(kEnumsPerKind);
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            auto& item = result[i];
+            item.m_name = std::format("E{}_{}", static_cast<int>(kind), i);
+
+            const auto count = 2 + random() % 30;
+            for (std::size_t j = 0; j < count; ++j) {
+                switch (kind) {
+                case enum_table::kind_t::kDense:
+                    item.m_values.push_back(static_cast<std::int64_t>(j) - (i % 4 == 0 ? 1 : 0));
+                    break;
+                case enum_table::kind_t::kSparse:
+                    item.m_values.push_back(static_cast<std::int64_t>(random() % 100000) - 50000);
+                    break;
+                case enum_table::kind_t::kFlags:
+                    item.m_values.push_back(j % 8 == 7 ? item.m_values[j - 1] | item.m_values[j - 2] : std::int64_t{1} << (j % 32));
+                    break;
+                }
+                item.m_names.push_back(std::format("k{}Value{}", item.m_name, j));
+            }
+
+            item.m_table = enum_table::build(item.m_values, item.m_size);
+            CHECK(item.m_table.m_kind == kind || (kind == enum_table::kind_t::kFlags && item.m_values.size() < 3));
+
+            for (std::size_t j = 0; j < item.m_values.size(); ++j)
+                item.m_map.emplace(item.m_values[j], item.m_names[j]);
+        }
+
+        return result;
+    }
+
+    struct query_t {
+        const enum_t* m_enum = nullptr;
+        const enum_lookup::enum_t* m_entry = nullptr;
+        std::int64_t m_value = 0;
+    };
+
+    template <typename Fn>
+    double measure_ns(const std::vector<query_t>& queries, Fn&& fn) {
+        std::uint64_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < kLookups; ++i)
+            sink += fn(queries[i % queries.size()]);
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        CHECK(sink != 0);
+        return elapsed / kLookups;
+    }
+} // namespace
+
+int main() {
+    std::mt19937_64 random(44);
+
+    std::vector<std::vector<enum_t>> kinds;
+    for (const auto kind : {enum_table::kind_t::kDense, enum_table::kind_t::kSparse, enum_table::kind_t::kFlags})
+        kinds.push_back(make_enums(random, kind));
+
+    std::vector<enum_lookup::source_t> sources;
+    for (const auto& enums : kinds) {
+        for (const auto& item : enums) {
+            auto& source = sources.emplace_back();
+            source.m_name = item.m_name;
+            source.m_size = item.m_size;
+            source.m_table = &item.m_table;
+            source.m_enumerators.assign(item.m_names.begin(), item.m_names.end());
+        }
+    }
+    std::sort(sources.begin(), sources.end(), [](const auto& a, const auto& b) { return a.m_name < b.m_name; });
+
+    const auto data = enum_lookup::serialize(sources);
+    const enum_lookup::view_t view(data.data(), data.size());
+    CHECK(view.valid());
+
+    std::printf("%zu enums, %zu bytes of tables\n", sources.size(), data.size());
+
+    constexpr const char* kKindNames[] = {"dense", "sparse", "flags"};
+    for (std::size_t kind = 0; kind < kinds.size(); ++kind) {
+        // @note: an enum's values and one it doesn't have, enum after enum
+        //
+        std::vector<query_t> queries;
+        for (const auto& item : kinds[kind]) {
+            const auto entry = view.find_enum(item.m_name);
+            CHECK(entry != nullptr);
+
+            auto values = item.m_values;
+            values.push_back(values.back() + 1000003);
+            std::shuffle(values.begin(), values.end(), random);
+            for (const auto value : values)
+                queries.push_back({&item, entry, value});
+        }
+
+        // @note: both agree on every query before anything is timed
+        //
+        for (const auto& query : queries) {
+            const auto name = view.name_of(*query.m_entry, query.m_value);
+            const auto it = query.m_enum->m_map.find(query.m_value);
+            CHECK((name != nullptr) == (it != query.m_enum->m_map.end()));
+            CHECK(name == nullptr || it->second == name);
+        }
+
+        const auto view_ns = measure_ns(queries, [&](const query_t& query) {
+            const auto name = view.name_of(*query.m_entry, query.m_value);
+            return name != nullptr ? static_cast<std::uint64_t>(name[0]) : 1;
+        });
+        const auto map_ns = measure_ns(queries, [](const query_t& query) {
+            const auto it = query.m_enum->m_map.find(query.m_value);
+            return it != query.m_enum->m_map.end() ? static_cast<std::uint64_t>(it->second[0]) : 1;
+        });
+
+        std::printf("%-6s  enums.bin: %.1f ns per lookup, std::unordered_map: %.1f ns per lookup\n", kKindNames[kind], view_ns, map_ns);
+    }
+
+    return 0;
+}
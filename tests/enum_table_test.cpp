@@ -0,0 +1,187 @@
+#include "sdk/enum_lookup.h"
+#include "test.h"
+#include "tools/enum_table.h"
+#include <limits>
+#include <string>
+
+// The table every kind of enum gets, and the answers of an <scope>.enums.bin written from those tables: each
+// value gives the name of the first enumerator declared with it, values the enum doesn't have give nothing.
+namespace {
+    constexpr auto kMin = std::numeric_limits<std::int64_t>::min();
+    constexpr auto kMax = std::numeric_limits<std::int64_t>::max();
+
+    struct enum_t {
+        std::string m_name = "";
+        std::uint8_t m_size = 4;
+        std::vector<std::int64_t> m_values = {};
+        std::vector<std::string> m_names = {};
+        enum_table::table_t m_table = {};
+    };
+
+    enum_t make_enum(std::string name, const std::uint8_t size, std::vector<std::int64_t> values) {
+        enum_t result = {std::move(name), size, std::move(values)};
+        for (std::size_t i = 0; i < result.m_values.size(); ++i)
+            result.m_names.push_back(std::to_string(i));
+
+        result.m_table = enum_table::build(result.m_values, result.m_size);
+        return result;
+    }
+
+    // @note: the name a lookup has to give, the first enumerator declared with the value
+    //
+    const char* expected_name(const enum_t& item, const std::int64_t value) {
+        for (std::size_t i = 0; i < item.m_values.size(); ++i) {
+            if (item.m_values[i] == value)
+                return item.m_names[i].c_str();
+        }
+
+        return nullptr;
+    }
+
+    void check_view(const std::vector<enum_t>& enums) {
+        std::vector<enum_lookup::source_t> sources;
+        for (const auto& item : enums) {
+            auto& source = sources.emplace_back();
+            source.m_name = item.m_name;
+            source.m_size = item.m_size;
+            source.m_table = &item.m_table;
+            source.m_enumerators.assign(item.m_names.begin(), item.m_names.end());
+        }
+        std::sort(sources.begin(), sources.end(), [](const auto& a, const auto& b) { return a.m_name < b.m_name; });
+
+        const auto data = enum_lookup::serialize(sources);
+        const enum_lookup::view_t view(data.data(), data.size());
+        CHECK(view.valid());
+        CHECK(view.header().enum_count == enums.size());
+        CHECK(view.find_enum("Missing") == nullptr);
+
+        for (const auto& item : enums) {
+            const auto entry = view.find_enum(item.m_name);
+            CHECK(entry != nullptr && entry->kind == static_cast<enum_lookup::kind_t>(item.m_table.m_kind) && entry->size == item.m_size);
+
+            std::vector<std::int64_t> queries = {0, 1, -1, 3, 64, kMin, kMax, kMin + 1, kMax - 1, std::int64_t{1} << 40};
+            for (const auto value : item.m_values) {
+                for (const auto delta : {-1, 0, 1})
+                    queries.push_back(static_cast<std::int64_t>(static_cast<std::uint64_t>(value) + static_cast<std::uint64_t>(delta)));
+            }
+
+            for (const auto value : queries) {
+                const auto name = view.name_of(*entry, value);
+                const auto expected = expected_name(item, value);
+                CHECK((name == nullptr) == (expected == nullptr));
+                CHECK(name == nullptr || std::string_view(name) == expected);
+            }
+        }
+    }
+
+    void test_dense() {
+        const auto counter = make_enum("ECounter", 4, {0, 1, 2, 3});
+        CHECK(counter.m_table.m_kind == enum_table::kind_t::kDense);
+        CHECK(counter.m_table.m_base == 0 && counter.m_table.m_slots.size() == 4 && counter.m_table.m_sorted.empty());
+
+        // @note: half of the slots may be empty
+        //
+        const auto gaps = make_enum("EGaps", 4, {-3, -1, 1, 3});
+        CHECK(gaps.m_table.m_kind == enum_table::kind_t::kDense);
+        CHECK(gaps.m_table.m_base == -3 && gaps.m_table.m_slots.size() == 7 && gaps.m_table.m_slots[1] == enum_table::kNone);
+
+        const auto too_sparse = make_enum("ETooSparse", 4, {0, 10, 20});
+        CHECK(too_sparse.m_table.m_kind == enum_table::kind_t::kSparse);
+
+        std::vector<std::int64_t> many(enum_table::kMaxDenseSlots + 1);
+        for (std::size_t i = 0; i < many.size(); ++i)
+            many[i] = static_cast<std::int64_t>(i);
+        CHECK(enum_table::build(many, 4).m_kind == enum_table::kind_t::kSparse);
+        many.pop_back();
+        CHECK(enum_table::build(many, 4).m_kind == enum_table::kind_t::kDense);
+
+        const auto empty = make_enum("EEmpty", 4, {});
+        CHECK(empty.m_table.m_kind == enum_table::kind_t::kSparse && empty.m_table.m_sorted.empty() && empty.m_table.m_slots.empty());
+
+        check_view({counter, gaps, too_sparse, empty, make_enum("EBool", 1, {0, 1})});
+    }
+
+    void test_flags() {
+        const auto flags = make_enum("EFlags", 4, {0, 1, 2, 8, 3, 11, 1u << 31});
+        CHECK(flags.m_table.m_kind == enum_table::kind_t::kFlags);
+        CHECK(flags.m_table.m_slots.size() == 32);
+        CHECK(flags.m_table.m_slots[0] == 1 && flags.m_table.m_slots[1] == 2 && flags.m_table.m_slots[2] == enum_table::kNone &&
+              flags.m_table.m_slots[3] == 3 && flags.m_table.m_slots[31] == 6);
+
+        // @note: 0 and the masks are looked up by value
+        //
+        CHECK(flags.m_table.m_sorted.size() == 3);
+        CHECK(flags.m_table.m_sorted[0].m_value == 0 && flags.m_table.m_sorted[1].m_value == 3 && flags.m_table.m_sorted[2].m_value == 11);
+
+        // @note: a mask with a bit no enumerator has, a bit past the storage and a negative value aren't flags
+        //
+        CHECK(make_enum("EStrayMask", 4, {1, 2, 8, 16 | 1}).m_table.m_kind != enum_table::kind_t::kFlags);
+        CHECK(make_enum("EWideBit", 1, {1, 2, 256}).m_table.m_kind != enum_table::kind_t::kFlags);
+        CHECK(make_enum("ENegative", 4, {-1, 2, 8, 32}).m_table.m_kind != enum_table::kind_t::kFlags);
+        CHECK(make_enum("EOneBit", 4, {0, 16}).m_table.m_kind != enum_table::kind_t::kFlags);
+
+        const auto wide = make_enum("EWide", 8, {1, 4, std::int64_t{1} << 40, std::int64_t{1} << 62});
+        CHECK(wide.m_table.m_kind == enum_table::kind_t::kFlags && wide.m_table.m_slots.size() == 64 && wide.m_table.m_slots[40] == 2);
+
+        check_view({flags, wide, make_enum("EByte", 1, {1, 4, 128})});
+
+        // @note: for_each_flag names the bits that have a name, lowest first
+        //
+        std::vector<enum_lookup::source_t> sources(1);
+        sources[0].m_name = flags.m_name;
+        sources[0].m_size = flags.m_size;
+        sources[0].m_table = &flags.m_table;
+        sources[0].m_enumerators.assign(flags.m_names.begin(), flags.m_names.end());
+
+        const auto data = enum_lookup::serialize(sources);
+        const enum_lookup::view_t view(data.data(), data.size());
+        std::string names;
+        view.for_each_flag(*view.find_enum("EFlags"), 0x8000000Full, [&](const char* name) { names += std::string(name) + ","; });
+        CHECK(names == "1,2,3,6,");
+    }
+
+    void test_sparse() {
+        const auto negative = make_enum("ENegative", 4, {-100, -1, 4, 8, 16, 1000});
+        CHECK(negative.m_table.m_kind == enum_table::kind_t::kSparse);
+        CHECK(negative.m_table.m_sorted.size() == 6 && negative.m_table.m_sorted.front().m_value == -100 && negative.m_table.m_sorted.back().m_value == 1000);
+
+        // @note: the span of [INT64_MIN, INT64_MAX] wraps to 0, that's no dense table
+        //
+        const auto extremes = make_enum("EExtremes", 8, {kMax, 0, kMin});
+        CHECK(extremes.m_table.m_kind == enum_table::kind_t::kSparse);
+        CHECK(extremes.m_table.m_sorted.front().m_value == kMin && extremes.m_table.m_sorted.back().m_value == kMax);
+
+        const auto low = make_enum("ELow", 8, {kMin + 1, kMin, kMin + 2});
+        CHECK(low.m_table.m_kind == enum_table::kind_t::kDense && low.m_table.m_base == kMin);
+
+        const auto high = make_enum("EHigh", 8, {kMax, kMax - 2});
+        CHECK(high.m_table.m_kind == enum_table::kind_t::kDense && high.m_table.m_base == kMax - 2);
+
+        check_view({negative, extremes, low, high, make_enum("ESingle", 2, {-7})});
+    }
+
+    // @note: the first enumerator declared with a value wins in every kind of table
+    //
+    void test_duplicates() {
+        const auto dense = make_enum("EDense", 4, {0, 1, 2, 1, 0});
+        CHECK(dense.m_table.m_kind == enum_table::kind_t::kDense && dense.m_table.m_slots[0] == 0 && dense.m_table.m_slots[1] == 1);
+
+        const auto flags = make_enum("EFlags", 4, {4, 1, 16, 1, 5, 5});
+        CHECK(flags.m_table.m_kind == enum_table::kind_t::kFlags && flags.m_table.m_slots[0] == 1);
+        CHECK(flags.m_table.m_sorted.size() == 1 && flags.m_table.m_sorted[0].m_index == 4);
+
+        const auto sparse = make_enum("ESparse", 4, {-50, 900, -50, 77, 900});
+        CHECK(sparse.m_table.m_kind == enum_table::kind_t::kSparse && sparse.m_table.m_sorted.size() == 3);
+        CHECK(sparse.m_table.m_sorted[0].m_index == 0 && sparse.m_table.m_sorted[2].m_index == 1);
+
+        check_view({dense, flags, sparse});
+    }
+} // namespace
+
+int main() {
+    test_dense();
+    test_flags();
+    test_sparse();
+    test_duplicates();
+    return 0;
+}
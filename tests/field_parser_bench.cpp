@@ -0,0 +1,159 @@
+#include "test.h"
+#include "tools/field_parser.h"
+#include <chrono>
+#include <format>
+#include <random>
+#include <string>
+#include <vector>
+
+// Parsing and printing every field of a large synthetic schema, against the field_parser this one replaced, kept
+// below as it was. Types are builtins, templates and pointers, arrays have up to three dimensions. Both have to
+// print the same type for every field before anything is timed.
+namespace {
+    constexpr std::size_t kFieldCount = 600000;
+
+    namespace legacy {
+        struct field_info_t {
+            std::string m_type = "";
+            std::string m_name = "";
+            std::vector<std::size_t> m_array_sizes = {};
+
+            std::string formatted_array_sizes() const {
+                std::string result;
+                for ([[maybe_unused]] std::size_t size : m_array_sizes)
+                    result += std::format("[]");
+
+                return result;
+            }
+
+            std::string formatted_type() const {
+                std::string result = m_type;
+                replace_all(result, "*", "?");
+
+                if (!m_array_sizes.empty())
+                    result = std::format("{}{}", result, formatted_array_sizes());
+
+                return result;
+            }
+        private:
+            static void replace_all(std::string& str, const std::string& from, const std::string& to) {
+                std::size_t start_pos = 0;
+                while ((start_pos = str.find(from, start_pos)) != std::string::npos) {
+                    str.replace(start_pos, from.length(), to);
+                    start_pos += to.length();
+                }
+            }
+        };
+
+        const std::initializer_list<std::pair<std::string_view, std::string_view>> kTypeNameToCs = {
+            {"float32", "float"}, {"float64", "double"}, {"int8", "sbyte"},   {"int16", "short"},   {"int32", "int"},
+            {"int64", "long"},    {"uint8", "byte"},     {"uint16", "ushort"}, {"uint32", "uint"}, {"uint64", "ulong"},
+        };
+
+        field_info_t parse(const std::string& type_name, const std::string& name, const std::vector<std::size_t>& array_sizes) {
+            field_info_t result = {};
+            result.m_name = name;
+            std::copy(array_sizes.begin(), array_sizes.end(), std::back_inserter(result.m_array_sizes));
+
+            result.m_type = type_name;
+            for (const auto& rule : kTypeNameToCs) {
+                if (result.m_type != rule.first)
+                    continue;
+
+                result.m_type = rule.second;
+                break;
+            }
+
+            return result;
+        }
+    } // namespace legacy
+
+    struct field_t {
+        std::string m_type = "";
+        std::string m_name = "";
+        std::vector<std::size_t> m_array_sizes = {};
+    };
+
+    std::vector<field_t> make_fields(std::mt19937_64& random) {
+        constexpr std::array<const char*, 12> builtins = {"float32", "float64", "int8", "int16", "int32", "int64", "uint8", "uint16", "uint32", "uint64", "bool", "char"};
+        constexpr std::array<const char*, 6> classes = {"C_BaseEntity", "CEntityInstance", "CGameSceneNode", "Vector", "QAngle", "CUtlSymbolLarge"};
+        constexpr std::array<std::pair<const char*, const char*>, 4> templates = {
+            {{"CHandle< ", " >"}, {"CUtlVector< ", " >"}, {"CNetworkUtlVectorBase< ", "* >"}, {"CUtlVector< CHandle< ", " >* >"}}};
+
+        std::vector<field_t> result(kFieldCount);
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            auto& field = result[i];
+            switch (random() % 4) {
+            case 0:
+            case 1:
+                field.m_type = builtins[random() % builtins.size()];
+                break;
+            case 2:
+                field.m_type = std::string(classes[random() % classes.size()]) + (random() % 2 == 0 ? "*" : "");
+                break;
+            default: {
+                const auto& [open, close] = templates[random() % templates.size()];
+                field.m_type = std::string(open) + classes[random() % classes.size()] + close;
+                break;
+            }
+            }
+
+            field.m_name = std::format("m_field{}", i);
+            for (auto dimensions = random() % 8 < 6 ? 0 : random() % 3 + 1; dimensions != 0; --dimensions)
+                field.m_array_sizes.push_back(random() % 64 + 1);
+        }
+
+        return result;
+    }
+
+    template <typename Fn>
+    double measure_ms(Fn&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+} // namespace
+
+int main() {
+    std::mt19937_64 random(42);
+    const auto fields = make_fields(random);
+
+    for (const auto& field : fields) {
+        const auto expected = legacy::parse(field.m_type, field.m_name, field.m_array_sizes);
+        const auto parsed = field_parser::parse(field.m_type, field.m_name, field.m_array_sizes);
+        CHECK(parsed.formatted_type() == expected.formatted_type());
+        CHECK(parsed.formatted_array_sizes() == expected.formatted_array_sizes());
+        CHECK(parsed.formatted_name() == expected.m_name);
+    }
+
+    std::size_t legacy_size = 0;
+    const auto legacy_ms = measure_ms([&] {
+        for (const auto& field : fields)
+            legacy_size += legacy::parse(field.m_type, field.m_name, field.m_array_sizes).formatted_type().size();
+    });
+
+    std::size_t formatted_size = 0;
+    const auto formatted_ms = measure_ms([&] {
+        for (const auto& field : fields)
+            formatted_size += field_parser::parse(field.m_type, field.m_name, field.m_array_sizes).formatted_type().size();
+    });
+
+    std::string buffer;
+    std::size_t appended_size = 0;
+    const auto appended_ms = measure_ms([&] {
+        for (const auto& field : fields) {
+            buffer.clear();
+            field_parser::parse(field.m_type, field.m_name, field.m_array_sizes).append_type(buffer);
+            appended_size += buffer.size();
+        }
+    });
+
+    CHECK(formatted_size == legacy_size && appended_size == legacy_size);
+
+    const auto per_field = [](const double ms) { return ms * 1e6 / kFieldCount; };
+    std::printf("%zu fields\n", fields.size());
+    std::printf("previous parser:           %.1f ms (%.1f ns per field)\n", legacy_ms, per_field(legacy_ms));
+    std::printf("formatted_type():          %.1f ms (%.1f ns per field)\n", formatted_ms, per_field(formatted_ms));
+    std::printf("append_type() to a buffer: %.1f ms (%.1f ns per field)\n", appended_ms, per_field(appended_ms));
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "test.h"
+#include "tools/field_parser.h"
+#include <array>
+
+// Types and array suffixes field_parser prints for schema field types: builtins get their c# name, everything
+// else keeps its name with every '*' turned into '?', nested templates included, and an array adds a "[]" per
+// dimension.
+namespace {
+    struct case_t {
+        std::string_view m_type = "";
+        std::vector<std::size_t> m_array_sizes = {};
+        std::string_view m_formatted_type = "";
+        std::string_view m_formatted_array_sizes = "";
+    };
+
+    void check_case(const case_t& test_case) {
+        const auto field = field_parser::parse(test_case.m_type, "m_field", test_case.m_array_sizes);
+        CHECK(field.formatted_type() == test_case.m_formatted_type);
+        CHECK(field.formatted_array_sizes() == test_case.m_formatted_array_sizes);
+        CHECK(field.formatted_name() == "m_field");
+        CHECK(field.is_array() == !test_case.m_array_sizes.empty());
+        CHECK(!field.is_bitfield());
+
+        // @note: append_type only touches what it appends
+        //
+        std::string out = "prefix* ";
+        field.append_type(out);
+        CHECK(out == std::string("prefix* ") + std::string(test_case.m_formatted_type));
+    }
+} // namespace
+
+int main() {
+    const std::vector<case_t> cases = {
+        // builtins
+        {"float32", {}, "float", ""},
+        {"float64", {}, "double", ""},
+        {"int8", {}, "sbyte", ""},
+        {"int16", {}, "short", ""},
+        {"int32", {}, "int", ""},
+        {"int64", {}, "long", ""},
+        {"uint8", {}, "byte", ""},
+        {"uint16", {}, "ushort", ""},
+        {"uint32", {}, "uint", ""},
+        {"uint64", {}, "ulong", ""},
+
+        // names that aren't builtins, or only look like one
+        {"bool", {}, "bool", ""},
+        {"float", {}, "float", ""},
+        {"Float32", {}, "Float32", ""},
+        {"float32 ", {}, "float32 ", ""},
+        {"uint6", {}, "uint6", ""},
+        {"uint640", {}, "uint640", ""},
+        {"CUnknownType_t", {}, "CUnknownType_t", ""},
+        {"", {}, "", ""},
+
+        // pointers and nested templates, builtins inside a template keep their name
+        {"float32*", {}, "float32?", ""},
+        {"char**", {}, "char??", ""},
+        {"CHandle< C_BaseEntity >", {}, "CHandle< C_BaseEntity >", ""},
+        {"CUtlVector< CHandle< C_BaseEntity >* >", {}, "CUtlVector< CHandle< C_BaseEntity >? >", ""},
+        {"CUtlVector< CUtlVector< int32 > >", {}, "CUtlVector< CUtlVector< int32 > >", ""},
+        {"CUtlMap< CUtlString, CUtlVector< CSmartPtr< CEntity* >* >* >", {}, "CUtlMap< CUtlString, CUtlVector< CSmartPtr< CEntity? >? >? >", ""},
+
+        // arrays of one to four dimensions
+        {"int32", {13}, "int[]", "[]"},
+        {"uint8", {13, 37}, "byte[][]", "[][]"},
+        {"CEntity*", {2, 3, 4}, "CEntity?[][][]", "[][][]"},
+        {"CUtlVector< float32 >", {1, 2, 3, 4}, "CUtlVector< float32 >[][][][]", "[][][][]"},
+    };
+
+    for (const auto& test_case : cases)
+        check_case(test_case);
+
+    const std::array<std::size_t, 2> sizes = {13, 37};
+    const auto array = field_parser::parse("int32", "m_nValues", sizes);
+    CHECK(array.total_array_size() == 13 * 37);
+    CHECK(array.array_sizes().size() == 2 && array.array_sizes()[0] == 13 && array.array_sizes()[1] == 37);
+    CHECK(field_parser::parse("int32", "m_nValue", {}).total_array_size() == 0);
+
+    // @note: the type and the name are views into what was passed in
+    //
+    const std::string type = "CHandle< C_BaseEntity >";
+    const auto field = field_parser::parse(type, "m_hOwner", {});
+    CHECK(field.m_type.data() == type.data());
+
+    const std::array<std::size_t, field_parser::kMaxArrayDimensions + 1> too_deep = {1, 2, 3, 4, 5};
+    CHECK_THROWS(field_parser::parse("int32", "m_nDeep", too_deep));
+    return 0;
+}
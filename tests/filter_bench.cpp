@@ -0,0 +1,66 @@
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/wildcard.h"
+#include <chrono>
+
+// What -classes costs for selections of different sizes out of a synthetic scope: the name filter FilterTypes runs,
+// then rendering what's left the way RenderTypeScope does. Filtering comes before any rendering, so the time has
+// to follow the number of selected classes, with the filter itself as the only part that sees every class.
+namespace {
+    constexpr std::size_t kClassCount = 20000;
+    constexpr std::size_t kRounds = 3;
+
+    struct result_t {
+        std::size_t m_selected = 0;
+        double m_filter_ms = 1e300;
+        double m_total_ms = 1e300;
+    };
+
+    result_t measure(const std::vector<synthetic::type_t>& classes, const std::vector<std::string>& patterns) {
+        result_t result;
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            codegen::key_cache_t key_cache;
+            auto selected = classes;
+
+            const auto start = std::chrono::steady_clock::now();
+            wildcard::erase_unmatched(selected, patterns, [](const synthetic::type_t& type) { return std::string_view(type.m_name); });
+            const auto filtered = std::chrono::steady_clock::now();
+            const auto count = selected.size();
+
+            std::size_t size = 0;
+            for (const auto& type : selected)
+                size += synthetic::render_class(&key_cache, type.m_name.c_str(), type.m_members).size();
+            const auto end = std::chrono::steady_clock::now();
+
+            CHECK(count == 0 || size > 0);
+            result.m_selected = count;
+            result.m_filter_ms = std::min(result.m_filter_ms, std::chrono::duration<double, std::milli>(filtered - start).count());
+            result.m_total_ms = std::min(result.m_total_ms, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+
+        return result;
+    }
+} // namespace
+
+int main() {
+    const auto classes = synthetic::make_types("C_Synthetic", kClassCount, 40);
+
+    // @note: what -classes= would be given, and how many of the classes each one selects
+    //
+    const std::pair<const char*, std::size_t> selections[] = {
+        {"*", kClassCount}, {"C_Synthetic1*", 11111}, {"C_Synthetic12*", 1111}, {"C_Synthetic123*", 111},
+        {"C_Synthetic1234", 1}, {"C_Synthetic1?,C_Synthetic2?", 20}, {"CCSPlayerPawn", 0},
+    };
+
+    std::printf("%zu classes\n", kClassCount);
+    for (const auto& [list, expected] : selections) {
+        const auto result = measure(classes, wildcard::split_list(list));
+        CHECK(result.m_selected == expected);
+
+        const auto per_class = result.m_selected != 0 ? (result.m_total_ms - result.m_filter_ms) * 1000.0 / static_cast<double>(result.m_selected) : 0.0;
+        std::printf("-classes=%-28s %6zu selected: %8.2f ms, %5.2f ms of it filtering, %5.1f us per rendered class\n", list, result.m_selected,
+                    result.m_total_ms, result.m_filter_ms, per_class);
+    }
+
+    return 0;
+}
@@ -0,0 +1,18 @@
+#include "synthetic_lookup.h"
+#include <cstdio>
+#include <fstream>
+
+// Writes synthetic_lookup.hpp, the -lookup header of synthetic::make_lookup_scope, to the path it's given.
+int main(const int argc, const char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: generate_lookup <output path>\n");
+        return 1;
+    }
+
+    const auto scope = synthetic::make_lookup_scope();
+
+    std::ofstream f(argv[1], std::ios::out | std::ios::binary);
+    f << sdk::RenderLookupTables("synthetic", scope.m_classes, false);
+    f.close();
+    return f ? 0 : 1;
+}
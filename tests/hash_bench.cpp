@@ -0,0 +1,100 @@
+#include "test.h"
+#include "tools/fnv.h"
+#include <array>
+#include <chrono>
+#include <format>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Throughput of whash64 against fnv32 and fnv64, over synthetic names shaped like schema class, field and metadata
+// names, and over 4 KB buffers. Every hash is checked for collisions among the names before anything is timed.
+namespace {
+    constexpr std::size_t kNameCount = 20000;
+    constexpr std::size_t kNameRounds = 50;
+    constexpr std::size_t kBufferSize = 4096;
+    constexpr std::size_t kBufferRounds = 20000;
+
+    std::vector<std::string> make_names(std::mt19937_64& random) {
+        constexpr std::array<const char*, 12> parts = {"Base", "Player", "Pawn", "Weapon", "Controller", "Entity", "Model", "Physics", "Game", "Rules", "Item", "Component"};
+        constexpr std::array<const char*, 4> prefixes = {"C_", "CCS", "m_h", "MNetwork"};
+
+        std::vector<std::string> result;
+        for (std::size_t i = 0; i < kNameCount; ++i) {
+            auto name = std::string(prefixes[random() % prefixes.size()]);
+            for (auto j = random() % 4 + 1; j != 0; --j)
+                name += parts[random() % parts.size()];
+            result.push_back(std::format("{}{}", name, i));
+        }
+
+        return result;
+    }
+
+    struct result_t {
+        double m_mb_per_s = 0.0;
+        double m_ns_per_item = 0.0;
+    };
+
+    template <typename Fn>
+    result_t measure(const std::vector<std::string_view>& items, const std::size_t rounds, Fn&& fn) {
+        std::size_t bytes = 0;
+        for (const auto item : items)
+            bytes += item.size();
+
+        std::uint64_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (const auto item : items)
+                sink += fn(item);
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        CHECK(sink != 0);
+        return {static_cast<double>(bytes * rounds) / seconds / (1024.0 * 1024.0), seconds * 1e9 / static_cast<double>(items.size() * rounds)};
+    }
+
+    template <typename Fn>
+    void check_unique(const std::vector<std::string_view>& names, Fn&& fn) {
+        std::unordered_set<std::uint64_t> hashes;
+        for (const auto name : names)
+            CHECK(hashes.insert(fn(name)).second);
+    }
+} // namespace
+
+int main() {
+    std::mt19937_64 random(43);
+    const auto name_storage = make_names(random);
+    const std::vector<std::string_view> names(name_storage.begin(), name_storage.end());
+
+    std::string buffer(kBufferSize, '\0');
+    for (auto& c : buffer)
+        c = static_cast<char>(random());
+    const std::vector<std::string_view> buffers = {buffer};
+
+    const auto fnv32_hash = [](const std::string_view str) { return std::uint64_t{fnv32::hash_runtime(str.data(), str.size())}; };
+    const auto fnv64_hash = [](const std::string_view str) { return fnv64::hash_runtime(str.data(), str.size()); };
+    const auto word_hash = [](const std::string_view str) { return whash64::hash_runtime(str); };
+
+    check_unique(names, fnv32_hash);
+    check_unique(names, fnv64_hash);
+    check_unique(names, word_hash);
+
+    std::size_t name_bytes = 0;
+    for (const auto name : names)
+        name_bytes += name.size();
+
+    std::printf("%zu names, %.1f bytes on average\n", names.size(), static_cast<double>(name_bytes) / static_cast<double>(names.size()));
+    const auto report = [&](const char* label, const auto& fn) {
+        const auto short_inputs = measure(names, kNameRounds, fn);
+        const auto long_inputs = measure(buffers, kBufferRounds, fn);
+        std::printf("%s  names: %7.1f MB/s, %5.1f ns per name  %zu KB buffers: %7.1f MB/s\n", label, short_inputs.m_mb_per_s, short_inputs.m_ns_per_item,
+                    kBufferSize / 1024, long_inputs.m_mb_per_s);
+    };
+
+    report("fnv32  ", fnv32_hash);
+    report("fnv64  ", fnv64_hash);
+    report("whash64", word_hash);
+
+    return 0;
+}
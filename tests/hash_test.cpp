@@ -0,0 +1,70 @@
+#include "test.h"
+#include "tools/fnv.h"
+#include <array>
+#include <cstring>
+
+// Runtime hashes against the compile time ones for every length up to 40 bytes, so whash64 goes through the 8 byte
+// word loop, the 4 byte step of the tail and the single bytes after it, at every alignment of the input.
+namespace {
+    constexpr std::size_t kMaxLength = 40;
+    constexpr char kText[] = "MNetworkChangeCallback_m_hOwnerEntity_0123456789";
+    static_assert(sizeof(kText) - 1 > kMaxLength);
+
+    template <typename Fn>
+    constexpr auto hash_prefixes(Fn&& fn) {
+        std::array<decltype(fn(std::size_t{0})), kMaxLength + 1> result = {};
+        for (std::size_t size = 0; size <= kMaxLength; ++size)
+            result[size] = fn(size);
+
+        return result;
+    }
+
+    constexpr auto kWordHashes = hash_prefixes([](const std::size_t size) { return whash64::hash_data(kText, size); });
+    constexpr auto kFnv32Hashes = hash_prefixes([](const std::size_t size) { return fnv32::hash_constexpr(kText, size); });
+    constexpr auto kFnv64Hashes = hash_prefixes([](const std::size_t size) { return fnv64::hash_constexpr(kText, size); });
+
+    // @note: different lengths, different hashes
+    //
+    static_assert(kWordHashes[8] != kWordHashes[9] && kWordHashes[12] != kWordHashes[13] && kWordHashes[32] != kWordHashes[40]);
+
+    void test_prefixes() {
+        alignas(8) char buffer[sizeof(kText) + 8] = {};
+        for (std::size_t offset = 0; offset < 8; ++offset) {
+            std::memcpy(buffer + offset, kText, sizeof(kText));
+            const auto data = buffer + offset;
+
+            for (std::size_t size = 0; size <= kMaxLength; ++size) {
+                CHECK(whash64::hash_runtime(std::string_view(data, size)) == kWordHashes[size]);
+                CHECK(whash64::hasher{}(std::string_view(data, size)) == static_cast<std::size_t>(kWordHashes[size]));
+                CHECK(fnv32::hash_runtime(data, size) == kFnv32Hashes[size]);
+                CHECK(fnv64::hash_runtime_data(data, size) == kFnv64Hashes[size]);
+            }
+
+            // @note: the null terminated overloads stop at the terminator
+            //
+            data[kMaxLength] = '\0';
+            CHECK(fnv64::hash_runtime(data) == kFnv64Hashes[kMaxLength]);
+            data[0] = '\0';
+            CHECK(fnv32::hash_runtime(data) == kFnv32Hashes[0]);
+        }
+    }
+
+    // @note: the macros on literals that reach the word loop and the 4 byte tail
+    //
+    void test_literals() {
+        const std::string_view names[] = {"MNetwork", "MNetworkEnab", "MNetworkEnable", "MPropertyFriendlyName", "MNetworkChangeCallback_m_hOwner"};
+        CHECK(whash64::hash_runtime(names[0]) == WHASH64("MNetwork"));
+        CHECK(whash64::hash_runtime(names[1]) == WHASH64("MNetworkEnab"));
+        CHECK(whash64::hash_runtime(names[2]) == WHASH64("MNetworkEnable"));
+        CHECK(whash64::hash_runtime(names[3]) == WHASH64("MPropertyFriendlyName"));
+        CHECK(whash64::hash_runtime(names[4]) == WHASH64("MNetworkChangeCallback_m_hOwner"));
+        CHECK(fnv64::hash_runtime(names[3].data(), names[3].size()) == FNV64("MPropertyFriendlyName"));
+        CHECK(fnv32::hash_runtime(names[4].data(), names[4].size()) == FNV32("MNetworkChangeCallback_m_hOwner"));
+    }
+} // namespace
+
+int main() {
+    test_prefixes();
+    test_literals();
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "test.h"
+#include "tools/headless.h"
+#include <array>
+#include <new>
+#include <stdexcept>
+
+namespace {
+    // @note: a stand-in engine where modules register their scopes over time
+    //
+    struct game_t {
+        const char* m_output_dir = "out";
+        std::vector<std::string> m_expected = {};
+        std::optional<headless::scopes_t> m_scopes = std::nullopt;
+        std::function<void()> m_dump = []() { };
+        std::vector<std::string> m_dumped_scopes = {};
+        std::string m_error = "";
+        int m_exit_code = -1;
+
+        headless::trigger_t make_trigger() {
+            return headless::trigger_t({
+                .m_get_output_dir = [this]() { return m_output_dir; },
+                .m_get_expected_scopes = [this]() { return m_expected; },
+                .m_get_scopes = [this]() { return m_scopes; },
+                .m_dump =
+                    [this](const std::string&) {
+                        m_dumped_scopes = m_scopes->m_names;
+                        m_dump();
+                    },
+                .m_report_error = [this](const std::string& message) { m_error = message; },
+                .m_exit = [this](const int exit_code) { m_exit_code = exit_code; },
+            });
+        }
+
+        void register_scope(const std::string& name) {
+            if (!m_scopes)
+                m_scopes.emplace();
+            m_scopes->m_names.push_back(name);
+            m_scopes->m_fingerprint = m_scopes->m_fingerprint * 31 + std::hash<std::string>()(name);
+        }
+    };
+
+    void test_waits_for_scopes_to_settle() {
+        game_t game;
+        auto trigger = game.make_trigger();
+
+        // @note: Connect, the schema system isn't there yet
+        //
+        CHECK(!trigger.poll());
+
+        game.register_scope("!GlobalTypes");
+        game.register_scope("server");
+        CHECK(!trigger.poll());
+        CHECK(!trigger.poll());
+
+        // @note: client shows up before the server scopes settled, that starts the wait over
+        //
+        game.register_scope("client");
+        for (std::uint32_t i = 0; i < headless::kSettlePolls; ++i)
+            CHECK(!trigger.poll());
+
+        CHECK(trigger.poll());
+        CHECK(trigger.done());
+        CHECK(game.m_exit_code == headless::kExitSuccess);
+        CHECK(game.m_dumped_scopes.size() == 3);
+        CHECK(!trigger.poll());
+    }
+
+    void test_waits_for_expected_scopes() {
+        game_t game;
+        game.m_expected = {"client", "server"};
+        auto trigger = game.make_trigger();
+
+        game.register_scope("server");
+        for (std::uint32_t i = 0; i < headless::kSettlePolls * 4; ++i)
+            CHECK(!trigger.poll());
+
+        game.register_scope("client");
+        for (std::uint32_t i = 0; i < headless::kSettlePolls; ++i)
+            CHECK(!trigger.poll());
+        CHECK(trigger.poll());
+        CHECK(game.m_dumped_scopes.size() == 2);
+    }
+
+    void test_every_failure_exits() {
+        const std::array<std::function<void()>, 3> failures = {
+            []() { throw std::runtime_error("disk full"); },
+            []() { throw std::bad_alloc(); },
+            []() { throw 42; },
+        };
+
+        for (const auto& failure : failures) {
+            game_t game;
+            game.m_dump = failure;
+            game.register_scope("server");
+
+            auto trigger = game.make_trigger();
+            while (!trigger.poll())
+                CHECK(!trigger.done());
+
+            CHECK(game.m_exit_code == headless::kExitFailure);
+            CHECK(!game.m_error.empty());
+        }
+    }
+
+    void test_disarms_without_launch_parameter() {
+        game_t game;
+        game.m_output_dir = nullptr;
+        game.register_scope("server");
+
+        auto trigger = game.make_trigger();
+        CHECK(!trigger.poll());
+        CHECK(trigger.done());
+        CHECK(game.m_exit_code == -1);
+    }
+} // namespace
+
+int main() {
+    test_waits_for_scopes_to_settle();
+    test_waits_for_expected_scopes();
+    test_every_failure_exits();
+    test_disarms_without_launch_parameter();
+    return 0;
+}
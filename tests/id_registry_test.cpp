@@ -0,0 +1,101 @@
+#include "test.h"
+#include "tools/id_registry.h"
+
+namespace {
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream f(path, std::ios::in | std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    }
+
+    void test_ids_survive_runs(const std::filesystem::path& dir) {
+        const auto path = dir / "ids.txt";
+        const auto templated = ids::registry_t::field_key("CNetworkUtlVectorBase< CHandle< C_BaseEntity > >", "m_size");
+
+        // @note: first run, keys in the order the schema system happens to hand them out
+        //
+        ids::registry_t first;
+        first.load(path);
+        first.request(ids::kind_t::kClass, "C_CSPlayerPawn");
+        first.request(ids::kind_t::kClass, "C_BaseEntity");
+        first.request(ids::kind_t::kField, templated);
+        first.request(ids::kind_t::kField, "C_BaseEntity::m_iHealth");
+        first.request(ids::kind_t::kEnum, "MoveType_t");
+        CHECK(first.commit() == 5);
+        first.save(path);
+
+        const auto class_id = *first.find(ids::kind_t::kClass, "C_CSPlayerPawn");
+        const auto templated_id = *first.find(ids::kind_t::kField, templated);
+
+        // @note: next build, a new class shows up and an old one is gone, the old ids stay
+        //
+        ids::registry_t second;
+        second.load(path);
+        CHECK(second.find(ids::kind_t::kField, templated) == templated_id);
+        second.request(ids::kind_t::kClass, "C_CSPlayerPawn");
+        second.request(ids::kind_t::kClass, "C_AAA_New");
+        CHECK(second.commit() == 1);
+        CHECK(second.find(ids::kind_t::kClass, "C_CSPlayerPawn") == class_id);
+        CHECK(second.find(ids::kind_t::kClass, "C_AAA_New") == 2u);
+        CHECK(second.find(ids::kind_t::kClass, "C_BaseEntity").has_value());
+        CHECK(second.size(ids::kind_t::kClass) == 3);
+        second.save(path);
+        const auto saved = read_file(path);
+
+        // @note: loading and saving without changes gives the same file back
+        //
+        ids::registry_t third;
+        third.load(path);
+        CHECK(third.commit() == 0);
+        third.save(path);
+        CHECK(read_file(path) == saved);
+        CHECK(third.find(ids::kind_t::kField, templated) == templated_id);
+    }
+
+    void test_request_order_doesnt_matter(const std::filesystem::path& dir) {
+        ids::registry_t a, b;
+        for (const auto name : {"B", "A", "C"})
+            a.request(ids::kind_t::kClass, name);
+        for (const auto name : {"C", "B", "A", "B"})
+            b.request(ids::kind_t::kClass, name);
+        CHECK(a.commit() == 3);
+        CHECK(b.commit() == 3);
+
+        a.save(dir / "a.txt");
+        b.save(dir / "b.txt");
+        CHECK(read_file(dir / "a.txt") == read_file(dir / "b.txt"));
+    }
+
+    void test_malformed_files(const std::filesystem::path& dir) {
+        const auto load = [&](const std::string& text) {
+            std::ofstream(dir / "bad.txt", std::ios::out | std::ios::binary) << text;
+            ids::registry_t registry;
+            registry.load(dir / "bad.txt");
+            return registry;
+        };
+
+        CHECK_THROWS(load("class 0\n"));
+        CHECK_THROWS(load("class x A\n"));
+        CHECK_THROWS(load("struct 0 A\n"));
+        CHECK_THROWS(load("class 0 A\nclass 1 A\n"));
+        CHECK_THROWS(load("class 0 A\nclass 0 B\n"));
+        CHECK_THROWS(load("field 3 A::m_a\nfield 1 A::m_b\nfield 3 A::m_c\n"));
+
+        // @note: ids are per kind, a class and an enum can share one
+        //
+        const auto shared = load("class 0 A\nenum 0 A\n");
+        CHECK(shared.find(ids::kind_t::kClass, "A") == 0u && shared.find(ids::kind_t::kEnum, "A") == 0u);
+
+        const auto registry = load("# comment\n\nclass 4 A< B >\n");
+        CHECK(registry.find(ids::kind_t::kClass, "A< B >") == 4u);
+        CHECK(registry.size(ids::kind_t::kClass) == 5);
+    }
+} // namespace
+
+int main() {
+    const auto dir = test::temp_dir("id_registry");
+    test_ids_survive_runs(dir);
+    test_request_order_doesnt_matter(dir);
+    test_malformed_files(dir);
+    std::filesystem::remove_all(dir);
+    return 0;
+}
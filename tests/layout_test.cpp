@@ -0,0 +1,118 @@
+#include "test.h"
+#include "tools/layout.h"
+
+// Synthetic class layouts: the bytes in front of the first field, holes between fields and after the last one,
+// fields that overlap or have no known size, fields past the end of the class, and the cache lines networked
+// fields fall in.
+namespace {
+    layout::field_t field(const std::uint32_t offset, const std::uint32_t size, const bool networked = false, const std::string_view name = "") {
+        layout::field_t result;
+        result.m_name = name;
+        result.m_offset = offset;
+        result.m_size = size;
+        result.m_networked = networked;
+        return result;
+    }
+
+    bool has_holes(const layout::report_t& report, const std::vector<std::pair<std::uint32_t, std::uint32_t>>& holes) {
+        if (report.m_holes.size() != holes.size())
+            return false;
+
+        for (std::size_t i = 0; i < holes.size(); ++i) {
+            if (report.m_holes[i].m_offset != holes[i].first || report.m_holes[i].m_size != holes[i].second)
+                return false;
+        }
+
+        return true;
+    }
+
+    // @note: a vtable pointer in front, a hole after an int, a bool followed by tail padding
+    //
+    void test_holes_and_tail_padding() {
+        const auto report = layout::analyze(32, {field(16, 8), field(8, 4), field(24, 1)});
+        CHECK(report.m_leading == 8);
+        CHECK(has_holes(report, {{12, 4}, {25, 7}}));
+        CHECK(report.m_tail_padding == 7);
+        CHECK(report.m_padding == 11);
+        CHECK(report.m_cache_lines == 1);
+        CHECK(report.m_fields[0].m_offset == 8 && report.m_fields[1].m_offset == 16 && report.m_fields[2].m_offset == 24);
+        CHECK(report.fragmentation() == 11.0 / 32.0);
+
+        const auto packed = layout::analyze(16, {field(0, 8), field(8, 8)});
+        CHECK(packed.m_leading == 0 && packed.m_holes.empty() && packed.m_padding == 0 && packed.m_tail_padding == 0);
+
+        const auto empty = layout::analyze(24, {});
+        CHECK(empty.m_holes.empty() && empty.m_padding == 0 && empty.m_leading == 0 && empty.m_cache_lines == 1);
+    }
+
+    // @note: a byte is used if any field covers it, the union comes before its members at the same offset
+    //
+    void test_union_overlap() {
+        const auto report = layout::analyze(24, {field(0, 4, false, "a"), field(0, 8, false, "u"), field(4, 4, false, "b"), field(6, 4, false, "c"),
+                                                 field(16, 8, false, "d")});
+        CHECK(report.m_fields[0].m_name == "u" && report.m_fields[1].m_name == "a");
+        CHECK(has_holes(report, {{10, 6}}));
+        CHECK(report.m_padding == 6 && report.m_tail_padding == 0);
+
+        // @note: a field inside an earlier, bigger one doesn't pull the cursor back
+        //
+        const auto nested = layout::analyze(32, {field(0, 24), field(4, 4), field(28, 4)});
+        CHECK(has_holes(nested, {{24, 4}}));
+    }
+
+    // @note: a field of unknown size reaches the next field that starts after it, or the end of the class
+    //
+    void test_unknown_sizes() {
+        const auto middle = layout::analyze(32, {field(8, 0), field(8, 0), field(20, 4)});
+        CHECK(middle.m_leading == 8);
+        CHECK(has_holes(middle, {{24, 8}}));
+        CHECK(middle.m_tail_padding == 8);
+
+        const auto last = layout::analyze(32, {field(0, 4), field(8, 0)});
+        CHECK(has_holes(last, {{4, 4}}));
+        CHECK(last.m_tail_padding == 0);
+        CHECK(last.m_fields[1].last_line() == last.m_fields[1].first_line());
+    }
+
+    // @note: a schema can put fields past the size of the class, holes stop at the size
+    //
+    void test_fields_past_the_size() {
+        const auto report = layout::analyze(16, {field(0, 4), field(32, 4)});
+        CHECK(has_holes(report, {{4, 12}}));
+        CHECK(report.m_padding == 12 && report.m_tail_padding == 0);
+
+        const auto outside = layout::analyze(16, {field(40, 4)});
+        CHECK(outside.m_leading == 16);
+        CHECK(outside.m_holes.empty() && outside.m_padding == 0);
+
+        const auto overhang = layout::analyze(16, {field(12, 8)});
+        CHECK(overhang.m_leading == 12 && overhang.m_holes.empty() && overhang.m_tail_padding == 0);
+    }
+
+    void test_cache_lines() {
+        const auto report = layout::analyze(256, {field(0, 8, true), field(60, 8, true), field(120, 16, false), field(130, 4, true), field(200, 4, false)});
+        CHECK(report.m_cache_lines == 4);
+        CHECK(report.m_straddling == 1); // 60..67, the field at 120 straddles as well but isn't networked
+        CHECK(report.m_networked_lines == 3); // lines 0, 1 and 2
+
+        // @note: networked fields past the size still count, the lines are what an instance touches
+        //
+        const auto past = layout::analyze(64, {field(0, 4, true), field(130, 4, true)});
+        CHECK(past.m_cache_lines == 1 && past.m_networked_lines == 2);
+
+        const auto wide = layout::analyze(256, {field(32, 160, true)});
+        CHECK(wide.m_straddling == 1 && wide.m_networked_lines == 3);
+
+        const auto none = layout::analyze(128, {field(0, 8), field(64, 8)});
+        CHECK(none.m_networked_lines == 0 && none.m_straddling == 0 && none.m_cache_lines == 2);
+    }
+} // namespace
+
+int main() {
+    test_holes_and_tail_padding();
+    test_union_overlap();
+    test_unknown_sizes();
+    test_fields_past_the_size();
+    test_cache_lines();
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "sdk/compressed_dump.h"
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/lz.h"
+#include <chrono>
+#include <fstream>
+
+// Compression ratio and throughput of lz on a synthetic scope json: the whole json as a single block, then the
+// <scope>.jsonlz -compress writes (64 KiB blocks cut at entries) on one thread, read back whole and one entry at a time.
+// Everything is decompressed and compared before it's timed.
+namespace {
+    constexpr std::size_t kClassCount = 4000;
+    constexpr std::size_t kEnumCount = 1000;
+    constexpr std::size_t kBlockSize = 64 * 1024;
+    constexpr std::size_t kRounds = 3;
+
+    // @note: the best of a few rounds, in ms
+    //
+    template <typename Fn>
+    double measure(Fn&& fn) {
+        auto result = 1e300;
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            result = std::min(result, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        return result;
+    }
+
+    double to_mb_per_s(const std::size_t bytes, const double ms) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0) / (ms / 1000.0);
+    }
+} // namespace
+
+int main() {
+    const auto dir = test::temp_dir("lz_bench");
+    const auto scope = synthetic::make_scope("client", synthetic::make_types("E_Synthetic", kEnumCount, 16), synthetic::make_types("C_Synthetic", kClassCount, 40));
+
+    std::vector<dump_index::entry_t> index_entries;
+    const auto json = sdk::AssembleScopeJson(scope.m_rendered, &index_entries);
+    const auto json_data = reinterpret_cast<const std::uint8_t*>(json.data());
+
+    std::vector<std::uint8_t> block;
+    lz::compress(json_data, json.size(), block);
+    std::string decompressed(json.size(), '\0');
+    CHECK(lz::decompress(block.data(), block.size(), reinterpret_cast<std::uint8_t*>(decompressed.data()), decompressed.size()));
+    CHECK(decompressed == json);
+
+    const auto dump = compressed_dump::serialize(json, index_entries, kBlockSize, 1);
+    {
+        std::ofstream f(dir / "client.jsonlz", std::ios::out | std::ios::binary);
+        f.write(reinterpret_cast<const char*>(dump.data()), static_cast<std::streamsize>(dump.size()));
+    }
+    const auto reader = compressed_dump::reader_t::open(dir / "client.jsonlz");
+    CHECK(reader.read_all() == json);
+
+    const auto compress_ms = measure([&] {
+        std::vector<std::uint8_t> out;
+        out.reserve(json.size());
+        lz::compress(json_data, json.size(), out);
+        CHECK(out.size() == block.size());
+    });
+    const auto decompress_ms = measure([&] {
+        CHECK(lz::decompress(block.data(), block.size(), reinterpret_cast<std::uint8_t*>(decompressed.data()), decompressed.size()));
+    });
+    const auto serialize_ms = measure([&] { CHECK(compressed_dump::serialize(json, index_entries, kBlockSize, 1).size() == dump.size()); });
+    const auto read_all_ms = measure([&] { CHECK(reader.read_all().size() == json.size()); });
+
+    // @note: every entry on its own, each one decompresses the block holding it
+    //
+    std::size_t entry_bytes = 0;
+    const auto read_entries_ms = measure([&] {
+        entry_bytes = 0;
+        for (const auto& entry : index_entries)
+            entry_bytes += reader.read(entry.offset, entry.length).size();
+    });
+
+    std::printf("%zu enums, %zu classes, %zu bytes of json\n", kEnumCount, kClassCount, json.size());
+    std::printf("single block:   %zu bytes, ratio %.2f, compress %7.1f MB/s, decompress %7.1f MB/s\n", block.size(),
+                static_cast<double>(json.size()) / static_cast<double>(block.size()), to_mb_per_s(json.size(), compress_ms),
+                to_mb_per_s(json.size(), decompress_ms));
+    std::printf("%zu KiB blocks: %zu bytes in %u blocks, ratio %.2f, compress %7.1f MB/s, read_all %7.1f MB/s\n", kBlockSize / 1024, dump.size(),
+                reader.header().block_count, static_cast<double>(json.size()) / static_cast<double>(dump.size()), to_mb_per_s(json.size(), serialize_ms),
+                to_mb_per_s(json.size(), read_all_ms));
+    std::printf("reading %zu entries one by one: %.1f ms, %.1f us per entry\n", index_entries.size(), read_entries_ms,
+                read_entries_ms * 1000.0 / static_cast<double>(index_entries.size()));
+    CHECK(entry_bytes > 0);
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
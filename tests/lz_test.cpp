@@ -0,0 +1,200 @@
+#include "sdk/compressed_dump.h"
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/lz.h"
+#include <fstream>
+#include <random>
+
+// lz round trips around the edges of the LZ4 block format: no input, inputs too short to hold a match, runs whose
+// matches overlap the bytes they produce, literal and match lengths on both sides of where the extra length bytes
+// start, and data that doesn't compress. Every proper prefix of a compressed block has to be rejected. Then a
+// compressed_dump written in small blocks is read back across block boundaries.
+namespace {
+    std::vector<std::uint8_t> compress(const std::vector<std::uint8_t>& data) {
+        std::vector<std::uint8_t> result;
+        lz::compress(data.data(), data.size(), result);
+        return result;
+    }
+
+    // @note: returns the compressed size
+    //
+    std::size_t check_round_trip(const std::vector<std::uint8_t>& data) {
+        const auto compressed = compress(data);
+
+        // @note: the worst case of the format, a literal length byte per 255 literals plus the token
+        //
+        CHECK(compressed.size() <= data.size() + data.size() / 255 + 16);
+
+        std::vector<std::uint8_t> decompressed(data.size() + 1, 0xCC);
+        CHECK(lz::decompress(compressed.data(), compressed.size(), decompressed.data(), data.size()));
+        CHECK(decompressed.back() == 0xCC);
+        decompressed.pop_back();
+        CHECK(decompressed == data);
+
+        // @note: too little room for the output is malformed input too
+        //
+        if (!data.empty())
+            CHECK(!lz::decompress(compressed.data(), compressed.size(), decompressed.data(), data.size() - 1));
+
+        return compressed.size();
+    }
+
+    std::vector<std::uint8_t> make_random(std::mt19937_64& random, const std::size_t size) {
+        std::vector<std::uint8_t> result(size);
+        for (auto& byte : result)
+            byte = static_cast<std::uint8_t>(random());
+
+        return result;
+    }
+
+    void test_short() {
+        CHECK(compress({}).size() == 1);
+        check_round_trip({});
+
+        // @note: up to kMatchFindLimit bytes everything is a literal, even when it repeats
+        //
+        for (std::size_t size = 1; size <= lz::kMatchFindLimit; ++size) {
+            const std::vector<std::uint8_t> zeros(size, 0);
+            CHECK(check_round_trip(zeros) == size + 1);
+
+            std::vector<std::uint8_t> counting;
+            for (std::size_t i = 0; i < size; ++i)
+                counting.push_back(static_cast<std::uint8_t>(i));
+            CHECK(check_round_trip(counting) == size + 1);
+        }
+    }
+
+    // @note: a run is a match at an offset shorter than itself, the decoder has to copy byte by byte
+    //
+    void test_runs() {
+        for (const std::size_t period : {1, 2, 3, 4, 7, 16}) {
+            for (const std::size_t size : {13, 14, 20, 300, 5000, 100000}) {
+                std::vector<std::uint8_t> data(size);
+                for (std::size_t i = 0; i < size; ++i)
+                    data[i] = static_cast<std::uint8_t>('a' + i % period);
+
+                const auto compressed_size = check_round_trip(data);
+                if (size >= 300)
+                    CHECK(compressed_size < size / 50 + 32);
+            }
+        }
+    }
+
+    // @note: a random block and its copy: the literal length is the block's, the match length the copy's minus the last
+    // literals. 15 and 15 + 255 are where the token runs out and where a second length byte is needed
+    //
+    void test_lengths(std::mt19937_64& random) {
+        for (const std::size_t length : {14, 15, 16, 17, 18, 19, 20, 268, 269, 270, 271, 272, 273, 274, 275, 524, 525, 526, 1000, 4096}) {
+            const auto block = make_random(random, length);
+            auto data = block;
+            data.insert(data.end(), block.begin(), block.end());
+            data.insert(data.end(), lz::kLastLiterals, 0x5A);
+
+            // @note: token, the literal length bytes, the literals, the offset, the match length bytes and the last literals
+            //
+            const auto length_bytes = [](const std::size_t value) { return value < 15 ? 0 : (value - 15) / 255 + 1; };
+            CHECK(check_round_trip(data) == 1 + length_bytes(length) + length + 2 + length_bytes(length - lz::kMinMatch) + 1 + lz::kLastLiterals);
+        }
+
+        // @note: the same text at the start of every line, like the keys of a dump
+        //
+        std::vector<std::uint8_t> lines;
+        for (std::size_t i = 0; i < 2000; ++i) {
+            const auto line = "                \"m_field" + std::to_string(i) + "\": {\"offset\": " + std::to_string(i * 4) + ", \"type\": \"int32\"},\n";
+            lines.insert(lines.end(), line.begin(), line.end());
+        }
+        CHECK(check_round_trip(lines) < lines.size() / 3);
+    }
+
+    void test_incompressible(std::mt19937_64& random) {
+        for (const std::size_t size : {13, 64, 1000, 65536, 300000}) {
+            const auto data = make_random(random, size);
+            CHECK(check_round_trip(data) >= size);
+        }
+    }
+
+    // @note: every proper prefix of a block ends in the middle of a sequence or decodes to less than the whole
+    //
+    void test_truncated(std::mt19937_64& random) {
+        auto data = make_random(random, 600);
+        data.insert(data.end(), data.begin() + 10, data.begin() + 400);
+        data.insert(data.end(), 300, 'x');
+        data.insert(data.end(), data.begin(), data.begin() + 100);
+
+        const auto compressed = compress(data);
+        std::vector<std::uint8_t> out(data.size());
+        for (std::size_t size = 0; size < compressed.size(); ++size)
+            CHECK(!lz::decompress(compressed.data(), size, out.data(), out.size()));
+
+        // @note: an offset pointing in front of the output
+        //
+        const std::uint8_t bad_offset[] = {0x10, 'a', 0x02, 0x00, 0x50, 'a', 'a', 'a', 'a', 'a'};
+        std::uint8_t small[16];
+        CHECK(!lz::decompress(bad_offset, sizeof(bad_offset), small, 10));
+    }
+
+    void test_compressed_dump() {
+        const auto dir = test::temp_dir("lz");
+        const auto scope = synthetic::make_scope("client", synthetic::make_types("E_Synthetic", 40, 10), synthetic::make_types("C_Synthetic", 300, 20));
+
+        std::vector<dump_index::entry_t> index_entries;
+        const auto json = sdk::AssembleScopeJson(scope.m_rendered, &index_entries);
+
+        constexpr std::size_t kBlockSize = 4096;
+        const auto data = compressed_dump::serialize(json, index_entries, kBlockSize, 4);
+        {
+            std::ofstream f(dir / "client.jsonlz", std::ios::out | std::ios::binary);
+            f.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        }
+
+        const auto reader = compressed_dump::reader_t::open(dir / "client.jsonlz");
+        const auto& header = reader.header();
+        CHECK(header.block_size == kBlockSize && reader.size() == json.size());
+        CHECK(header.block_count > 20 && data.size() < json.size() / 2);
+        CHECK(reader.read_all() == json);
+
+        // @note: blocks follow each other and only start where an entry starts
+        //
+        std::uint64_t next = 0;
+        for (std::uint32_t i = 0; i < header.block_count; ++i) {
+            const auto& block = reader.blocks()[i];
+            CHECK(block.uncompressed_offset == next);
+            CHECK(i == 0 || std::any_of(index_entries.begin(), index_entries.end(), [&](const dump_index::entry_t& entry) { return entry.offset == next; }));
+            CHECK(reader.find_block(block.uncompressed_offset) == &block && reader.find_block(block.uncompressed_offset + block.uncompressed_size - 1) == &block);
+            next += block.uncompressed_size;
+        }
+        CHECK(next == json.size() && reader.find_block(json.size()) == nullptr);
+
+        for (const auto& entry : index_entries)
+            CHECK(reader.read(entry.offset, entry.length) == std::string_view(json).substr(entry.offset, entry.length));
+
+        // @note: ranges over several blocks, from the middle of one to the middle of another
+        //
+        const auto& blocks = reader.blocks();
+        const auto middle = [&](const std::uint32_t i) { return blocks[i].uncompressed_offset + blocks[i].uncompressed_size / 2; };
+        for (const auto& [first, last] : {std::pair{0u, 1u}, std::pair{2u, 5u}, std::pair{1u, header.block_count - 1}}) {
+            const auto offset = middle(first);
+            const auto length = middle(last) - offset;
+            CHECK(reader.read(offset, length) == std::string_view(json).substr(offset, length));
+        }
+        CHECK(reader.read(0, json.size()) == json);
+        CHECK(reader.read(json.size() - 1, 1) == json.substr(json.size() - 1));
+        CHECK(reader.read(17, 0).empty());
+
+        CHECK_THROWS(reader.read(json.size(), 1));
+        CHECK_THROWS(reader.read(json.size() - 1, 2));
+
+        std::filesystem::remove_all(dir);
+    }
+} // namespace
+
+int main() {
+    std::mt19937_64 random(39);
+    test_short();
+    test_runs();
+    test_lengths(random);
+    test_incompressible(random);
+    test_truncated(random);
+    test_compressed_dump();
+    return 0;
+}
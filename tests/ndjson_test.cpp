@@ -0,0 +1,429 @@
+#include "test.h"
+#include "tools/codegen.h"
+#include "tools/ndjson.h"
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Records built from fragments rendered the way the dumper renders them, with quotes, backslashes, braces and
+// control characters in names and strings and objects without members. Every line has to be exactly one object
+// for a strict json parser, no trailing commas, with the strings decoding to what went in.
+namespace {
+    // @note: RFC 8259 and nothing more, a value has to end where the text ends
+    //
+    struct value_t {
+        enum class kind_t { kNull, kBool, kNumber, kString, kArray, kObject } m_kind = kind_t::kNull;
+        std::string m_text; // decoded string, or the number
+        std::vector<value_t> m_items;
+        std::vector<std::pair<std::string, value_t>> m_members; // in order, duplicates rejected
+
+        [[nodiscard]] const value_t* find(const std::string_view key) const {
+            for (const auto& [name, value] : m_members) {
+                if (name == key)
+                    return &value;
+            }
+
+            return nullptr;
+        }
+    };
+
+    class strict_parser_t {
+    public:
+        static std::optional<value_t> parse(const std::string_view input) {
+            strict_parser_t parser(input);
+            auto result = parser.parse_value(0);
+            parser.skip_whitespace();
+            if (!result || parser._pos != input.size())
+                return std::nullopt;
+
+            return result;
+        }
+    private:
+        explicit strict_parser_t(const std::string_view input): _input(input) { }
+
+        void skip_whitespace() {
+            while (_pos < _input.size() && (_input[_pos] == ' ' || _input[_pos] == '\t' || _input[_pos] == '\n' || _input[_pos] == '\r'))
+                ++_pos;
+        }
+
+        bool consume(const char c) {
+            skip_whitespace();
+            if (_pos >= _input.size() || _input[_pos] != c)
+                return false;
+
+            ++_pos;
+            return true;
+        }
+
+        std::optional<value_t> parse_value(const int depth) {
+            skip_whitespace();
+            if (_pos >= _input.size() || depth > 64)
+                return std::nullopt;
+
+            const auto c = _input[_pos];
+            if (c == '{')
+                return parse_object(depth);
+            if (c == '[')
+                return parse_array(depth);
+            if (c == '"') {
+                value_t result;
+                result.m_kind = value_t::kind_t::kString;
+                if (!parse_string(result.m_text))
+                    return std::nullopt;
+                return result;
+            }
+
+            for (const auto& [literal, kind] : {std::pair{"true", value_t::kind_t::kBool}, std::pair{"false", value_t::kind_t::kBool},
+                                               std::pair{"null", value_t::kind_t::kNull}}) {
+                if (_input.substr(_pos).starts_with(literal)) {
+                    _pos += std::strlen(literal);
+                    value_t result;
+                    result.m_kind = kind;
+                    return result;
+                }
+            }
+
+            return parse_number();
+        }
+
+        std::optional<value_t> parse_object(const int depth) {
+            value_t result;
+            result.m_kind = value_t::kind_t::kObject;
+            ++_pos;
+            if (consume('}'))
+                return result;
+
+            do {
+                skip_whitespace();
+                std::string key;
+                if (!parse_string(key) || !consume(':') || result.find(key) != nullptr)
+                    return std::nullopt;
+
+                auto value = parse_value(depth + 1);
+                if (!value)
+                    return std::nullopt;
+                result.m_members.emplace_back(std::move(key), std::move(*value));
+            } while (consume(','));
+
+            return consume('}') ? std::optional(std::move(result)) : std::nullopt;
+        }
+
+        std::optional<value_t> parse_array(const int depth) {
+            value_t result;
+            result.m_kind = value_t::kind_t::kArray;
+            ++_pos;
+            if (consume(']'))
+                return result;
+
+            do {
+                auto value = parse_value(depth + 1);
+                if (!value)
+                    return std::nullopt;
+                result.m_items.push_back(std::move(*value));
+            } while (consume(','));
+
+            return consume(']') ? std::optional(std::move(result)) : std::nullopt;
+        }
+
+        bool parse_string(std::string& out) {
+            if (_pos >= _input.size() || _input[_pos] != '"')
+                return false;
+
+            for (++_pos; _pos < _input.size(); ++_pos) {
+                const auto c = _input[_pos];
+                if (c == '"') {
+                    ++_pos;
+                    return true;
+                }
+
+                if (static_cast<unsigned char>(c) < 0x20)
+                    return false;
+
+                if (c != '\\') {
+                    out.push_back(c);
+                    continue;
+                }
+
+                if (++_pos >= _input.size())
+                    return false;
+
+                switch (_input[_pos]) {
+                case '"':
+                case '\\':
+                case '/':
+                    out.push_back(_input[_pos]);
+                    break;
+                case 'b':
+                    out.push_back('\b');
+                    break;
+                case 'f':
+                    out.push_back('\f');
+                    break;
+                case 'n':
+                    out.push_back('\n');
+                    break;
+                case 'r':
+                    out.push_back('\r');
+                    break;
+                case 't':
+                    out.push_back('\t');
+                    break;
+                case 'u': {
+                    // @note: only what the generator writes, control characters
+                    //
+                    if (_pos + 4 >= _input.size())
+                        return false;
+                    unsigned value = 0;
+                    for (auto i = 1; i <= 4; ++i) {
+                        const auto digit = _input[_pos + i];
+                        if (!std::isxdigit(static_cast<unsigned char>(digit)))
+                            return false;
+                        value = value * 16 + (std::isdigit(static_cast<unsigned char>(digit)) ? digit - '0' : (digit | 0x20) - 'a' + 10);
+                    }
+                    if (value >= 0x80)
+                        return false;
+                    out.push_back(static_cast<char>(value));
+                    _pos += 4;
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+
+            return false;
+        }
+
+        std::optional<value_t> parse_number() {
+            const auto begin = _pos;
+            if (_pos < _input.size() && _input[_pos] == '-')
+                ++_pos;
+
+            const auto digits = [&]() {
+                const auto first = _pos;
+                while (_pos < _input.size() && std::isdigit(static_cast<unsigned char>(_input[_pos])))
+                    ++_pos;
+                return _pos - first;
+            };
+
+            const auto integer_begin = _pos;
+            const auto integer_digits = digits();
+            if (integer_digits == 0 || (integer_digits > 1 && _input[integer_begin] == '0'))
+                return std::nullopt;
+
+            if (_pos < _input.size() && _input[_pos] == '.') {
+                ++_pos;
+                if (digits() == 0)
+                    return std::nullopt;
+            }
+
+            if (_pos < _input.size() && (_input[_pos] == 'e' || _input[_pos] == 'E')) {
+                ++_pos;
+                if (_pos < _input.size() && (_input[_pos] == '+' || _input[_pos] == '-'))
+                    ++_pos;
+                if (digits() == 0)
+                    return std::nullopt;
+            }
+
+            value_t result;
+            result.m_kind = value_t::kind_t::kNumber;
+            result.m_text = std::string(_input.substr(begin, _pos - begin));
+            return result;
+        }
+
+        std::string_view _input;
+        std::size_t _pos = 0;
+    };
+
+    constexpr std::size_t kFragmentTabs = 2 * codegen::kTabsPerBlock;
+
+    struct fragment_t {
+        std::string m_name;
+        std::string m_text;
+        const char* m_kind;
+    };
+
+    // @note: names and strings that trip up anything that looks for quotes, braces or commas without reading
+    // the strings, the key cache wants names that stay put
+    //
+    const std::vector<std::string> kNames = {
+        "C_BaseEntity",
+        "C_Quote\"Name",
+        "C_Back\\slash\\",
+        "C_Brace{Name}",
+        "C_Tricky\": {\"x\": [1, 2], },",
+        "C_Empty",
+        "C_EmptyMembers",
+        "E_Flags",
+        "E_Odd\"}\\{",
+        "C_Control\n\t\x01",
+    };
+
+    const std::vector<std::string> kStrings = {
+        "plain", "", "\"", "\\", "\\\"", "}", "{", "},", "],", "\": {", "a,}", "tab\there", "line\nbreak", "\x1f", "C:\\path\\", "/slash/",
+    };
+
+    fragment_t render_class(codegen::key_cache_t& key_cache, const std::string& name) {
+        auto builder = codegen::get();
+        builder.use_key_cache(&key_cache).inc_tabs_count(kFragmentTabs);
+
+        builder.json_key(name.c_str()).begin_json_object_value();
+        if (name == "C_EmptyMembers") {
+            builder.json_key("fields").begin_json_array_value().end_json_array();
+            builder.json_key("metadata").begin_json_object_value().end_json_object();
+        } else if (name != "C_Empty") {
+            builder.json_key("parent").json_string(name);
+            builder.json_key("size").json_literal(64);
+            builder.json_key("fields").begin_json_array_value();
+            for (std::size_t i = 0; i < kStrings.size(); ++i) {
+                builder.begin_json_object();
+                builder.json_key("name").json_string(kStrings[i]);
+                builder.json_key("offset").json_literal(i * 8);
+                builder.json_key("type").begin_json_object_value();
+                builder.json_key("name").json_string(std::format("CHandle< {} >", name));
+                builder.json_key("category").json_literal(-1);
+                builder.end_json_object();
+                builder.json_key("metadata").begin_json_array_value();
+                builder.json_string_element(kStrings[i]);
+                builder.json_string_element(kStrings[kStrings.size() - 1 - i]);
+                builder.end_json_array();
+                builder.end_json_object();
+            }
+            builder.end_json_array();
+        }
+        builder.end_json_object();
+
+        return {name, builder.str(), "class"};
+    }
+
+    fragment_t render_enum(codegen::key_cache_t& key_cache, const std::string& name) {
+        auto builder = codegen::get();
+        builder.use_key_cache(&key_cache).inc_tabs_count(kFragmentTabs);
+
+        builder.json_key(name.c_str()).begin_json_object_value();
+        builder.json_key("align").json_literal(4);
+        builder.json_key("items").begin_json_array_value();
+        for (std::size_t i = 0; i < kStrings.size(); ++i) {
+            builder.begin_json_object();
+            builder.json_key("name").json_string(kStrings[i]);
+            builder.json_key("value").json_literal(static_cast<std::int64_t>(i) - 3);
+            builder.end_json_object();
+        }
+        builder.end_json_array();
+        builder.end_json_object();
+
+        return {name, builder.str(), "enum"};
+    }
+
+    // @note: the record of a fragment is its scope, kind and name followed by exactly the members the fragment has
+    //
+    void check_record(const value_t& record, const std::string& scope, const fragment_t& fragment) {
+        CHECK(record.m_kind == value_t::kind_t::kObject);
+        CHECK(record.m_members.size() >= 3);
+        CHECK(record.m_members[0].first == "scope" && record.m_members[0].second.m_text == scope);
+        CHECK(record.m_members[1].first == "kind" && record.m_members[1].second.m_text == fragment.m_kind);
+        CHECK(record.m_members[2].first == "name" && record.m_members[2].second.m_text == fragment.m_name);
+
+        if (fragment.m_name == "C_Empty") {
+            CHECK(record.m_members.size() == 3);
+            return;
+        }
+
+        if (fragment.m_name == "C_EmptyMembers") {
+            CHECK(record.m_members.size() == 5);
+            CHECK(record.find("fields")->m_kind == value_t::kind_t::kArray && record.find("fields")->m_items.empty());
+            CHECK(record.find("metadata")->m_kind == value_t::kind_t::kObject && record.find("metadata")->m_members.empty());
+            return;
+        }
+
+        const auto items = record.find(std::string_view(fragment.m_kind) == "enum" ? "items" : "fields");
+        CHECK(items != nullptr && items->m_items.size() == kStrings.size());
+        for (std::size_t i = 0; i < kStrings.size(); ++i) {
+            const auto& item = items->m_items[i];
+            CHECK(item.find("name") != nullptr && item.find("name")->m_text == kStrings[i]);
+            if (std::string_view(fragment.m_kind) == "class") {
+                CHECK(item.find("offset")->m_text == std::to_string(i * 8));
+                CHECK(item.find("type")->find("name")->m_text == std::format("CHandle< {} >", fragment.m_name));
+                CHECK(item.find("metadata")->m_items.size() == 2);
+                CHECK(item.find("metadata")->m_items[1].m_text == kStrings[kStrings.size() - 1 - i]);
+            } else {
+                CHECK(item.find("value")->m_text == std::to_string(static_cast<std::int64_t>(i) - 3));
+            }
+        }
+
+        if (std::string_view(fragment.m_kind) == "class")
+            CHECK(record.find("parent")->m_text == fragment.m_name && record.find("size")->m_text == "64");
+    }
+
+    void test_strict_parser() {
+        CHECK(strict_parser_t::parse(R"({"a":[1,-2.5e3,"x\"y",true,null,{}]})").has_value());
+        CHECK(!strict_parser_t::parse(R"({"a":1,})").has_value());
+        CHECK(!strict_parser_t::parse(R"([1,])").has_value());
+        CHECK(!strict_parser_t::parse(R"({"a":1}{"b":2})").has_value());
+        CHECK(!strict_parser_t::parse(R"({"a":1,"a":2})").has_value());
+        CHECK(!strict_parser_t::parse("{\"a\":\"\n\"}").has_value());
+        CHECK(!strict_parser_t::parse(R"({"a":"\x"})").has_value());
+        CHECK(!strict_parser_t::parse(R"({"a":01})").has_value());
+    }
+
+    void test_records() {
+        // @note: the scope name goes through the same escaping as everything else
+        //
+        const std::string scope = "client\"\\{";
+        const auto scope_token = ndjson::make_string_token(scope);
+
+        codegen::key_cache_t key_cache;
+        std::vector<fragment_t> fragments;
+        for (const auto& name : kNames)
+            fragments.push_back(name.starts_with("E_") ? render_enum(key_cache, name) : render_class(key_cache, name));
+
+        std::string text;
+        for (const auto& fragment : fragments)
+            ndjson::append_record(text, scope_token, fragment.m_kind, fragment.m_name, fragment.m_text);
+
+        CHECK(!text.empty() && text.back() == '\n');
+        std::size_t line_begin = 0;
+        for (const auto& fragment : fragments) {
+            const auto line_end = text.find('\n', line_begin);
+            CHECK(line_end != std::string::npos);
+
+            const auto line = std::string_view(text).substr(line_begin, line_end - line_begin);
+            const auto record = strict_parser_t::parse(line);
+            if (!record)
+                std::fprintf(stderr, "not json: %.*s\n", static_cast<int>(line.size()), line.data());
+            CHECK(record.has_value());
+            check_record(*record, scope, fragment);
+
+            line_begin = line_end + 1;
+        }
+
+        CHECK(line_begin == text.size());
+    }
+
+    // @note: the compacting on its own, generator output in, strict json out
+    //
+    void test_append_compact_json() {
+        const auto compact = [](const std::string_view input) {
+            std::string result;
+            codegen::append_compact_json(result, input);
+            return result;
+        };
+
+        CHECK(compact("{\n  \"a\": 1,\n  \"b\": [\n    2,\n    3,\n  ],\n},") == R"({"a":1,"b":[2,3]})");
+        CHECK(compact("{\n},") == "{}");
+        CHECK(compact("[\n],") == "[]");
+        CHECK(compact(R"({ "a, }": "\" ,}", })") == R"({"a, }":"\" ,}"})");
+        CHECK(compact(R"({ "a\\": "b\\", })") == R"({"a\\":"b\\"})");
+    }
+} // namespace
+
+int main() {
+    test_strict_parser();
+    test_append_compact_json();
+    test_records();
+    return 0;
+}
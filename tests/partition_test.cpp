@@ -0,0 +1,201 @@
+#include "test.h"
+#include "tools/partition.h"
+#include <random>
+
+// Properties of partition::split on random graphs: every edge stays inside its partition or points to a lower,
+// listed partition, cycles share a partition, the weights and the critical path add up, and graphs with enough
+// independent work come out balanced.
+namespace {
+    // @note: `levels` layers of `width` nodes, each depending on up to `fan_out` nodes of lower layers, plus
+    // `back_edges` edges in random directions that close cycles
+    //
+    partition::graph_t make_graph(std::mt19937_64& random, const std::uint32_t levels, const std::uint32_t width, const std::uint32_t fan_out,
+                                  const std::uint32_t back_edges) {
+        partition::graph_t graph;
+        const auto node_count = levels * width;
+        graph.m_edges.resize(node_count);
+        for (std::uint32_t node = 0; node < node_count; ++node) {
+            graph.m_weights.push_back(1 + random() % 100);
+            if (node < width)
+                continue;
+
+            for (auto i = random() % (fan_out + 1); i > 0; --i)
+                graph.m_edges[node].push_back(static_cast<std::uint32_t>(random() % (node - node % width)));
+        }
+
+        for (std::uint32_t i = 0; i < back_edges && node_count > 0; ++i)
+            graph.m_edges[random() % node_count].push_back(static_cast<std::uint32_t>(random() % node_count));
+
+        return graph;
+    }
+
+    // @note: brute force, fine for the small graphs
+    //
+    std::vector<std::vector<bool>> get_reachability(const partition::graph_t& graph) {
+        const auto node_count = graph.m_edges.size();
+        std::vector<std::vector<bool>> result(node_count, std::vector<bool>(node_count, false));
+        for (std::size_t root = 0; root < node_count; ++root) {
+            std::vector<std::uint32_t> stack = {static_cast<std::uint32_t>(root)};
+            result[root][root] = true;
+            while (!stack.empty()) {
+                const auto node = stack.back();
+                stack.pop_back();
+                for (const auto next : graph.m_edges[node]) {
+                    if (!result[root][next]) {
+                        result[root][next] = true;
+                        stack.push_back(next);
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    void check_components(const partition::graph_t& graph) {
+        const auto components = partition::find_components(graph);
+        CHECK(components.m_component.size() == graph.m_edges.size());
+
+        for (std::uint32_t node = 0; node < graph.m_edges.size(); ++node) {
+            CHECK(components.m_component[node] < components.m_count);
+            for (const auto dependency : graph.m_edges[node])
+                CHECK(components.m_component[dependency] <= components.m_component[node]);
+        }
+
+        if (graph.m_edges.size() > 300)
+            return;
+
+        const auto reachable = get_reachability(graph);
+        for (std::uint32_t a = 0; a < graph.m_edges.size(); ++a) {
+            for (std::uint32_t b = 0; b < graph.m_edges.size(); ++b)
+                CHECK((components.m_component[a] == components.m_component[b]) == (reachable[a][b] && reachable[b][a]));
+        }
+    }
+
+    partition::result_t check_split(const partition::graph_t& graph, const std::uint32_t width) {
+        const auto result = partition::split(graph, width);
+        const auto partition_count = result.m_weights.size();
+        CHECK(result.m_partition.size() == graph.m_edges.size());
+        CHECK(result.m_dependencies.size() == partition_count);
+
+        std::vector<std::uint64_t> weights(partition_count, 0);
+        for (std::uint32_t node = 0; node < graph.m_edges.size(); ++node) {
+            const auto partition = result.m_partition[node];
+            CHECK(partition < partition_count);
+            weights[partition] += graph.m_weights[node];
+
+            for (const auto dependency : graph.m_edges[node]) {
+                const auto target = result.m_partition[dependency];
+                if (target == partition)
+                    continue;
+
+                const auto& dependencies = result.m_dependencies[partition];
+                CHECK(target < partition);
+                CHECK(std::binary_search(dependencies.begin(), dependencies.end(), target));
+            }
+        }
+
+        CHECK(weights == result.m_weights);
+
+        std::vector<std::uint64_t> finish(partition_count, 0);
+        std::uint64_t critical_path = 0;
+        for (std::uint32_t partition = 0; partition < partition_count; ++partition) {
+            const auto& dependencies = result.m_dependencies[partition];
+            CHECK(std::is_sorted(dependencies.begin(), dependencies.end()));
+            CHECK(std::adjacent_find(dependencies.begin(), dependencies.end()) == dependencies.end());
+
+            for (const auto dependency : dependencies) {
+                CHECK(dependency < partition);
+                finish[partition] = std::max(finish[partition], finish[dependency]);
+            }
+
+            finish[partition] += result.m_weights[partition];
+            critical_path = std::max(critical_path, finish[partition]);
+        }
+
+        CHECK(result.m_critical_path == critical_path);
+        CHECK(result.balance(width) >= 1.0 - 1e-9);
+        return result;
+    }
+
+    void test_random_graphs() {
+        std::mt19937_64 random(46);
+        for (std::uint32_t round = 0; round < 300; ++round) {
+            const auto levels = 1 + static_cast<std::uint32_t>(random() % 12);
+            const auto level_width = 1 + static_cast<std::uint32_t>(random() % 25);
+            const auto graph = make_graph(random, levels, level_width, static_cast<std::uint32_t>(random() % 4),
+                                          round % 3 == 0 ? static_cast<std::uint32_t>(random() % 10) : 0);
+
+            check_components(graph);
+            for (const auto width : {1u, 2u, 4u, 7u, 16u})
+                check_split(graph, width);
+        }
+    }
+
+    void test_cycles() {
+        // @note: a ring, a self loop and two nodes depending on each other below a node that depends on both
+        //
+        partition::graph_t graph;
+        graph.m_weights = {1, 1, 1, 1, 1, 1, 1, 1};
+        graph.m_edges = {{1}, {2}, {3}, {0}, {4}, {6}, {5}, {5, 6}};
+        check_components(graph);
+
+        const auto result = check_split(graph, 4);
+        CHECK(result.m_partition[0] == result.m_partition[1] && result.m_partition[1] == result.m_partition[2] && result.m_partition[2] == result.m_partition[3]);
+        CHECK(result.m_partition[5] == result.m_partition[6]);
+        CHECK(result.m_partition[7] != result.m_partition[5]);
+        CHECK(result.m_component_count == 4);
+    }
+
+    void test_degenerate_graphs() {
+        const auto empty = check_split({}, 4);
+        CHECK(empty.m_weights.empty() && empty.m_critical_path == 0 && empty.balance(4) == 1.0);
+
+        // @note: a chain can't be split, deep enough that a recursive search would run out of stack
+        //
+        partition::graph_t chain;
+        for (std::uint32_t node = 0; node < 200000; ++node) {
+            chain.m_weights.push_back(1);
+            chain.m_edges.push_back(node > 0 ? std::vector<std::uint32_t>{node - 1} : std::vector<std::uint32_t>{});
+        }
+
+        const auto result = check_split(chain, 8);
+        CHECK(result.m_critical_path == chain.m_weights.size());
+        CHECK(partition::split(chain, 0).m_critical_path == chain.m_weights.size());
+    }
+
+    // @note: with far more independent work per level than partitions, the critical path stays close to a perfect split
+    //
+    void test_balance() {
+        std::mt19937_64 random(47);
+
+        partition::graph_t independent;
+        for (auto i = 0; i < 5000; ++i) {
+            independent.m_weights.push_back(1 + random() % 100);
+            independent.m_edges.emplace_back();
+        }
+
+        for (const auto width : {2u, 4u, 8u, 16u}) {
+            const auto result = check_split(independent, width);
+            CHECK(result.m_weights.size() == width);
+            CHECK(result.m_wave_count == 1);
+            CHECK(result.balance(width) <= 1.01);
+        }
+
+        for (auto round = 0; round < 10; ++round) {
+            const auto layered = make_graph(random, 8, 400, 2, 0);
+            for (const auto width : {2u, 4u, 8u}) {
+                const auto result = check_split(layered, width);
+                CHECK(result.balance(width) <= partition::kMaxImbalance);
+            }
+        }
+    }
+} // namespace
+
+int main() {
+    test_random_graphs();
+    test_cycles();
+    test_degenerate_graphs();
+    test_balance();
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "synthetic_lookup.h"
+#include "synthetic_lookup.hpp"
+#include "test.h"
+#include <chrono>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+
+// Class and field lookups of a -lookup header against std::unordered_map. The header is synthetic_lookup.hpp, which
+// generate_lookup renders at build time through the same code as -lookup, so the lookups timed here are the ones
+// the generator emits. Fields are looked up within their class, against a map per class.
+namespace {
+    namespace lookup = schema_lookup::synthetic;
+
+    constexpr std::size_t kLookups = 4000000;
+    constexpr std::size_t kRounds = 3;
+
+    struct field_query_t {
+        std::uint32_t m_class_index = 0;
+        std::string_view m_name = {};
+    };
+
+    // @note: the best of a few rounds, in ns per lookup
+    //
+    template <typename Query, typename Fn>
+    double measure_ns(const std::vector<Query>& queries, Fn&& fn) {
+        auto result = 1e300;
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            std::uint64_t sink = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < kLookups; ++i)
+                sink += fn(queries[i % queries.size()]);
+            const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+            CHECK(sink != 0);
+            result = std::min(result, elapsed / kLookups);
+        }
+
+        return result;
+    }
+} // namespace
+
+int main() {
+    const auto scope = synthetic::make_lookup_scope();
+    CHECK(lookup::kClassCount == scope.m_classes.size());
+
+    const auto render_start = std::chrono::steady_clock::now();
+    const auto header = sdk::RenderLookupTables("synthetic", scope.m_classes, false);
+    const auto render_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - render_start).count();
+
+    std::mt19937_64 random(30);
+    std::vector<std::string> unknown_names;
+    for (std::size_t i = 0; i < synthetic::kLookupClassCount; ++i)
+        unknown_names.push_back(synthetic::make_class_name(random, "CUnknown_", i));
+
+    // @note: every class finds its own index and every field its own slot within it, unknown classes and the fields of
+    // the next class are rejected
+    //
+    std::unordered_map<std::string_view, std::uint32_t> class_map;
+    std::vector<std::unordered_map<std::string_view, std::uint32_t>> field_maps(lookup::kClassCount);
+    std::vector<bool> seen(lookup::kFieldCount, false);
+    std::size_t field_count = 0;
+
+    std::vector<std::uint32_t> class_indices;
+    for (const auto& lookup_class : scope.m_classes) {
+        const auto class_index = lookup::find_class(lookup_class.m_name);
+        CHECK(class_index < lookup::kClassCount && lookup::class_name(class_index) == lookup_class.m_name);
+        class_map.emplace(lookup_class.m_name, class_index);
+        class_indices.push_back(class_index);
+
+        for (const auto field : lookup_class.m_fields) {
+            const auto field_index = lookup::find_field(class_index, field);
+            CHECK(field_index < lookup::kFieldCount && lookup::field_name(field_index) == field && !seen[field_index]);
+            seen[field_index] = true;
+            field_maps[class_index].emplace(field, field_index);
+            ++field_count;
+        }
+    }
+    CHECK(field_count == lookup::kFieldCount);
+    for (const auto& name : unknown_names)
+        CHECK(lookup::find_class(name) == lookup::kNotFound);
+
+    // @note: mostly hits with some misses in between, in an order that doesn't follow the table
+    //
+    std::vector<std::string_view> class_queries;
+    std::vector<field_query_t> field_queries;
+    for (std::size_t i = 0; i < scope.m_classes.size(); ++i) {
+        class_queries.push_back(scope.m_classes[i].m_name);
+        if (i % 8 == 0)
+            class_queries.push_back(unknown_names[i % unknown_names.size()]);
+
+        const auto& fields = scope.m_classes[i].m_fields;
+        for (std::size_t j = 0; j < fields.size(); ++j) {
+            field_queries.push_back({class_indices[i], fields[j]});
+            if (j % 8 == 0 && i + 1 < scope.m_classes.size()) {
+                CHECK(lookup::find_field(class_indices[i + 1], fields[j]) == lookup::kNotFound);
+                field_queries.push_back({class_indices[i + 1], fields[j]});
+            }
+        }
+    }
+    std::shuffle(class_queries.begin(), class_queries.end(), random);
+    std::shuffle(field_queries.begin(), field_queries.end(), random);
+
+    const auto class_ns = measure_ns(class_queries, [](const std::string_view name) { return std::uint64_t{lookup::find_class(name)} + 1; });
+    const auto class_map_ns = measure_ns(class_queries, [&](const std::string_view name) {
+        const auto it = class_map.find(name);
+        return it != class_map.end() ? std::uint64_t{it->second} + 1 : 0x100000000ull;
+    });
+
+    const auto field_ns = measure_ns(field_queries, [](const field_query_t& query) { return std::uint64_t{lookup::find_field(query.m_class_index, query.m_name)} + 1; });
+    const auto field_map_ns = measure_ns(field_queries, [&](const field_query_t& query) {
+        const auto& map = field_maps[query.m_class_index];
+        const auto it = map.find(query.m_name);
+        return it != map.end() ? std::uint64_t{it->second} + 1 : 0x100000000ull;
+    });
+
+    std::printf("%u classes, %u fields, header rendered in %.1f ms (%zu bytes)\n", lookup::kClassCount, lookup::kFieldCount, render_ms, header.size());
+    std::printf("find_class:                    %.1f ns per lookup\n", class_ns);
+    std::printf("std::unordered_map:            %.1f ns per lookup\n", class_map_ns);
+    std::printf("find_field:                    %.1f ns per lookup\n", field_ns);
+    std::printf("std::unordered_map per class:  %.1f ns per lookup\n", field_map_ns);
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "synthetic_index.h"
+#include "test.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+// Field offset lookups through schema_index::view_t on a synthetic 20000 class schema, checked against the
+// classes the blob was built from, and compared with walking the classes and fields by name, which is what a
+// consumer without the index does.
+namespace {
+    constexpr std::size_t kClassCount = 20000;
+    constexpr std::size_t kLookups = 2000000;
+    constexpr std::size_t kWalkLookups = 2000;
+    constexpr std::size_t kReaderThreads = 8;
+
+    // @note: every class and field is found with its offset and size, from any number of threads at once
+    //
+    bool verify(const schema_index::view_t& view, const std::vector<synthetic::class_spec_t>& classes) {
+        for (const auto& class_spec : classes) {
+            const auto class_entry = view.find_class(fnv64::hash_runtime(class_spec.m_name.c_str()), class_spec.m_scope.c_str());
+            if (class_entry == nullptr || class_entry->size != class_spec.m_size || class_entry->field_count != class_spec.m_fields.size() ||
+                std::strcmp(view.string(class_entry->name), class_spec.m_name.c_str()) != 0)
+                return false;
+
+            for (const auto& field_spec : class_spec.m_fields) {
+                const auto field = view.find_field(class_entry, fnv64::hash_runtime(field_spec.m_name.c_str()));
+                if (field == nullptr || field->offset != field_spec.m_offset || field->size != field_spec.m_size ||
+                    ((field->flags & schema_index::kNetworked) != 0) != field_spec.m_networked)
+                    return false;
+            }
+
+            if (view.find_field(class_entry, fnv64::hash_runtime("m_missing")) != nullptr)
+                return false;
+        }
+
+        return view.find_class(fnv64::hash_runtime("C_Missing")) == nullptr &&
+               view.find_field_offset(fnv64::hash_runtime("C_Missing"), fnv64::hash_runtime("m_field0")) == schema_index::kNotFound;
+    }
+
+    std::int32_t walk(const std::vector<synthetic::class_spec_t>& classes, const char* class_name, const char* field_name) {
+        for (const auto& class_spec : classes) {
+            if (std::strcmp(class_spec.m_name.c_str(), class_name) != 0)
+                continue;
+
+            for (const auto& field_spec : class_spec.m_fields) {
+                if (std::strcmp(field_spec.m_name.c_str(), field_name) == 0)
+                    return field_spec.m_offset;
+            }
+        }
+
+        return schema_index::kNotFound;
+    }
+} // namespace
+
+int main() {
+    const auto classes = synthetic::make_classes(kClassCount, 34);
+    const auto blob = synthetic::build_index(classes);
+    const schema_index::view_t view(reinterpret_cast<const schema_index::header_t*>(blob.data()));
+    CHECK(view.valid());
+    CHECK(view.header()->class_count == kClassCount);
+
+    std::vector<std::thread> readers;
+    std::vector<char> results(kReaderThreads, 0);
+    for (std::size_t i = 0; i < kReaderThreads; ++i)
+        readers.emplace_back([&, i]() { results[i] = verify(view, classes); });
+    for (auto& reader : readers)
+        reader.join();
+    CHECK(std::all_of(results.begin(), results.end(), [](const char result) { return result != 0; }));
+
+    struct query_t {
+        const char* m_class_name;
+        const char* m_field_name;
+        std::uint64_t m_class_hash;
+        std::uint64_t m_field_hash;
+        std::int32_t m_offset;
+    };
+
+    std::mt19937_64 random(34);
+    std::vector<query_t> queries(4096);
+    for (auto& query : queries) {
+        const auto& class_spec = classes[random() % classes.size()];
+        const auto& field_spec = class_spec.m_fields[random() % class_spec.m_fields.size()];
+        query = {class_spec.m_name.c_str(), field_spec.m_name.c_str(), fnv64::hash_runtime(class_spec.m_name.c_str()),
+                 fnv64::hash_runtime(field_spec.m_name.c_str()), field_spec.m_offset};
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kLookups; ++i) {
+        const auto& query = queries[i % queries.size()];
+        CHECK(view.find_field_offset(query.m_class_hash, query.m_field_hash) == query.m_offset);
+    }
+    const auto index_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kLookups;
+
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kWalkLookups; ++i) {
+        const auto& query = queries[i % queries.size()];
+        CHECK(walk(classes, query.m_class_name, query.m_field_name) == query.m_offset);
+    }
+    const auto walk_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kWalkLookups;
+
+    std::printf("%zu classes, %u fields, %zu byte index\n", kClassCount, view.header()->field_count, blob.size());
+    std::printf("index lookup:    %.1f ns\n", index_ns);
+    std::printf("walk by name:    %.1f ns\n", walk_ns);
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "test.h"
+#include "tools/scope_watcher.h"
+#include <map>
+
+// scope_watcher::watcher_t driven by a stand-in schema system whose modules register their types over several
+// polls, get reloaded, unloaded and loaded again, the way the game does it while it starts.
+namespace {
+    struct binding_t {
+        std::uintptr_t m_address;
+        std::uint32_t m_size;
+    };
+
+    struct schema_system_t {
+        // @note: every registration gets a fresh address, like a binding allocated by a module
+        //
+        void add(const std::string& scope, const std::size_t classes, const std::size_t enums = 0) {
+            auto& module = m_scopes[scope];
+            for (std::size_t i = 0; i < classes; ++i)
+                module.m_classes.push_back({m_next_address += 64, static_cast<std::uint32_t>(8 + i % 7 * 8)});
+            for (std::size_t i = 0; i < enums; ++i)
+                module.m_enums.push_back({m_next_address += 64, static_cast<std::uint32_t>(i % 5)});
+        }
+
+        // @note: same types, new bindings
+        //
+        void reload(const std::string& scope) {
+            const auto module = m_scopes[scope];
+            m_scopes.erase(scope);
+            add(scope, module.m_classes.size(), module.m_enums.size());
+        }
+
+        void unload(const std::string& scope) {
+            m_scopes.erase(scope);
+        }
+
+        // @note: what watch.cpp computes from a snapshot
+        //
+        [[nodiscard]] std::vector<scope_watcher::scope_state_t> get_states() const {
+            std::vector<scope_watcher::scope_state_t> result;
+            for (const auto& [name, module] : m_scopes) {
+                scope_watcher::fingerprint_t fingerprint;
+                for (const auto& binding : module.m_classes)
+                    fingerprint.add(binding.m_address, binding.m_size);
+                for (const auto& binding : module.m_enums)
+                    fingerprint.add(binding.m_address, binding.m_size);
+
+                result.push_back({name, module.m_classes.size(), module.m_enums.size(), fingerprint.m_value});
+            }
+
+            return result;
+        }
+
+        struct module_t {
+            std::vector<binding_t> m_classes;
+            std::vector<binding_t> m_enums;
+        };
+
+        std::map<std::string, module_t> m_scopes;
+        std::uintptr_t m_next_address = 0x10000;
+    };
+
+    using names_t = std::vector<std::string>;
+
+    void test_modules_loading_over_time() {
+        schema_system_t schema_system;
+        scope_watcher::watcher_t watcher;
+
+        // @note: client registers its types over four polls, server shows up in the middle of that
+        //
+        std::vector<names_t> dirty;
+        for (auto poll = 0; poll < 10; ++poll) {
+            if (poll < 4)
+                schema_system.add("client", 100, 10);
+            if (poll == 2 || poll == 3)
+                schema_system.add("server", 50);
+
+            const auto changes = watcher.poll(schema_system.get_states());
+            CHECK(changes.m_removed.empty());
+            dirty.push_back(changes.m_dirty);
+        }
+
+        // @note: a scope is reported the first poll it looks the same as on the one before, and only once
+        //
+        const std::vector<names_t> expected = {{}, {}, {}, {}, {"client", "server"}, {}, {}, {}, {}, {}};
+        CHECK(dirty == expected);
+        CHECK(watcher.size() == 2);
+
+        // @note: a scope that loads late is reported on its own
+        //
+        schema_system.add("particles", 5);
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty == names_t{"particles"});
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+    }
+
+    void test_settle_polls() {
+        schema_system_t schema_system;
+        scope_watcher::watcher_t watcher(3);
+
+        schema_system.add("client", 10);
+        for (auto poll = 0; poll < 3; ++poll)
+            CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty == names_t{"client"});
+
+        // @note: a change in between starts the count over
+        //
+        schema_system.add("client", 1);
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+        schema_system.add("client", 1);
+        for (auto poll = 0; poll < 3; ++poll)
+            CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty == names_t{"client"});
+    }
+
+    void test_reload_and_unload() {
+        schema_system_t schema_system;
+        scope_watcher::watcher_t watcher;
+
+        schema_system.add("client", 20, 2);
+        schema_system.add("server", 20);
+        watcher.poll(schema_system.get_states());
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty == (names_t{"client", "server"}));
+
+        // @note: the same counts with new bindings are worth a dump
+        //
+        schema_system.reload("client");
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty == names_t{"client"});
+
+        schema_system.unload("server");
+        const auto changes = watcher.poll(schema_system.get_states());
+        CHECK(changes.m_removed == names_t{"server"});
+        CHECK(changes.m_dirty.empty());
+        CHECK(watcher.size() == 1);
+        CHECK(watcher.poll(schema_system.get_states()).m_removed.empty());
+
+        // @note: coming back is like loading for the first time
+        //
+        schema_system.add("server", 20);
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty == names_t{"server"});
+
+        // @note: a scope that never got reported isn't reported as removed either
+        //
+        schema_system.add("tools", 3);
+        watcher.poll(schema_system.get_states());
+        schema_system.unload("tools");
+        CHECK(watcher.poll(schema_system.get_states()).m_removed.empty());
+    }
+
+    void test_back_to_the_reported_state() {
+        scope_watcher::watcher_t watcher;
+        const scope_watcher::scope_state_t reported = {"client", 10, 1, 1234};
+        const scope_watcher::scope_state_t changed = {"client", 11, 1, 5678};
+
+        watcher.poll({reported});
+        CHECK(watcher.poll({reported}).m_dirty == names_t{"client"});
+        CHECK(watcher.poll({changed}).m_dirty.empty());
+        CHECK(watcher.poll({reported}).m_dirty.empty());
+        CHECK(watcher.poll({reported}).m_dirty.empty());
+    }
+
+    void test_retry() {
+        schema_system_t schema_system;
+        scope_watcher::watcher_t watcher;
+
+        schema_system.add("client", 10);
+        schema_system.add("server", 10);
+        watcher.poll(schema_system.get_states());
+        const auto dirty = watcher.poll(schema_system.get_states()).m_dirty;
+        CHECK(dirty == (names_t{"client", "server"}));
+
+        // @note: the dump failed, the scopes come back on the next poll. unknown names are ignored
+        //
+        watcher.retry({"server", "unknown"});
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty == names_t{"server"});
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+
+        // @note: if it changed meanwhile it waits to settle again
+        //
+        watcher.retry({"client"});
+        schema_system.add("client", 1);
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty.empty());
+        CHECK(watcher.poll(schema_system.get_states()).m_dirty == names_t{"client"});
+    }
+
+    void test_fingerprint() {
+        const auto fingerprint = [](const std::vector<binding_t>& bindings) {
+            scope_watcher::fingerprint_t result;
+            for (const auto& binding : bindings)
+                result.add(binding.m_address, binding.m_size);
+            return result.m_value;
+        };
+
+        // @note: independent of the order, but not of neighbouring addresses or sizes
+        //
+        CHECK(fingerprint({{0x1000, 8}, {0x1040, 16}, {0x1080, 24}}) == fingerprint({{0x1080, 24}, {0x1000, 8}, {0x1040, 16}}));
+        CHECK(fingerprint({{0x1000, 8}, {0x1040, 16}}) != fingerprint({{0x1040, 8}, {0x1000, 16}}));
+        CHECK(fingerprint({{0x1000, 8}, {0x1040, 16}}) != fingerprint({{0x1000, 8}, {0x1040, 24}}));
+        CHECK(fingerprint({{0x1000, 8}, {0x1040, 16}}) != fingerprint({{0x1000, 8}, {0x1080, 16}}));
+    }
+} // namespace
+
+int main() {
+    test_modules_loading_over_time();
+    test_settle_polls();
+    test_reload_and_unload();
+    test_back_to_the_reported_state();
+    test_retry();
+    test_fingerprint();
+    return 0;
+}
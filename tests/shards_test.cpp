@@ -0,0 +1,251 @@
+#include "sdk/shards.h"
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/dump_reader.h"
+#include <fstream>
+#include <set>
+
+// A synthetic scope written as shards in every -shards mode. Put together, the shards have to hold exactly the
+// definitions of the plain <scope>.json, byte for byte, each one once, and the manifest has to describe every
+// shard file correctly. A manifest left behind by an earlier run only gets to remove shards of its own scope.
+namespace {
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream f(path, std::ios::in | std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    }
+
+    void write_file(const std::filesystem::path& path, const std::string_view data) {
+        std::ofstream f(path, std::ios::out | std::ios::binary);
+        f.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    synthetic::scope_t make_scope() {
+        std::vector<synthetic::type_t> enums = synthetic::make_types("E_Synthetic", 40, 6);
+        std::vector<synthetic::type_t> classes;
+        for (const auto prefix : {"C_Base", "C_Weapon", "CNav", "Con", "CPhysics", "C_"}) {
+            const auto types = synthetic::make_types(prefix, 30, 12);
+            classes.insert(classes.end(), types.begin(), types.end());
+        }
+
+        return synthetic::make_scope("client", enums, classes);
+    }
+
+    // @note: class i holds class i / 2 by value, enums go to every seventh class, and two classes depend on each other
+    //
+    partition::graph_t make_graph(const sdk::rendered_scope_t& rendered) {
+        const auto enum_count = static_cast<std::uint32_t>(rendered.m_enums.size());
+        const auto class_count = static_cast<std::uint32_t>(rendered.m_classes.size());
+
+        partition::graph_t graph;
+        for (const auto& fragment : rendered.m_enums)
+            graph.m_weights.push_back(fragment.m_text.size());
+        for (const auto& fragment : rendered.m_classes)
+            graph.m_weights.push_back(fragment.m_text.size());
+        graph.m_edges.resize(graph.m_weights.size());
+
+        for (std::uint32_t i = 1; i < class_count; ++i) {
+            graph.m_edges[enum_count + i].push_back(enum_count + i / 2);
+            if (i % 7 == 0)
+                graph.m_edges[enum_count + i].push_back(i % enum_count);
+        }
+
+        graph.m_edges[enum_count + 20].push_back(enum_count + 21);
+        graph.m_edges[enum_count + 21].push_back(enum_count + 20);
+        return graph;
+    }
+
+    // @note: returns the shard of every type, by name
+    //
+    std::map<std::string, std::size_t> check_shards(const sdk::rendered_scope_t& rendered, const std::filesystem::path& dir, const bool with_partitions) {
+        write_file(dir / "whole.json", sdk::AssembleScopeJson(rendered));
+        const auto whole = dump_reader::dump_t::open(dir / "whole.json");
+        CHECK(whole.enums().size() == rendered.m_enums.size() && whole.classes().size() == rendered.m_classes.size());
+
+        const auto manifest_text = read_file(dir / "client.manifest.json");
+        const auto manifest = dump_reader::parser_t(manifest_text).parse();
+        CHECK(manifest.find("scope")->as_string() == "client");
+        CHECK((manifest.find("partitions") != nullptr) == with_partitions);
+
+        std::map<std::string, std::size_t> placement;
+        std::map<std::string, std::size_t> shard_of_file;
+        const auto& shards = manifest.find("shards")->items();
+        for (std::size_t i = 0; i < shards.size(); ++i) {
+            const auto& shard = shards[i];
+            const auto file = shard.find("file")->as_string();
+            CHECK(sdk::IsShardFile("client", file));
+            shard_of_file[file] = i;
+
+            const auto text = read_file(dir / file);
+            CHECK(static_cast<std::size_t>(shard.find("size")->as_int()) == text.size());
+            CHECK(shard.find("checksum")->as_string() == std::format("{:016x}", fnv64::hash_runtime_data(text.data(), text.size())));
+            (void)dump_reader::parser_t(text).parse();
+
+            // @note: every definition of the shard is the one of the plain json, and the manifest lists them in rendered order
+            //
+            const auto part = dump_reader::dump_t::open(dir / file);
+            const auto check_entries = [&](const std::vector<dump_reader::entry_t>& entries, const dump_reader::value_t& listed, const bool is_class) {
+                CHECK(entries.size() == listed.items().size());
+                const auto& fragments = is_class ? rendered.m_classes : rendered.m_enums;
+
+                std::size_t previous = 0;
+                for (std::size_t j = 0; j < listed.items().size(); ++j) {
+                    const auto name = listed.items()[j].as_string();
+                    const auto entry = is_class ? part.find_class(name) : part.find_enum(name);
+                    const auto expected = is_class ? whole.find_class(name) : whole.find_enum(name);
+                    CHECK(entry != nullptr && expected != nullptr);
+                    CHECK(part.text(*entry) == whole.text(*expected));
+                    CHECK(placement.emplace(name, i).second);
+
+                    const auto index = static_cast<std::size_t>(std::find_if(fragments.begin(), fragments.end(), [&](const auto& fragment) {
+                                                                    return name == fragment.m_name;
+                                                                }) - fragments.begin());
+                    CHECK(j == 0 || index > previous);
+                    previous = index;
+                }
+            };
+
+            check_entries(part.enums(), *shard.find("enums"), false);
+            check_entries(part.classes(), *shard.find("classes"), true);
+        }
+
+        CHECK(placement.size() == rendered.m_enums.size() + rendered.m_classes.size());
+
+        if (with_partitions) {
+            const auto& partitions = *manifest.find("partitions");
+            CHECK(static_cast<std::size_t>(partitions.find("count")->as_int()) == shards.size());
+
+            for (std::size_t i = 0; i < shards.size(); ++i) {
+                for (const auto& dependency : shards[i].find("dependencies")->items())
+                    CHECK(shard_of_file.at(dependency.as_string()) < i);
+            }
+        }
+
+        return placement;
+    }
+
+    void test_prefix(const synthetic::scope_t& scope, const std::filesystem::path& dir) {
+        auto shards = sdk::SplitByPrefix(scope.m_rendered, 3);
+        sdk::WriteShards(scope.m_rendered, shards, dir, nullptr, false, 4);
+        const auto placement = check_shards(scope.m_rendered, dir, false);
+
+        // @note: names are lowercased and device names get a suffix
+        //
+        CHECK(std::filesystem::exists(dir / "client" / "con_.json"));
+        CHECK(std::filesystem::exists(dir / "client" / "c_b.json"));
+        CHECK(placement.at("CNav3") == placement.at("CNav29"));
+        CHECK(placement.at("C_Base0") != placement.at("C_Weapon0"));
+    }
+
+    void test_size(const synthetic::scope_t& scope, const std::filesystem::path& dir) {
+        constexpr std::size_t kBudget = 8 * 1024;
+
+        auto shards = sdk::SplitBySize(scope.m_rendered, kBudget);
+        CHECK(shards.size() > 4);
+        for (const auto& shard : shards) {
+            std::size_t size = 0;
+            for (const auto fragment : shard.m_enums)
+                size += fragment->m_text.size();
+            for (const auto fragment : shard.m_classes)
+                size += fragment->m_text.size();
+            CHECK(size <= kBudget || shard.m_enums.size() + shard.m_classes.size() == 1);
+        }
+
+        sdk::WriteShards(scope.m_rendered, shards, dir, nullptr, true, 1);
+        check_shards(scope.m_rendered, dir, false);
+
+        // @note: the sidecar of every shard leads to its definitions
+        //
+        for (const auto& shard : shards) {
+            const auto path = dir / sdk::GetShardFile("client", shard);
+            CHECK(dump_reader::dump_t::open(path).uses_sidecar());
+        }
+    }
+
+    void test_dependencies(const synthetic::scope_t& scope, const std::filesystem::path& dir) {
+        const auto graph = make_graph(scope.m_rendered);
+
+        sdk::partition_stats_t stats;
+        auto shards = sdk::SplitByPartitions(scope.m_rendered, graph, 4, stats);
+        CHECK(stats.m_components == graph.m_edges.size() - 1);
+        CHECK(stats.m_balance >= 1.0);
+
+        sdk::WriteShards(scope.m_rendered, shards, dir, &stats, false, 4);
+        const auto placement = check_shards(scope.m_rendered, dir, true);
+
+        // @note: every type is in the shard of what it depends on or in a shard that lists that one
+        //
+        const auto name_of = [&](const std::size_t node) -> std::string {
+            return node < scope.m_rendered.m_enums.size() ? scope.m_rendered.m_enums[node].m_name : scope.m_rendered.m_classes[node - scope.m_rendered.m_enums.size()].m_name;
+        };
+
+        for (std::size_t node = 0; node < graph.m_edges.size(); ++node) {
+            const auto shard = placement.at(name_of(node));
+            for (const auto dependency : graph.m_edges[node]) {
+                const auto dependency_shard = placement.at(name_of(dependency));
+                const auto& listed = shards[shard].m_dependencies;
+                CHECK(dependency_shard == shard || std::find(listed.begin(), listed.end(), dependency_shard) != listed.end());
+            }
+        }
+
+        CHECK(placement.at(name_of(scope.m_rendered.m_enums.size() + 20)) == placement.at(name_of(scope.m_rendered.m_enums.size() + 21)));
+    }
+
+    // @note: an edited manifest naming files outside of <scope>/ doesn't get them removed, the shards it names do
+    //
+    void test_previous_manifest(const synthetic::scope_t& scope, const std::filesystem::path& dir) {
+        std::filesystem::create_directories(dir / "client");
+        std::filesystem::create_directories(dir / "server");
+
+        const std::vector<std::filesystem::path> kept = {dir.parent_path() / "source2gen_shards_outside.json", dir / "outside.json", dir / "server" / "0000.json",
+                                                         dir / "client" / "keep.txt"};
+        for (const auto& path : kept)
+            write_file(path, "{}");
+        write_file(dir / "client" / "stale.json", "{}");
+        write_file(dir / "client" / "stale.idx", "");
+
+        const auto absolute = kept[0].generic_string();
+        write_file(dir / "client.manifest.json", R"({"scope": "client", "shards": [
+            {"file": "../source2gen_shards_outside.json"}, {"file": "client/../outside.json"}, {"file": "client/../../source2gen_shards_outside.json"},
+            {"file": ")" + absolute + R"("}, {"file": "server/0000.json"}, {"file": "client/..\\outside.json"}, {"file": "client/keep.txt"},
+            {"file": "client/.json"}, {"file": "client/stale.json"}
+        ]})");
+
+        CHECK(!sdk::IsShardFile("client", "client/../outside.json"));
+        CHECK(!sdk::IsShardFile("client", "client/sub/0000.json"));
+        CHECK(!sdk::IsShardFile("client", "client/C:0000.json"));
+        CHECK(!sdk::IsShardFile("client", "clientx/0000.json"));
+        CHECK(!sdk::IsShardFile("client", "client/.json"));
+        CHECK(sdk::IsShardFile("client", "client/0000.json"));
+
+        auto shards = sdk::SplitBySize(scope.m_rendered, 64 * 1024);
+        sdk::WriteShards(scope.m_rendered, shards, dir, nullptr, false, 1);
+
+        for (const auto& path : kept)
+            CHECK(std::filesystem::exists(path));
+        CHECK(!std::filesystem::exists(dir / "client" / "stale.json"));
+        CHECK(!std::filesystem::exists(dir / "client" / "stale.idx"));
+        check_shards(scope.m_rendered, dir, false);
+
+        std::filesystem::remove(kept[0]);
+    }
+} // namespace
+
+int main() {
+    const auto scope = make_scope();
+
+    for (const auto mode : {"prefix", "size", "deps", "manifest"}) {
+        const auto dir = test::temp_dir(std::format("shards_{}", mode));
+        if (std::string_view(mode) == "prefix")
+            test_prefix(scope, dir);
+        else if (std::string_view(mode) == "size")
+            test_size(scope, dir);
+        else if (std::string_view(mode) == "deps")
+            test_dependencies(scope, dir);
+        else
+            test_previous_manifest(scope, dir);
+
+        std::filesystem::remove_all(dir);
+    }
+
+    return 0;
+}
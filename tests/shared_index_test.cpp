@@ -0,0 +1,253 @@
+#include "sdk/shared_index.h"
+#include "synthetic_index.h"
+#include "test.h"
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// One writer publishing generation after generation while readers look fields up in whatever is live, plus the
+// segments a writer can leave behind: one that died inside publish(), one asking for other slots and a corrupt index.
+namespace {
+    constexpr std::size_t kReaderThreads = 4;
+    constexpr std::size_t kGenerations = 300;
+
+    struct published_t {
+        std::vector<synthetic::class_spec_t> m_classes;
+        std::vector<std::uint8_t> m_blob;
+    };
+
+    published_t make_published(const std::size_t class_count, const std::uint64_t seed) {
+        published_t result;
+        result.m_classes = synthetic::make_classes(class_count, seed);
+        result.m_blob = synthetic::build_index(result.m_classes);
+        return result;
+    }
+
+    std::string get_segment_name(const char* test) {
+        return std::format("/source2gen_shared_index_{}_{}", test, getpid());
+    }
+
+    // @note: the header of an existing segment, to break it the way a crashed writer would
+    //
+    shared_index::segment_header_t* get_raw_header(shared_memory::mapping_t& raw) {
+        return static_cast<shared_index::segment_header_t*>(raw.data());
+    }
+
+    // @note: the index seen is exactly one of the published ones, with every field where it was published
+    //
+    bool verify(const schema_index::view_t& view, const std::vector<const published_t*>& published) {
+        for (const auto candidate : published) {
+            if (view.header()->class_count != candidate->m_classes.size())
+                continue;
+
+            for (const auto& class_spec : candidate->m_classes) {
+                const auto class_entry = view.find_class(fnv64::hash_runtime(class_spec.m_name.c_str()), class_spec.m_scope.c_str());
+                if (class_entry == nullptr || class_entry->size != class_spec.m_size)
+                    return false;
+
+                for (const auto& field_spec : class_spec.m_fields) {
+                    const auto field = view.find_field(class_entry, fnv64::hash_runtime(field_spec.m_name.c_str()));
+                    if (field == nullptr || field->offset != field_spec.m_offset || field->size != field_spec.m_size)
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void test_concurrent_readers() {
+        const auto name = get_segment_name("concurrent");
+        shared_memory::mapping_t::remove(name);
+
+        const auto first = make_published(1500, 1);
+        const auto second = make_published(2500, 2);
+        const std::vector<const published_t*> published = {&first, &second};
+
+        shared_index::writer_t writer(name, std::max(first.m_blob.size(), second.m_blob.size()));
+        CHECK(writer.publish(first.m_blob) == 1);
+
+        std::atomic<bool> stop = false;
+        std::vector<std::thread> readers;
+        std::vector<std::size_t> reads(kReaderThreads, 0);
+        std::vector<char> failed(kReaderThreads, 0);
+        for (std::size_t i = 0; i < kReaderThreads; ++i) {
+            readers.emplace_back([&, i]() {
+                shared_index::reader_t reader(name);
+                std::uint64_t last_generation = 0;
+                while (!stop.load() || reads[i] == 0) {
+                    const auto generation = reader.generation();
+                    const auto result = reader.read([&](const schema_index::view_t& view) { return verify(view, published); });
+                    if (!result.has_value() || !*result || generation < last_generation)
+                        failed[i] = 1;
+
+                    last_generation = generation;
+                    ++reads[i];
+                }
+            });
+        }
+
+        for (std::size_t generation = 2; generation <= kGenerations; ++generation)
+            CHECK(writer.publish(generation % 2 == 0 ? second.m_blob : first.m_blob) == generation);
+
+        stop = true;
+        for (auto& reader : readers)
+            reader.join();
+
+        for (std::size_t i = 0; i < kReaderThreads; ++i) {
+            CHECK(failed[i] == 0);
+            CHECK(reads[i] > 0);
+        }
+
+        shared_memory::mapping_t::remove(name);
+    }
+
+    void test_missing_segment() {
+        const auto name = get_segment_name("missing");
+        shared_memory::mapping_t::remove(name);
+
+        shared_index::reader_t reader(name);
+        CHECK(reader.generation() == 0);
+        CHECK(!reader.read([](const schema_index::view_t&) { return 0; }).has_value());
+
+        // @note: a segment without an index yet
+        //
+        shared_index::writer_t writer(name, 1 << 16);
+        CHECK(reader.generation() == 0);
+        CHECK(!reader.read([](const schema_index::view_t&) { return 0; }).has_value());
+
+        const auto published = make_published(10, 3);
+        CHECK(writer.slot_capacity() >= published.m_blob.size());
+        writer.publish(published.m_blob);
+        CHECK(reader.read([&](const schema_index::view_t& view) { return verify(view, {&published}); }) == true);
+
+        shared_memory::mapping_t::remove(name);
+    }
+
+    void test_dead_writer() {
+        const auto name = get_segment_name("dead_writer");
+        shared_memory::mapping_t::remove(name);
+
+        const auto first = make_published(100, 4);
+        const auto second = make_published(200, 5);
+        const auto check = [&](shared_index::reader_t& reader, const published_t& expected) {
+            return reader.read([&](const schema_index::view_t& view) { return verify(view, {&expected}); }) == true;
+        };
+
+        shared_index::reader_t old_reader(name);
+        {
+            shared_index::writer_t writer(name, 1 << 20);
+            writer.publish(first.m_blob);
+            CHECK(check(old_reader, first));
+        }
+
+        // @note: both slots stuck in the middle of a write, as if writers died in publish() twice
+        //
+        auto raw = shared_memory::mapping_t::create(name, 0);
+        for (auto& sequence : get_raw_header(raw)->sequence)
+            sequence.store(sequence.load() | 1);
+
+        // @note: a reader gives up instead of spinning forever, one with a copy keeps using it
+        //
+        shared_index::reader_t new_reader(name);
+        const auto start = std::chrono::steady_clock::now();
+        CHECK(!new_reader.read([](const schema_index::view_t&) { return 0; }).has_value());
+        CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+        CHECK(check(old_reader, first));
+
+        // @note: the next writer evens the slots out and keeps the generation going
+        //
+        shared_index::writer_t writer(name, 1 << 20);
+        for (const auto& sequence : get_raw_header(raw)->sequence)
+            CHECK((sequence.load() & 1) == 0);
+
+        CHECK(check(new_reader, first));
+        CHECK(writer.publish(second.m_blob) == 2);
+        CHECK(check(new_reader, second));
+        CHECK(check(old_reader, second));
+
+        shared_memory::mapping_t::remove(name);
+    }
+
+    void test_no_resize() {
+        const auto name = get_segment_name("no_resize");
+        shared_memory::mapping_t::remove(name);
+
+        const auto small = make_published(50, 6);
+        const auto big = make_published(500, 7);
+        CHECK(big.m_blob.size() > small.m_blob.size() * 2);
+
+        shared_index::writer_t writer(name, small.m_blob.size() * 2);
+        writer.publish(small.m_blob);
+
+        shared_index::reader_t reader(name);
+        CHECK(reader.read([&](const schema_index::view_t& view) { return verify(view, {&small}); }) == true);
+        const auto segment_size = shared_memory::mapping_t::open(name).size();
+
+        // @note: a restarted writer asking for bigger slots gets the ones that exist
+        //
+        shared_index::writer_t restarted(name, big.m_blob.size() * 2);
+        CHECK(restarted.slot_capacity() == small.m_blob.size() * 2);
+        CHECK(shared_memory::mapping_t::open(name).size() == segment_size);
+        CHECK_THROWS(restarted.publish(big.m_blob));
+
+        restarted.publish(small.m_blob);
+        CHECK(reader.read([&](const schema_index::view_t& view) { return verify(view, {&small}); }) == true);
+        shared_memory::mapping_t::remove(name);
+
+        // @note: a segment that isn't one of ours is too small for the slots and can't be resized
+        //
+        const auto foreign = shared_memory::mapping_t::create(name, shared_index::kSlotsOffset + 64);
+        CHECK_THROWS(shared_index::writer_t(name, 4096));
+        shared_memory::mapping_t::remove(name);
+    }
+
+    void test_corrupt_index() {
+        const auto name = get_segment_name("corrupt");
+        shared_memory::mapping_t::remove(name);
+
+        const auto published = make_published(20, 8);
+        shared_index::writer_t writer(name, 1 << 20);
+        const auto read_fails = [&](const std::vector<std::uint8_t>& blob) {
+            writer.publish(blob);
+            shared_index::reader_t reader(name);
+            return !reader.read([](const schema_index::view_t&) { return 0; }).has_value();
+        };
+
+        CHECK(!read_fails(published.m_blob));
+
+        auto truncated = published.m_blob;
+        truncated.resize(truncated.size() - 1);
+        CHECK(read_fails(truncated));
+
+        auto unterminated = published.m_blob;
+        unterminated.back() = 'x';
+        CHECK(read_fails(unterminated));
+
+        auto bad_fields = published.m_blob;
+        reinterpret_cast<schema_index::class_t*>(bad_fields.data() + sizeof(schema_index::header_t))->field_count = 0xFFFF;
+        CHECK(read_fails(bad_fields));
+
+        auto bad_string = published.m_blob;
+        reinterpret_cast<schema_index::class_t*>(bad_string.data() + sizeof(schema_index::header_t))->scope = schema_index::kNoString;
+        CHECK(read_fails(bad_string));
+
+        auto bad_base = published.m_blob;
+        reinterpret_cast<schema_index::class_t*>(bad_base.data() + sizeof(schema_index::header_t))->base_class = 20;
+        CHECK(read_fails(bad_base));
+
+        shared_memory::mapping_t::remove(name);
+    }
+} // namespace
+
+int main() {
+    test_concurrent_readers();
+    test_missing_segment();
+    test_dead_writer();
+    test_no_resize();
+    test_corrupt_index();
+    return 0;
+}
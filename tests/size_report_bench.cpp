@@ -0,0 +1,78 @@
+#include "sdk/size_report.h"
+#include "synthetic_scope.h"
+#include "test.h"
+#include <chrono>
+
+// Rendering a synthetic scope with and without a size report, to show what leaving -sizes on costs: measuring every
+// field type and metadata entry, the per fragment totals and the report itself. Both have to render the same json.
+namespace {
+    constexpr std::size_t kClassCount = 4000;
+    constexpr std::size_t kEnumCount = 1000;
+    constexpr std::size_t kRounds = 5;
+
+    struct result_t {
+        double m_ms = 1e300;
+        std::size_t m_size = 0;
+        std::size_t m_report_size = 0;
+    };
+
+    // @note: one round, a new key cache and report like every scope gets them
+    //
+    void render(const std::vector<synthetic::type_t>& enums, const std::vector<synthetic::type_t>& classes, const bool use_report, result_t& result) {
+        codegen::key_cache_t key_cache;
+        sdk::size_report_t report;
+        const auto report_ptr = use_report ? &report : nullptr;
+
+        const auto start = std::chrono::steady_clock::now();
+        sdk::rendered_scope_t rendered;
+        rendered.m_name = "client";
+        for (const auto& type : enums)
+            rendered.m_enums.push_back({type.m_name.c_str(), synthetic::render_enum(&key_cache, type.m_name.c_str(), type.m_members)});
+        for (const auto& type : classes)
+            rendered.m_classes.push_back({type.m_name.c_str(), synthetic::render_class(&key_cache, type.m_name.c_str(), type.m_members, 0, report_ptr)});
+
+        std::size_t report_size = 0;
+        if (report_ptr != nullptr) {
+            sdk::AddFragmentSizes(*report_ptr, rendered);
+            report_size = sdk::RenderSizeReport(*report_ptr).size();
+        }
+        const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::size_t size = 0;
+        for (const auto& fragment : rendered.m_enums)
+            size += fragment.m_text.size();
+        for (const auto& fragment : rendered.m_classes)
+            size += fragment.m_text.size();
+
+        CHECK(report_ptr == nullptr || report.m_total_size == size);
+        result.m_ms = std::min(result.m_ms, ms);
+        result.m_size = size;
+        result.m_report_size = report_size;
+    }
+} // namespace
+
+int main() {
+    const auto enums = synthetic::make_types("E_Synthetic", kEnumCount, 16);
+    const auto classes = synthetic::make_types("C_Synthetic", kClassCount, 40);
+
+    for (const auto& type : classes) {
+        sdk::size_report_t report;
+        CHECK(synthetic::render_class(nullptr, type.m_name.c_str(), type.m_members, 0, &report) ==
+              synthetic::render_class(nullptr, type.m_name.c_str(), type.m_members));
+    }
+
+    // @note: the best of a few rounds, taking turns so both see the same state of the machine
+    //
+    result_t plain, measured;
+    for (std::size_t round = 0; round < kRounds; ++round) {
+        render(enums, classes, false, plain);
+        render(enums, classes, true, measured);
+    }
+    CHECK(plain.m_size == measured.m_size && measured.m_report_size > 0);
+
+    std::printf("%zu enums, %zu classes, %zu bytes of json\n", enums.size(), classes.size(), plain.m_size);
+    std::printf("without size report: %.1f ms\n", plain.m_ms);
+    std::printf("with size report:    %.1f ms (%+.1f%%), %zu bytes of report\n", measured.m_ms, 100.0 * (measured.m_ms - plain.m_ms) / plain.m_ms,
+                measured.m_report_size);
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "sdk/size_report.h"
+#include "synthetic_scope.h"
+#include "test.h"
+#include "tools/dump_reader.h"
+#include <cmath>
+
+// -sizes on a synthetic scope: the classes and enums add up to m_total_size, which is every byte the fragments take in
+// the assembled json, the field types and metadata count what was written for them, and the report carries the
+// same numbers.
+namespace {
+    struct measured_scope_t {
+        synthetic::scope_t m_scope = {};
+        sdk::size_report_t m_report = {};
+    };
+
+    // @note: like RenderTypeScope with a size report, classes measure their field types and metadata
+    //
+    measured_scope_t render(const std::size_t enum_count, const std::size_t class_count) {
+        measured_scope_t result;
+        result.m_scope = synthetic::make_scope("client", synthetic::make_types("E_Synthetic", enum_count, 8), {});
+
+        codegen::key_cache_t key_cache;
+        for (const auto& type : synthetic::make_types("C_Synthetic", class_count, 12)) {
+            const auto& name = *result.m_scope.m_names.emplace_back(std::make_unique<std::string>(type.m_name));
+            auto text = synthetic::render_class(&key_cache, name.c_str(), type.m_members, 0, &result.m_report);
+            result.m_scope.m_rendered.m_classes.push_back({name.c_str(), std::move(text)});
+        }
+
+        sdk::AddFragmentSizes(result.m_report, result.m_scope.m_rendered);
+        return result;
+    }
+
+    void test_totals() {
+        const auto [scope, report] = render(30, 200);
+        const auto& rendered = scope.m_rendered;
+        CHECK(report.m_name == "client");
+
+        std::size_t sum = 0;
+        CHECK(report.m_classes.size() == rendered.m_classes.size());
+        for (std::size_t i = 0; i < report.m_classes.size(); ++i) {
+            CHECK(report.m_classes[i].m_name == rendered.m_classes[i].m_name && report.m_classes[i].m_count == 1);
+            CHECK(report.m_classes[i].m_bytes == rendered.m_classes[i].m_text.size());
+            sum += report.m_classes[i].m_bytes;
+        }
+
+        CHECK(report.m_enums.size() == rendered.m_enums.size());
+        for (std::size_t i = 0; i < report.m_enums.size(); ++i) {
+            CHECK(report.m_enums[i].m_bytes == rendered.m_enums[i].m_text.size());
+            sum += report.m_enums[i].m_bytes;
+        }
+        CHECK(sum == report.m_total_size);
+
+        // @note: the fragments are the whole json but for the braces around them
+        //
+        const auto json = sdk::AssembleScopeJson(rendered);
+        const auto skeleton = sdk::AssembleScopeJson(sdk::rendered_scope_t{});
+        CHECK(json.size() == skeleton.size() + report.m_total_size);
+    }
+
+    // @note: every field writes one type and one metadata entry, the same type renders to the same bytes every time
+    //
+    void test_members() {
+        const auto [scope, report] = render(0, 50);
+
+        std::size_t field_count = 0, handle_count = 0;
+        for (std::size_t i = 0; i < 50; ++i) {
+            const auto fields = i % 13;
+            field_count += fields;
+            handle_count += (fields + 2) / 3;
+        }
+
+        CHECK(report.m_metadata.size() == 1 && report.m_field_types.size() == 2);
+        const auto& metadata = report.m_metadata.at(whash64::hash_runtime("MPropertyDescription"));
+        const auto& handles = report.m_field_types.at(whash64::hash_runtime("CHandle< C_BaseEntity >"));
+        const auto& ints = report.m_field_types.at(whash64::hash_runtime("int32"));
+        CHECK(metadata.m_count == field_count && handles.m_count == handle_count && ints.m_count == field_count - handle_count);
+        CHECK(std::string_view(handles.m_name) == "CHandle< C_BaseEntity >" && std::string_view(ints.m_name) == "int32");
+
+        // @note: what each type takes in the json, from the value of "type" to the end of its line
+        //
+        const auto get_type_bytes = [&](const std::string_view type_name) {
+            const auto& text = scope.m_rendered.m_classes[12].m_text;
+            const auto name = text.find(std::format("\"{}\"", type_name));
+            const auto begin = text.rfind("\"type\": ", name) + 8;
+            return text.find('\n', text.find('}', name)) + 1 - begin;
+        };
+        CHECK(handles.m_bytes == handles.m_count * get_type_bytes("CHandle< C_BaseEntity >"));
+        CHECK(ints.m_bytes == ints.m_count * get_type_bytes("int32"));
+
+        std::size_t class_bytes = 0;
+        for (const auto& entry : report.m_classes)
+            class_bytes += entry.m_bytes;
+        CHECK(metadata.m_bytes + handles.m_bytes + ints.m_bytes < class_bytes);
+    }
+
+    void test_report() {
+        const auto [scope, report] = render(30, 200);
+        const auto text = sdk::RenderSizeReport(report);
+        const auto root = dump_reader::parser_t(text).parse();
+
+        CHECK(root.find("scope")->as_string() == "client");
+        CHECK(static_cast<std::size_t>(root.find("totalSize")->as_int()) == report.m_total_size);
+
+        const auto classes = root.find("classes");
+        const auto enums = root.find("enums");
+        CHECK(static_cast<std::size_t>(classes->find("count")->as_int()) == 200 && static_cast<std::size_t>(enums->find("count")->as_int()) == 30);
+        CHECK(static_cast<std::size_t>(classes->find("bytes")->as_int() + enums->find("bytes")->as_int()) == report.m_total_size);
+        CHECK(std::abs(classes->find("percent")->as_double() + enums->find("percent")->as_double() - 100.0) < 0.011);
+
+        // @note: the biggest first, at most 20
+        //
+        const auto& top = classes->find("top")->items();
+        CHECK(top.size() == 20);
+        for (std::size_t i = 1; i < top.size(); ++i)
+            CHECK(top[i - 1].find("bytes")->as_int() >= top[i].find("bytes")->as_int());
+
+        const auto& field_types = root.find("fieldTypes")->find("top")->items();
+        CHECK(field_types.size() == 2 && field_types[0].find("count")->as_int() + field_types[1].find("count")->as_int() > 0);
+    }
+} // namespace
+
+int main() {
+    test_totals();
+    test_members();
+    test_report();
+    return 0;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "sdk/schema_index.h"
+#include "tools/binary_writer.h"
+
+// Synthetic schema index blobs, laid out the way BuildSchemaIndex lays out the real one: classes sorted by name
+// hash, each with its own run of fields sorted by name hash. Base classes aren't modelled, their fields would
+// just be more fields in the run.
+namespace synthetic {
+    struct field_spec_t {
+        std::string m_name = "";
+        std::int32_t m_offset = 0;
+        std::int32_t m_size = 0;
+        bool m_networked = false;
+    };
+
+    struct class_spec_t {
+        std::string m_name = "";
+        std::string m_scope = "";
+        std::int32_t m_size = 0;
+        std::vector<field_spec_t> m_fields = {};
+    };
+
+    // @note: `count` classes of 8 to 40 fields of 1 to 16 bytes, the same for the same seed
+    //
+    inline std::vector<class_spec_t> make_classes(const std::size_t count, const std::uint64_t seed) {
+        constexpr std::int32_t sizes[] = {1, 2, 4, 4, 4, 8, 12, 16};
+        std::mt19937_64 random(seed);
+
+        std::vector<class_spec_t> result(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto& class_spec = result[i];
+            class_spec.m_name = "C_SyntheticClass" + std::to_string(i);
+            class_spec.m_scope = i % 3 == 0 ? "client" : "server";
+
+            std::int32_t offset = 8;
+            for (auto j = 0u, field_count = 8 + static_cast<std::uint32_t>(random() % 33); j < field_count; ++j) {
+                const auto size = sizes[random() % std::size(sizes)];
+                offset = (offset + size - 1) / size * size;
+                class_spec.m_fields.push_back({"m_field" + std::to_string(j), offset, size, random() % 2 == 0});
+                offset += size;
+            }
+
+            class_spec.m_size = (offset + 7) / 8 * 8;
+        }
+
+        return result;
+    }
+
+    inline std::vector<std::uint8_t> build_index(const std::vector<class_spec_t>& classes) {
+        binary::string_table_t strings;
+
+        std::vector<const class_spec_t*> sorted;
+        for (const auto& class_spec : classes)
+            sorted.push_back(&class_spec);
+        std::stable_sort(sorted.begin(), sorted.end(), [](const class_spec_t* a, const class_spec_t* b) {
+            return fnv64::hash_runtime(a->m_name.c_str()) < fnv64::hash_runtime(b->m_name.c_str());
+        });
+
+        std::vector<schema_index::class_t> class_entries;
+        std::vector<schema_index::field_t> fields;
+        for (const auto class_spec : sorted) {
+            schema_index::class_t entry = {};
+            entry.hash = fnv64::hash_runtime(class_spec->m_name.c_str());
+            entry.name = strings.add(class_spec->m_name);
+            entry.scope = strings.add(class_spec->m_scope);
+            entry.size = class_spec->m_size;
+            entry.base_class = schema_index::kNoClass;
+            entry.first_field = static_cast<std::uint32_t>(fields.size());
+
+            for (const auto& field_spec : class_spec->m_fields) {
+                schema_index::field_t field = {};
+                field.hash = fnv64::hash_runtime(field_spec.m_name.c_str());
+                field.name = strings.add(field_spec.m_name);
+                field.type_name = strings.add("int32");
+                field.offset = field_spec.m_offset;
+                field.size = field_spec.m_size;
+                field.encoder = schema_index::kNoString;
+                field.flags = field_spec.m_networked ? schema_index::kNetworked : 0;
+                fields.push_back(field);
+            }
+
+            entry.field_count = static_cast<std::uint32_t>(fields.size()) - entry.first_field;
+            std::sort(fields.begin() + entry.first_field, fields.end(), [](const schema_index::field_t& a, const schema_index::field_t& b) { return a.hash < b.hash; });
+            class_entries.push_back(entry);
+        }
+
+        schema_index::header_t header = {};
+        header.magic = schema_index::kMagic;
+        header.version = schema_index::kVersion;
+        header.class_count = static_cast<std::uint32_t>(class_entries.size());
+        header.field_count = static_cast<std::uint32_t>(fields.size());
+        header.strings_size = static_cast<std::uint32_t>(strings.data().size());
+
+        binary::writer_t writer;
+        writer.write(header).write_array(class_entries).write_array(fields);
+        writer.write_bytes(strings.data().data(), strings.data().size());
+        return writer.data();
+    }
+} // namespace synthetic
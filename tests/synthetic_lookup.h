@@ -0,0 +1,65 @@
+#pragma once
+#include <array>
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "sdk/lookup_tables.h"
+
+// The synthetic scope generate_lookup renders into synthetic_lookup.hpp at build time: classes shaped like schema
+// classes with up to kMaxFields fields each, and a class whose name and field names need escaping in a C++ string
+// literal. Tests compile the generated header, so they check what the generator actually emits.
+namespace synthetic {
+    constexpr std::size_t kLookupClassCount = 5000;
+    constexpr std::size_t kMaxFields = 24;
+
+    // @note: quotes, backslashes, control characters followed by digits an escape could swallow, and utf-8. schema
+    // names are null terminated, so there is no null among them
+    //
+    inline std::vector<std::string> get_escaped_names() {
+        return {"C_\"Quoted\"", "C_Back\\slash", "C_Line\nBreak1", std::string("C_\x01" "7\x7f" "7", 6), "C_Tab\t0", "C_\xc3\xbc" "tf8"};
+    }
+
+    struct lookup_scope_t {
+        std::vector<std::unique_ptr<std::string>> m_names = {};
+        std::vector<sdk::lookup_class_t> m_classes = {};
+    };
+
+    // @note: `<prefix><Part...><i>_t`, the same names for the same `random`
+    //
+    inline std::string make_class_name(std::mt19937_64& random, const std::string_view prefix, const std::size_t i) {
+        constexpr std::array<const char*, 12> parts = {"Base", "Player", "Pawn", "Weapon", "Controller", "Entity", "Model", "Physics", "Game", "Rules", "Item", "Component"};
+
+        auto name = std::string(prefix);
+        for (auto j = random() % 3 + 1; j != 0; --j)
+            name += parts[random() % parts.size()];
+
+        return std::format("{}{}_t", name, i);
+    }
+
+    inline lookup_scope_t make_lookup_scope() {
+        constexpr std::array<const char*, 8> field_parts = {"m_n", "m_fl", "m_h", "m_b", "m_vec", "m_psz", "m_ang", "m_i"};
+        constexpr std::array<const char*, 8> field_names = {"Health", "Owner", "Origin", "Flags", "Team", "Speed", "Model", "Angles"};
+
+        lookup_scope_t result;
+        const auto add_name = [&](std::string name) -> std::string_view { return *result.m_names.emplace_back(std::make_unique<std::string>(std::move(name))); };
+
+        std::mt19937_64 random(29);
+        for (std::size_t i = 0; i < kLookupClassCount; ++i) {
+            auto& lookup_class = result.m_classes.emplace_back();
+            lookup_class.m_name = add_name(make_class_name(random, "C_", i));
+            for (std::size_t j = 0; j < i % (kMaxFields + 1); ++j)
+                lookup_class.m_fields.push_back(add_name(std::format("{}{}{}", field_parts[j % field_parts.size()], field_names[(i + j) % field_names.size()], j)));
+        }
+
+        auto& escaped = result.m_classes.emplace_back();
+        for (const auto& name : get_escaped_names()) {
+            if (escaped.m_name.empty())
+                escaped.m_name = add_name(name);
+            escaped.m_fields.push_back(add_name(name));
+        }
+
+        return result;
+    }
+} // namespace synthetic
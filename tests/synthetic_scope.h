@@ -0,0 +1,113 @@
+#pragma once
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+#include "sdk/scope_json.h"
+#include "sdk/size_report.h"
+#include "tools/codegen.h"
+#include "tools/fnv.h"
+
+// Synthetic rendered scopes, fragments shaped the way RenderTypeScope renders enums and classes: indented by two
+// blocks, keys through a key cache unless it's null, a trailing comma after every member. Metadata strings carry the characters a
+// scan of the json has to get right inside a string.
+namespace synthetic {
+    constexpr std::size_t kFragmentTabs = 2 * codegen::kTabsPerBlock;
+
+    struct type_t {
+        std::string m_name = "";
+        std::size_t m_members = 0; // items of an enum, fields of a class
+        std::uint32_t m_revision = 0; // changes the definition without changing its name
+    };
+
+    inline std::string render_enum(codegen::key_cache_t* key_cache, const char* name, const std::size_t items, const std::uint32_t revision = 0) {
+        auto builder = codegen::get();
+        builder.use_key_cache(key_cache).inc_tabs_count(kFragmentTabs);
+
+        builder.json_key(name).begin_json_object_value();
+        builder.json_key("align").json_literal(4);
+        builder.json_key("items").begin_json_array_value();
+        for (std::size_t i = 0; i < items; ++i) {
+            builder.begin_json_object();
+            builder.json_key("name").json_string(std::format("k{}Value{}", name, i));
+            builder.json_key("value").json_literal(i + revision);
+            builder.end_json_object();
+        }
+        builder.end_json_array();
+        builder.end_json_object();
+
+        return builder.str();
+    }
+
+    // @note: `sizes` counts the type and metadata of every field like -sizes does
+    //
+    inline std::string render_class(codegen::key_cache_t* key_cache, const char* name, const std::size_t fields, const std::uint32_t revision = 0,
+                                    sdk::size_report_t* sizes = nullptr) {
+        auto builder = codegen::get();
+        builder.use_key_cache(key_cache).inc_tabs_count(kFragmentTabs);
+
+        builder.json_key(name).begin_json_object_value();
+        builder.json_key("size").json_literal(8 + fields * 4);
+        builder.json_key("fields").begin_json_array_value();
+        for (std::size_t i = 0; i < fields; ++i) {
+            builder.begin_json_object();
+            builder.json_key("name").json_string(std::format("m_field{}", i));
+            builder.json_key("offset").json_literal(8 + i * 4 + revision);
+            const auto type_name = i % 3 == 0 ? "CHandle< C_BaseEntity >" : "int32";
+            builder.json_key("type");
+            sdk::MeasureSize(builder, sizes != nullptr ? &sizes->m_field_types[whash64::hash_runtime(type_name)] : nullptr, type_name, [&] {
+                builder.begin_json_object_value();
+                builder.json_key("name").json_string(type_name);
+                builder.end_json_object();
+            });
+            builder.json_key("metadata").begin_json_array_value();
+            sdk::MeasureSize(builder, sizes != nullptr ? &sizes->m_metadata[whash64::hash_runtime("MPropertyDescription")] : nullptr, "MPropertyDescription",
+                             [&] { builder.json_string_element(std::format("MPropertyDescription \"{}\" }}, {{ \\ \"x\": {{", i)); });
+            builder.end_json_array();
+            builder.end_json_object();
+        }
+        builder.end_json_array();
+        builder.end_json_object();
+
+        return builder.str();
+    }
+
+    // @note: the fragments point at the names, which live as long as the scope does, like schema names
+    //
+    struct scope_t {
+        std::vector<std::unique_ptr<std::string>> m_names = {};
+        sdk::rendered_scope_t m_rendered = {};
+    };
+
+    inline scope_t make_scope(std::string name, const std::vector<type_t>& enums, const std::vector<type_t>& classes) {
+        scope_t result;
+        result.m_rendered.m_name = std::move(name);
+
+        codegen::key_cache_t key_cache;
+        const auto add = [&](const type_t& type, const bool is_class) {
+            const auto& type_name = *result.m_names.emplace_back(std::make_unique<std::string>(type.m_name));
+            auto text = is_class ? render_class(&key_cache, type_name.c_str(), type.m_members, type.m_revision) :
+                                   render_enum(&key_cache, type_name.c_str(), type.m_members, type.m_revision);
+            (is_class ? result.m_rendered.m_classes : result.m_rendered.m_enums).push_back({type_name.c_str(), std::move(text)});
+        };
+
+        for (const auto& type : enums)
+            add(type, false);
+        for (const auto& type : classes)
+            add(type, true);
+
+        return result;
+    }
+
+    // @note: `count` types named `<prefix><i>`, with 0 to `max_members` members
+    //
+    inline std::vector<type_t> make_types(const std::string_view prefix, const std::size_t count, const std::size_t max_members) {
+        std::vector<type_t> result(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            result[i].m_name = std::format("{}{}", prefix, i);
+            result[i].m_members = i % (max_members + 1);
+        }
+
+        return result;
+    }
+} // namespace synthetic
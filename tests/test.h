@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+// Checks for the tests in this directory, a failed check prints where it failed and ends the test with 1.
+#define CHECK(expr)                                                                              \
+    do {                                                                                         \
+        if (!(expr)) {                                                                           \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr);        \
+            std::exit(1);                                                                        \
+        }                                                                                        \
+    } while (false)
+
+#define CHECK_THROWS(expr)                                                                       \
+    do {                                                                                         \
+        bool thrown = false;                                                                     \
+        try {                                                                                    \
+            (void)(expr);                                                                        \
+        } catch (...) {                                                                          \
+            thrown = true;                                                                       \
+        }                                                                                        \
+        if (!thrown) {                                                                           \
+            std::fprintf(stderr, "%s:%d: CHECK_THROWS(%s) didn't throw\n", __FILE__, __LINE__, #expr); \
+            std::exit(1);                                                                        \
+        }                                                                                        \
+    } while (false)
+
+namespace test {
+    // @note: a fresh, empty directory for the files of one test
+    //
+    inline std::filesystem::path temp_dir(const std::string& name) {
+        const auto path = std::filesystem::temp_directory_path() / ("source2gen_" + name);
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+        return path;
+    }
+} // namespace test
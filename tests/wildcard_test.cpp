@@ -0,0 +1,84 @@
+#include "test.h"
+#include "tools/wildcard.h"
+#include <functional>
+
+// wildcard::match against a plain recursive matcher for every pattern over {a, b, ?, *} and every string over {a, b}
+// up to 5 characters, then the patterns -scopes, -classes and -roots take and the lists they come in.
+namespace {
+    bool reference_match(const std::string_view pattern, const std::string_view str) {
+        if (pattern.empty())
+            return str.empty();
+        if (pattern[0] == '*')
+            return reference_match(pattern.substr(1), str) || (!str.empty() && reference_match(pattern, str.substr(1)));
+        if (str.empty() || (pattern[0] != '?' && pattern[0] != str[0]))
+            return false;
+
+        return reference_match(pattern.substr(1), str.substr(1));
+    }
+
+    // @note: every string of up to `max_size` characters of `alphabet`
+    //
+    std::vector<std::string> enumerate(const std::string_view alphabet, const std::size_t max_size) {
+        std::vector<std::string> result = {""};
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            if (result[i].size() == max_size)
+                continue;
+
+            for (const auto c : alphabet)
+                result.push_back(result[i] + c);
+        }
+
+        return result;
+    }
+
+    void test_exhaustive() {
+        const auto patterns = enumerate("ab?*", 5);
+        const auto strings = enumerate("ab", 5);
+
+        for (const auto& pattern : patterns) {
+            for (const auto& str : strings)
+                CHECK(wildcard::match(pattern, str) == reference_match(pattern, str));
+        }
+    }
+
+    void test_names() {
+        CHECK(wildcard::match("CCSPlayerPawn", "CCSPlayerPawn"));
+        CHECK(!wildcard::match("CCSPlayerPawn", "CCSPlayerPawnBase"));
+        CHECK(!wildcard::match("CCSPlayerPawn", "ccsplayerpawn"));
+        CHECK(wildcard::match("C*Weapon*", "CWeaponAWP") && wildcard::match("C*Weapon*", "C_CSWeaponBase"));
+        CHECK(!wildcard::match("C*Weapon*", "MWeapon"));
+        CHECK(wildcard::match("C_*Pawn", "C_BasePlayerPawn") && !wildcard::match("C_*Pawn", "C_BasePlayerPawnComponent"));
+        CHECK(wildcard::match("client*", "client.dll") && wildcard::match("*.dll", "!GlobalTypes.dll") && !wildcard::match("client*", "server.dll"));
+        CHECK(wildcard::match("?lient", "client") && !wildcard::match("?client", "client"));
+        CHECK(wildcard::match("*", "") && wildcard::match("**", "") && !wildcard::match("?", ""));
+        CHECK(wildcard::match("m_h*Entity*", "m_hOwnerEntity_m_hEntity"));
+    }
+
+    void test_lists() {
+        using list_t = std::vector<std::string>;
+        CHECK(wildcard::split_list("") == list_t{});
+        CHECK(wildcard::split_list(",,") == list_t{});
+        CHECK(wildcard::split_list("CCSPlayerPawn") == list_t{"CCSPlayerPawn"});
+        CHECK(wildcard::split_list("CCSPlayerPawn,C*Weapon*") == (list_t{"CCSPlayerPawn", "C*Weapon*"}));
+        CHECK(wildcard::split_list(",client,,server,") == (list_t{"client", "server"}));
+
+        const list_t patterns = {"CCSPlayerPawn", "C*Weapon*"};
+        CHECK(wildcard::match_any(patterns, "CCSPlayerPawn") && wildcard::match_any(patterns, "CWeaponAWP"));
+        CHECK(!wildcard::match_any(patterns, "CCSPlayerController") && !wildcard::match_any({}, "CCSPlayerPawn"));
+
+        // @note: keeps the order of what's left
+        //
+        std::vector<const char*> names = {"CWeaponAWP", "CCSPlayerController", "CCSPlayerPawn", "C_BaseEntity", "CWeaponM4A1"};
+        CHECK(wildcard::erase_unmatched(names, patterns, std::identity{}) == 2);
+        CHECK(names.size() == 3 && std::string_view(names[0]) == "CWeaponAWP" && std::string_view(names[1]) == "CCSPlayerPawn" &&
+              std::string_view(names[2]) == "CWeaponM4A1");
+        CHECK(wildcard::erase_unmatched(names, {}, std::identity{}) == 3 && names.empty());
+    }
+} // namespace
+
+int main() {
+    test_exhaustive();
+    test_names();
+    test_lists();
+    return 0;
+}